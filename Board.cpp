@@ -1,63 +1,118 @@
 // board.cpp
 
 #include "Board.h"
+#include "trace.h"
 #include <fstream>
-#include <sstream>
 #include <stdexcept>
 #include <iostream>
+#include <algorithm>
+#include <charconv>
 
 // Static member initialization
 const std::string Board::IO_EXCEPTION = "I/O Exception!";
+size_t Board::distanceTableBudget = DistanceTable::DEFAULT_BUDGET;
+bool Board::distanceTableCache = false;
+
+namespace {
+
+const char WALL = '#';
+const char PELLET = 'o';
+
+// Scatter and chase phases in ticks, starting with scatter; after the
+// last one ghosts chase for good
+const int MODE_SCHEDULE[] = {7, 20, 7, 20, 5, 20, 5};
+const int MODE_PHASES = sizeof(MODE_SCHEDULE) / sizeof(MODE_SCHEDULE[0]);
+
+} // namespace
 
 /**
  * Constructor - creates a new game board of given size
  * Places Pacman in center and ghosts in corners
  */
-Board::Board(int size) : GRID_SIZE(size), score(0), gameOver(false) {
+Board::Board(int size) : Board(size, G_NUM) {}
+
+/**
+ * Constructor - creates a new game board with ghostCount chasers
+ */
+Board::Board(int size, int ghostCount) : Board(size, ghostCount, false) {}
+
+/**
+ * Constructor - creates a new game board with ghostCount ghosts
+ */
+Board::Board(int size, int ghostCount, bool classicGhosts)
+    : GRID_SIZE(size), pacman(size / 2, size / 2), pacmanHeading(Direction::STAY),
+      score(0), gameOver(false), dotsRemaining(size * size - 1), tickCount(0),
+      ghostMode(GhostMode::CHASE), modePhase(0), frightened(false), frightEpoch(0), frightTimer(-1),
+      ghostsEaten(0), randomState(0x9E3779B9u),
+      navigation(nullptr), distances(nullptr), pathfinder(nullptr), distanceTable(nullptr),
+      scriptDistances(nullptr), ghostSearch(nullptr) {
     // Initialize grid and visited arrays
-    grid.resize(GRID_SIZE, std::vector<char>(GRID_SIZE, '*'));
-    visited.resize(GRID_SIZE, std::vector<bool>(GRID_SIZE, false));
+    grid.assign(cellCount(), '*');
+    visited.assign(cellCount(), 0);
 
-    // Create Pacman at center - using polymorphism (Pacman* stored as derived type)
-    int center = GRID_SIZE / 2;
-    pacman = new Pacman(center, center);
-    visited[pacman->getRow()][pacman->getCol()] = true;
+    // Pacman starts at the center (set in the initializer list)
+    visited[cellIndex(pacman.getRow(), pacman.getCol())] = 1;
 
-    // Create 4 ghosts at corners - using polymorphism
-    ghosts.push_back(new Ghost(0, 0));
-    ghosts.push_back(new Ghost(0, GRID_SIZE - 1));
-    ghosts.push_back(new Ghost(GRID_SIZE - 1, GRID_SIZE - 1));
-    ghosts.push_back(new Ghost(GRID_SIZE - 1, 0));
+    // Create the first 4 ghosts at corners
+    const int cornerRows[G_NUM] = {0, 0, GRID_SIZE - 1, GRID_SIZE - 1};
+    const int cornerCols[G_NUM] = {0, GRID_SIZE - 1, GRID_SIZE - 1, 0};
+    ghostCount = std::max(1, ghostCount);
+    chasers.reserve(classicGhosts ? std::max(0, ghostCount - G_NUM) : ghostCount);
+    for (int i = 0; i < ghostCount && i < G_NUM; i++) {
+        if (!classicGhosts) {
+            chasers.emplace_back(cornerRows[i], cornerCols[i]);
+        } else if (i == 0) {
+            // Each personality starts in its own scatter corner
+            GridTarget home = BlinkyPolicy::corner(GRID_SIZE);
+            blinkies.emplace_back(home.row, home.col);
+        } else if (i == 1) {
+            GridTarget home = PinkyPolicy::corner(GRID_SIZE);
+            pinkies.emplace_back(home.row, home.col);
+        } else if (i == 2) {
+            GridTarget home = InkyPolicy::corner(GRID_SIZE);
+            inkies.emplace_back(home.row, home.col);
+        } else {
+            GridTarget home = ClydePolicy::corner(GRID_SIZE);
+            clydes.emplace_back(home.row, home.col);
+        }
+    }
 
-    // Initialize grid with characters
-    for (int i = 0; i < GRID_SIZE; i++) {
-        for (int j = 0; j < GRID_SIZE; j++) {
-            if (i == pacman->getCol() && j == pacman->getRow()) {
-                grid[j][i] = pacman->getAppearance();
-            }
-            else if (i == ghosts[0]->getCol() && j == ghosts[0]->getRow()) {
-                grid[j][i] = ghosts[0]->getAppearance();
-            }
-            else if (i == ghosts[1]->getCol() && j == ghosts[1]->getRow()) {
-                grid[j][i] = ghosts[1]->getAppearance();
-            }
-            else if (i == ghosts[2]->getCol() && j == ghosts[2]->getRow()) {
-                grid[j][i] = ghosts[2]->getAppearance();
-            }
-            else if (i == ghosts[3]->getCol() && j == ghosts[3]->getRow()) {
-                grid[j][i] = ghosts[3]->getAppearance();
-            }
-            else {
-                grid[j][i] = '*';
-            }
+    // Spread the remaining ghosts clockwise along the border
+    int extra = ghostCount - G_NUM;
+    int perimeter = std::max(1, 4 * (GRID_SIZE - 1));
+    int side = std::max(1, GRID_SIZE - 1);
+    for (int k = 0; k < extra; k++) {
+        int p = static_cast<int>((static_cast<long long>(k + 1) * perimeter) / (extra + 1));
+        int offset = p % side;
+        int r, c;
+        switch (p / side) {
+            case 0:  r = 0;                     c = offset;                 break;
+            case 1:  r = offset;                c = GRID_SIZE - 1;          break;
+            case 2:  r = GRID_SIZE - 1;         c = GRID_SIZE - 1 - offset; break;
+            default: r = GRID_SIZE - 1 - offset; c = 0;                     break;
         }
+        chasers.emplace_back(r, c);
+    }
+    linkGhosts();
+
+    // Draw characters - Pacman over ghosts, earlier ghosts over later ones
+    for (int i = static_cast<int>(ghosts.size()) - 1; i >= 0; i--) {
+        grid[cellIndex(ghosts[i]->getRow(), ghosts[i]->getCol())] = ghosts[i]->getAppearance();
     }
+    grid[cellIndex(pacman.getRow(), pacman.getCol())] = pacman.getAppearance();
+    initTracking();
+    initModes();
 }
 
 /**
  * Constructor - loads a game board from a file
  */
-Board::Board(const std::string& fileName) : GRID_SIZE(0), score(0), gameOver(false) {
+Board::Board(const std::string& fileName)
+    : GRID_SIZE(0), pacman(0, 0), pacmanHeading(Direction::STAY), score(0), gameOver(false), dotsRemaining(0), tickCount(0),
+      ghostMode(GhostMode::CHASE), modePhase(0), frightened(false), frightEpoch(0), frightTimer(-1),
+      ghostsEaten(0), randomState(0x9E3779B9u),
+      navigation(nullptr), distances(nullptr), pathfinder(nullptr), distanceTable(nullptr),
+      scriptDistances(nullptr), ghostSearch(nullptr) {
     std::ifstream file(fileName);
     if (!file.is_open()) {
         throw std::runtime_error(IO_EXCEPTION);
@@ -73,8 +128,8 @@ Board::Board(const std::string& fileName) : GRID_SIZE(0), score(0), gameOver(fal
     file.ignore(); // Skip newline
 
     // Initialize arrays
-    grid.resize(GRID_SIZE, std::vector<char>(GRID_SIZE));
-    visited.resize(GRID_SIZE, std::vector<bool>(GRID_SIZE, false));
+    grid.assign(cellCount(), '\0');
+    visited.assign(cellCount(), 0);
 
     // Read grid line by line
     std::string line;
@@ -82,38 +137,73 @@ Board::Board(const std::string& fileName) : GRID_SIZE(0), score(0), gameOver(fal
         std::getline(file, line);
         for (int c = 0; c < GRID_SIZE && c < static_cast<int>(line.length()); c++) {
             char ch = line[c];
-            grid[r][c] = ch;
+            grid[cellIndex(r, c)] = ch;
 
             if (ch == 'P') {
-                pacman = new Pacman(r, c);
-                visited[r][c] = true;
+                pacman.setPosition(r, c);
+                visited[cellIndex(r, c)] = 1;
             }
             else if (ch == 'G') {
-                ghosts.push_back(new Ghost(r, c));
+                chasers.emplace_back(r, c);
+            }
+            else if (ch == BlinkyPolicy::APPEARANCE) {
+                blinkies.emplace_back(r, c);
+            }
+            else if (ch == PinkyPolicy::APPEARANCE) {
+                pinkies.emplace_back(r, c);
+            }
+            else if (ch == InkyPolicy::APPEARANCE) {
+                inkies.emplace_back(r, c);
+            }
+            else if (ch == ClydePolicy::APPEARANCE) {
+                clydes.emplace_back(r, c);
             }
             else if (ch == ' ') {
-                visited[r][c] = true;
+                visited[cellIndex(r, c)] = 1;
+            }
+            else if (ch == PELLET) {
+                if (pellets.empty()) {
+                    pellets.assign(cellCount(), 0);
+                }
+                pellets[cellIndex(r, c)] = 1;
             }
         }
     }
     file.close();
+    linkGhosts();
+
+    for (size_t cell = 0; cell < cellCount(); cell++) {
+        if (!visited[cell] && grid[cell] != WALL) {
+            dotsRemaining++;
+        }
+    }
+    initTracking();
+    initModes();
+
+    // Boards without walls are measured in closed form already
+    if (navigation->getWallCount() > 0 && DistanceTable::fits(GRID_SIZE, distanceTableBudget)) {
+        distanceTable = new DistanceTable(*navigation, GRID_SIZE, distanceTableCache ? fileName + ".apsp" : "");
+    }
 }
 
 /**
  * Destructor - clean up dynamically allocated memory
+ * (characters are stored by value)
  */
 Board::~Board() {
-    delete pacman;
-    for (Ghost* ghost : ghosts) {
-        delete ghost;
-    }
-    ghosts.clear();
+    delete ghostSearch;
+    delete scriptDistances;
+    delete distanceTable;
+    delete pathfinder;
+    delete distances;
+    delete navigation;
 }
 
 /**
  * Save the current board state to a file
  */
 void Board::saveBoard(const std::string& outputFile) {
+    PAC_TRACE_SCOPE("Board::saveBoard");
     std::ofstream file(outputFile);
     if (!file.is_open()) {
         throw std::runtime_error(IO_EXCEPTION);
@@ -122,10 +212,13 @@ void Board::saveBoard(const std::string& outputFile) {
     file << GRID_SIZE << std::endl;
     file << score << std::endl;
     
+    // Frightened ghosts are saved as themselves, so the file loads back
+    std::vector<char> cells(grid);
+    for (size_t i = 0; frightened && i < ghosts.size(); i++) {
+        cells[cellIndex(ghosts[i]->getRow(), ghosts[i]->getCol())] = ghosts[i]->getAppearance();
+    }
     for (int r = 0; r < GRID_SIZE; r++) {
-        for (int c = 0; c < GRID_SIZE; c++) {
-            file << grid[r][c];
-        }
+        file.write(&cells[cellIndex(r, 0)], GRID_SIZE);
         file << std::endl;
     }
     file.close();
@@ -135,110 +228,210 @@ void Board::saveBoard(const std::string& outputFile) {
  * Mark a position as visited and add points
  */
 void Board::setVisited(int x, int y) {
-    visited[x][y] = true;
-    score += 10;
+    int cell = cellIndex(x, y);
+    if (!visited[cell]) {
+        dotsRemaining--;
+    }
+    visited[cell] = 1;
+    if (!pellets.empty() && pellets[cell]) {
+        pellets[cell] = 0;
+        score += PELLET_POINTS;
+        startFright();
+    } else {
+        score += 10;
+    }
+}
+
+/**
+ * Chasers first, then Blinky, Pinky, Inky and Clyde ghosts, as linkGhosts
+ * orders ghosts
+ */
+template <typename Visit>
+void Board::forEachGhost(Visit&& visit) {
+    int index = 0;
+    for (Ghost& ghost : chasers) {
+        visit(ghost, index++);
+    }
+    for (Ghost& ghost : blinkies) {
+        visit(ghost, index++);
+    }
+    for (Ghost& ghost : pinkies) {
+        visit(ghost, index++);
+    }
+    for (Ghost& ghost : inkies) {
+        visit(ghost, index++);
+    }
+    for (Ghost& ghost : clydes) {
+        visit(ghost, index++);
+    }
 }
 
 /**
  * Refresh the grid to show current positions
+ * Only the cells characters were drawn on last time and the cells they
+ * occupy now can change, so only those are rewritten. Cells whose
+ * character actually changed are added to changedCells.
  */
 void Board::refreshGrid() {
-    int p_x = pacman->getCol();
-    int p_y = pacman->getRow();
-    int g0_x = ghosts[0]->getCol(), g0_y = ghosts[0]->getRow();
-    int g1_x = ghosts[1]->getCol(), g1_y = ghosts[1]->getRow();
-    int g2_x = ghosts[2]->getCol(), g2_y = ghosts[2]->getRow();
-    int g3_x = ghosts[3]->getCol(), g3_y = ghosts[3]->getRow();
+    PAC_TRACE_SCOPE("Board::refreshGrid");
+    // Cells that may change: where characters were drawn and where they are now
+    touchedCells.clear();
+    touchedCells.insert(touchedCells.end(), drawnCells.begin(), drawnCells.end());
+    touchedCells.push_back(cellIndex(pacman.getRow(), pacman.getCol()));
+    forEachGhost([this](const Ghost& ghost, int) {
+        touchedCells.push_back(cellIndex(ghost.getRow(), ghost.getCol()));
+    });
+    std::sort(touchedCells.begin(), touchedCells.end());
+    touchedCells.erase(std::unique(touchedCells.begin(), touchedCells.end()), touchedCells.end());
 
-    for (int i = 0; i < GRID_SIZE; i++) {
-        for (int j = 0; j < GRID_SIZE; j++) {
-            if (i == p_x && j == p_y) {
-                grid[j][i] = pacman->getAppearance();
-            }
-            else if (i == g0_x && j == g0_y) {
-                grid[j][i] = ghosts[0]->getAppearance();
-            }
-            else if (i == g1_x && j == g1_y) {
-                grid[j][i] = ghosts[1]->getAppearance();
-            }
-            else if (i == g2_x && j == g2_y) {
-                grid[j][i] = ghosts[2]->getAppearance();
-            }
-            else if (i == g3_x && j == g3_y) {
-                grid[j][i] = ghosts[3]->getAppearance();
-            }
-            else {
-                if (visited[j][i]) {
-                    grid[j][i] = ' ';
-                } else {
-                    grid[j][i] = '*';
-                }
-            }
+    touchedBefore.clear();
+    for (int cell : touchedCells) {
+        touchedBefore.push_back(grid[cell]);
+        grid[cell] = floorChar(cell);
+    }
+
+    // Earlier ghosts win over later ones, so a ghost only draws on a cell
+    // still showing its floor, and Pacman wins over ghosts (same as a full
+    // rescan)
+    forEachGhost([this](const Ghost& ghost, int index) {
+        int cell = cellIndex(ghost.getRow(), ghost.getCol());
+        if (grid[cell] == floorChar(cell)) {
+            grid[cell] = ghostChar(ghost, index);
         }
+    });
+    grid[cellIndex(pacman.getRow(), pacman.getCol())] = pacman.getAppearance();
+    rememberDrawnCells();
+
+    for (size_t i = 0; i < touchedCells.size(); i++) {
+        int cell = touchedCells[i];
+        if (grid[cell] != touchedBefore[i]) {
+            changedCells.push_back(cell);
+        }
+    }
+}
+
+/**
+ * Reserve the per-tick scratch buffers up front
+ * A tick touches at most the old and new cell of every character.
+ */
+void Board::initTracking() {
+    size_t characters = ghosts.size() + 1;
+    drawnCells.reserve(characters);
+    touchedCells.reserve(2 * characters);
+    touchedBefore.reserve(2 * characters);
+    changedCells.reserve(2 * characters);
+    rememberDrawnCells();
+
+    std::vector<char> walls(cellCount(), 0);
+    for (size_t cell = 0; cell < cellCount(); cell++) {
+        walls[cell] = grid[cell] == WALL;
     }
+    navigation = new NavGraph(GRID_SIZE, walls);
+    distances = new DistanceField(*navigation, GRID_SIZE);
+}
+
+/**
+ * Record the cells characters are drawn on, for the next refresh
+ */
+void Board::rememberDrawnCells() {
+    drawnCells.clear();
+    drawnCells.push_back(cellIndex(pacman.getRow(), pacman.getCol()));
+    forEachGhost([this](const Ghost& ghost, int) {
+        drawnCells.push_back(cellIndex(ghost.getRow(), ghost.getCol()));
+    });
 }
 
 /**
  * Check if Pacman can move in the given direction
  */
 bool Board::canMove(Direction direction) {
-    int x = pacman->getCol() + DirectionHelper::getX(direction);
-    int y = pacman->getRow() + DirectionHelper::getY(direction);
-    
-    return (x >= 0 && x < GRID_SIZE) && (y >= 0 && y < GRID_SIZE);
+    return direction == Direction::STAY
+        || navigation->canMove(cellIndex(pacman.getRow(), pacman.getCol()), direction);
 }
 
 /**
  * Move Pacman and update all ghosts
  */
 void Board::move(Direction direction) {
-    int p_x = pacman->getCol();
-    int p_y = pacman->getRow();
+    PAC_TRACE_SCOPE("Board::move");
+    int p_x = pacman.getCol();
+    int p_y = pacman.getRow();
     int x = DirectionHelper::getX(direction);
     int y = DirectionHelper::getY(direction);
 
-    std::cout << "Starting at: " << p_x << "," << p_y << std::endl;
-    std::cout << "Moving in: " << x << "," << y << std::endl;
-    std::cout << "Moving to: " << (p_x + x) << "," << (p_y + y) << std::endl;
+    // Start a new tick
+    tickCount++;
+    changedCells.clear();
+    runTimers();
 
     if (canMove(direction)) {
-        pacman->setPosition(p_y + y, p_x + x);
-        if (!visited[p_y + y][p_x + x]) {
+        pacman.setPosition(p_y + y, p_x + x);
+        if (direction != Direction::STAY) {
+            pacmanHeading = direction;
+        }
+        if (!visited[cellIndex(p_y + y, p_x + x)]) {
             setVisited(p_y + y, p_x + x);
         }
+        if (frightened) {
+            eatGhostsAtPacman();
+        }
     }
 
-    // Move each ghost using POLYMORPHISM
-    // The ghostMove function uses the ghost's decideMove method
-    for (int i = 0; i < G_NUM; i++) {
-        Direction ghostDir = ghostMove(ghosts[i]);
-        int g_x = ghosts[i]->getCol() + DirectionHelper::getX(ghostDir);
-        int g_y = ghosts[i]->getRow() + DirectionHelper::getY(ghostDir);
-        ghosts[i]->setPosition(g_y, g_x);
-        isGameOver();
+    // Move the ghosts group by group. Each array holds one concrete type,
+    // so every call is resolved at compile time, and after the first check
+    // only the ghost that just moved can have caught Pacman.
+    bool caught = isGameOver();
+    if (ghostSearch != nullptr && !caught) {
+        planChasers();
     }
+    int index = 0;
+    for (Ghost& ghost : chasers) {
+        if (!ghostResting(index)) {
+            Direction ghostDir = Direction::STAY;
+            if (!caught) {
+                if (frightened && ghostFrightened(index)) {
+                    ghostDir = wanderMove(ghost);
+                } else if (!runScript(ghost, index, ghostDir)) {
+                    if (ghostSearch != nullptr) {
+                        ghostDir = searchMoves[index];
+                    } else {
+                        Direction preferred = ghost.Ghost::decideMove(pacman.getRow(), pacman.getCol());
+                        ghostDir = chaserMove(&ghost, index, preferred);
+                    }
+                }
+            }
+            stepGhost(ghost, index, ghostDir, caught);
+        }
+        index++;
+    }
+    moveGroup(blinkies, index, caught);
+    moveGroup(pinkies, index, caught);
+    moveGroup(inkies, index, caught);
+    moveGroup(clydes, index, caught);
 
     refreshGrid();
 }
 
 /**
  * Check if game is over (Pacman caught)
+ * Frightened ghosts and ghosts waiting at home do not catch him.
  */
 bool Board::isGameOver() {
-    int p_x = pacman->getRow();
-    int p_y = pacman->getCol();
-    int g0_x = ghosts[0]->getRow(), g0_y = ghosts[0]->getCol();
-    int g1_x = ghosts[1]->getRow(), g1_y = ghosts[1]->getCol();
-    int g2_x = ghosts[2]->getRow(), g2_y = ghosts[2]->getCol();
-    int g3_x = ghosts[3]->getRow(), g3_y = ghosts[3]->getCol();
-
-    if ((p_x == g0_x && p_y == g0_y) || (p_x == g1_x && p_y == g1_y) ||
-        (p_x == g2_x && p_y == g2_y) || (p_x == g3_x && p_y == g3_y)) {
-        pacman->setAppearance('X');
+    int p_x = pacman.getRow();
+    int p_y = pacman.getCol();
+
+    bool caught = false;
+    forEachGhost([&](const Ghost& ghost, int index) {
+        if (p_x == ghost.getRow() && p_y == ghost.getCol() &&
+            (waiting.empty() || (!waiting[index] && !ghostFrightened(index)))) {
+            caught = true;
+        }
+    });
+    if (caught) {
+        pacman.setAppearance('X');
         gameOver = true;
-        return true;
     }
-    return false;
+    return caught;
 }
 
 /**
@@ -247,40 +440,448 @@ bool Board::isGameOver() {
  */
 Direction Board::ghostMove(PacCharacter* ghost) {
     if (isGameOver()) {
-        pacman->setAppearance('X');
+        pacman.setAppearance('X');
         return Direction::STAY;
     }
-
+    int index = -1;
+    if (pathfinder != nullptr) {
+        index = static_cast<int>(std::find(ghosts.begin(), ghosts.end(), ghost) - ghosts.begin());
+    }
     // Use polymorphism - call the ghost's decideMove method
-    Direction result = ghost->decideMove(pacman->getRow(), pacman->getCol());
-    
-    refreshGrid();
-    return result;
+    // (the grid is refreshed once per tick, at the end of move)
+    return chaserMove(ghost, index, ghost->decideMove(pacman.getRow(), pacman.getCol()));
+}
+
+/**
+ * Ghosts of other boards (index out of range) always use the distance field
+ */
+Direction Board::chaserMove(const PacCharacter* ghost, int index, Direction preferred) {
+    PAC_TRACE_SCOPE("Board::ghostMove");
+    if (pathfinder != nullptr && index >= 0 && index < static_cast<int>(ghosts.size())) {
+        return pathfinder->nextMove(index, cellIndex(ghost->getRow(), ghost->getCol()),
+                                    cellIndex(pacman.getRow(), pacman.getCol()));
+    }
+    return chaseMove(ghost, preferred);
+}
+
+/**
+ * The group's element type is PersonalityGhost<Policy> itself, so steer()
+ * is an ordinary, inlinable call
+ */
+template <typename Policy>
+void Board::moveGroup(std::vector<PersonalityGhost<Policy>>& group, int& index, bool& caught) {
+    if (group.empty()) {
+        return;
+    }
+    PAC_TRACE_SCOPE("Board::moveGroup");
+    GhostTargetContext context = targetContext();
+    for (PersonalityGhost<Policy>& ghost : group) {
+        if (!ghostResting(index)) {
+            Direction ghostDir = Direction::STAY;
+            if (!caught) {
+                if (frightened && ghostFrightened(index)) {
+                    ghostDir = wanderMove(ghost);
+                } else if (!runScript(ghost, index, ghostDir)) {
+                    ghostDir = ghost.steer(context, *navigation);
+                }
+            }
+            stepGhost(ghost, index, ghostDir, caught);
+        }
+        index++;
+    }
+}
+
+void Board::stepGhost(Ghost& ghost, int index, Direction direction, bool& caught) {
+    int row = ghost.getRow() + DirectionHelper::getY(direction);
+    int col = ghost.getCol() + DirectionHelper::getX(direction);
+    ghost.setPosition(row, col);
+    if (row == pacman.getRow() && col == pacman.getCol()) {
+        if (frightened && ghostFrightened(index)) {
+            eatGhost(ghost, index);
+            return;
+        }
+        pacman.setAppearance('X');
+        gameOver = true;
+        caught = true;
+    }
+}
+
+/**
+ * Waiting ghosts sit out every tick; frightened ones every other tick
+ */
+bool Board::ghostResting(int index) const {
+    if (waiting.empty()) {
+        return false;
+    }
+    return waiting[index] || (ghostFrightened(index) && (tickCount & 1));
+}
+
+/**
+ * A uniform pick among the open moves (xorshift32), never STAY unless
+ * the ghost is walled in
+ */
+Direction Board::wanderMove(const Ghost& ghost) {
+    uint8_t mask = navigation->getMask(cellIndex(ghost.getRow(), ghost.getCol()));
+    int open = __builtin_popcount(mask);
+    if (open == 0) {
+        return Direction::STAY;
+    }
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    int pick = static_cast<int>(randomState % static_cast<uint32_t>(open));
+
+    // Mask bits in Direction order: up, down, left, right
+    const Direction order[] = {Direction::UP, Direction::DOWN, Direction::LEFT, Direction::RIGHT};
+    for (int bit = 0; bit < 4; bit++) {
+        if ((mask & (1 << bit)) && pick-- == 0) {
+            return order[bit];
+        }
+    }
+    return Direction::STAY;
+}
+
+char Board::ghostChar(const Ghost& ghost, int index) const {
+    return frightened && ghostFrightened(index) ? FRIGHTENED_APPEARANCE : ghost.getAppearance();
+}
+
+char Board::floorChar(size_t cell) const {
+    if (visited[cell]) {
+        return ' ';
+    }
+    return !pellets.empty() && pellets[cell] ? PELLET : '*';
+}
+
+/**
+ * Boards without power pellets or personality ghosts schedule nothing,
+ * so their timer wheel never allocates and every tick skips it
+ */
+void Board::initModes() {
+    if (!pellets.empty()) {
+        eatenEpoch.assign(ghosts.size(), 0);
+        waiting.assign(ghosts.size(), 0);
+        homes.resize(ghosts.size());
+        for (size_t i = 0; i < ghosts.size(); i++) {
+            homes[i] = cellIndex(ghosts[i]->getRow(), ghosts[i]->getCol());
+        }
+        // Every ghost's respawn, the fright end and the mode switch
+        timers.reserve(ghosts.size() + 2);
+    }
+    if (ghosts.size() > chasers.size()) {
+        ghostMode = GhostMode::SCATTER;
+        timers.schedule(MODE_SCHEDULE[0], MODE_EVENT);
+        modePhase = 1;
+    }
+}
+
+void Board::runTimers() {
+    for (uint32_t event : timers.advance()) {
+        uint32_t kind = event & 0xFF000000u;
+        int index = static_cast<int>(event & 0x00FFFFFFu);
+        if (kind == MODE_EVENT) {
+            ghostMode = ghostMode == GhostMode::SCATTER ? GhostMode::CHASE : GhostMode::SCATTER;
+            if (modePhase < MODE_PHASES) {
+                timers.schedule(MODE_SCHEDULE[modePhase++], MODE_EVENT);
+            }
+        } else if (kind == FRIGHT_EVENT) {
+            frightened = false;
+            frightTimer = -1;
+        } else if (kind == RESPAWN_EVENT) {
+            waiting[index] = 0;
+        } else if (kind == SCRIPT_EVENT) {
+            scripts[index].sleeping = false;
+            scripts[index].timer = -1;
+        }
+    }
+}
+
+/**
+ * A new pellet restarts the fright: bumping the epoch frightens again the
+ * ghosts eaten during the last one
+ */
+void Board::startFright() {
+    frightEpoch++;
+    frightened = true;
+    ghostsEaten = 0;
+    timers.cancel(frightTimer);
+    frightTimer = timers.schedule(FRIGHTENED_TICKS, FRIGHT_EVENT);
+}
+
+void Board::eatGhost(Ghost& ghost, int index) {
+    score += GHOST_POINTS << std::min(ghostsEaten, 3);
+    ghostsEaten++;
+    ghost.setPosition(homes[index] / GRID_SIZE, homes[index] % GRID_SIZE);
+    eatenEpoch[index] = frightEpoch;
+    waiting[index] = 1;
+    timers.schedule(RESPAWN_TICKS, RESPAWN_EVENT | static_cast<uint32_t>(index));
+}
+
+void Board::eatGhostsAtPacman() {
+    forEachGhost([this](Ghost& ghost, int index) {
+        if (ghost.getRow() == pacman.getRow() && ghost.getCol() == pacman.getCol() &&
+            ghostFrightened(index)) {
+            eatGhost(ghost, index);
+        }
+    });
+}
+
+GhostTargetContext Board::targetContext() const {
+    const PacCharacter& blinky = blinkies.empty() ? static_cast<const PacCharacter&>(pacman) : blinkies.front();
+    GhostTargetContext context;
+    context.pacmanRow = pacman.getRow();
+    context.pacmanCol = pacman.getCol();
+    context.pacmanHeading = pacmanHeading;
+    context.blinkyRow = blinky.getRow();
+    context.blinkyCol = blinky.getCol();
+    context.size = GRID_SIZE;
+    context.scatter = ghostMode == GhostMode::SCATTER;
+    return context;
+}
+
+/**
+ * Every ghost's cell goes in (the search models the nearest few), but only
+ * chasers that would chase this tick are searched for
+ */
+void Board::planChasers() {
+    searchCells.clear();
+    forEachGhost([this](const Ghost& ghost, int) {
+        searchCells.push_back(cellIndex(ghost.getRow(), ghost.getCol()));
+    });
+    searchGhosts.clear();
+    for (int i = 0; i < static_cast<int>(chasers.size()); i++) {
+        if (!ghostResting(i) && !(frightened && ghostFrightened(i)) && !hasGhostScript(i)) {
+            searchGhosts.push_back(i);
+        }
+    }
+    const std::vector<Direction>& planned = ghostSearch->plan(cellIndex(pacman.getRow(), pacman.getCol()),
+                                                              searchCells, visited, searchGhosts);
+    searchMoves.resize(chasers.size(), Direction::STAY);
+    for (size_t i = 0; i < searchGhosts.size(); i++) {
+        searchMoves[searchGhosts[i]] = planned[i];
+    }
+}
+
+/**
+ * Slots are made for every ghost at once, so their ScriptSelf objects
+ * keep their addresses for the board's lifetime. The timer wheel's room
+ * for every ghost's wait and the scripts' distance field are made then
+ * too, so scripted ticks start off the heap.
+ */
+ScriptSelf& Board::prepareScript(int index) {
+    if (index < 0 || index >= static_cast<int>(ghosts.size())) {
+        throw std::runtime_error("No ghost " + std::to_string(index) + " to script");
+    }
+    if (scripts.empty()) {
+        scripts.resize(ghosts.size());
+        for (size_t i = 0; i < scripts.size(); i++) {
+            scripts[i].self.board = this;
+            scripts[i].self.index = static_cast<int>(i);
+            scripts[i].self.arena = &scriptArena;
+            scripts[i].sleeping = false;
+            scripts[i].timer = -1;
+        }
+        // Every ghost's wait and respawn, the fright end and the mode switch
+        timers.reserve(2 * ghosts.size() + 2);
+        if (distanceTable == nullptr && scriptDistances == nullptr) {
+            scriptDistances = new DistanceField(*navigation, GRID_SIZE);
+        }
+    }
+    clearGhostScript(index);
+    return scripts[index].self;
+}
+
+void Board::startScript(int index, GhostScript script) {
+    ScriptSlot& slot = scripts[index];
+    slot.script = std::move(script);
+    slot.self.current = slot.script.handle;
+    slot.self.lastMoved = false;
+}
+
+void Board::clearGhostScript(int index) {
+    if (scripts.empty() || index < 0 || index >= static_cast<int>(scripts.size())) {
+        return;
+    }
+    ScriptSlot& slot = scripts[index];
+    timers.cancel(slot.timer);
+    slot.timer = -1;
+    slot.sleeping = false;
+    slot.script = GhostScript();
+}
+
+bool Board::hasGhostScript(int index) const {
+    return !scripts.empty() && index >= 0 && index < static_cast<int>(scripts.size()) &&
+           !scripts[index].script.done();
+}
+
+const ScriptArena& Board::getScriptArena() const {
+    return scriptArena;
+}
+
+/**
+ * The first resume starts the script (scripts start suspended); later ones
+ * continue its innermost behaviour from the action it last awaited.
+ * Sleeping scripts cost one flag check a tick.
+ */
+bool Board::stepScript(Ghost& ghost, int index, Direction& direction) {
+    ScriptSlot& slot = scripts[index];
+    if (slot.script.done()) {
+        return false;
+    }
+    if (slot.sleeping) {
+        direction = Direction::STAY;
+        return true;
+    }
+    PAC_TRACE_SCOPE("Board::stepScript");
+    slot.self.current.resume();
+    if (slot.script.done()) {
+        GhostScript finished = std::move(slot.script);
+        finished.rethrowError();
+        return false;
+    }
+    direction = scriptMove(ghost, index, slot);
+    slot.self.lastMoved = direction != Direction::STAY;
+    return true;
+}
+
+Direction Board::scriptMove(Ghost& ghost, int index, ScriptSlot& slot) {
+    const ScriptAction& action = slot.self.action;
+    int cell = cellIndex(ghost.getRow(), ghost.getCol());
+    switch (action.kind) {
+        case ScriptAction::STEP:
+            return action.direction != Direction::STAY && navigation->canMove(cell, action.direction)
+                 ? action.direction : Direction::STAY;
+        case ScriptAction::TOWARD: {
+            const GridTarget& target = action.target;
+            if (target.row < 0 || target.row >= GRID_SIZE || target.col < 0 || target.col >= GRID_SIZE) {
+                return Direction::STAY;
+            }
+            int goal = cellIndex(target.row, target.col);
+            uint32_t best = scriptDistance(cell, goal);
+            Direction choice = Direction::STAY;
+            const Direction order[] = {Direction::UP, Direction::DOWN, Direction::LEFT, Direction::RIGHT};
+            for (Direction direction : order) {
+                if (best == DistanceField::UNREACHABLE || best == 0) {
+                    break;
+                }
+                if (!navigation->canMove(cell, direction)) {
+                    continue;
+                }
+                int next = cellIndex(ghost.getRow() + DirectionHelper::getY(direction),
+                                     ghost.getCol() + DirectionHelper::getX(direction));
+                uint32_t distance = scriptDistance(next, goal);
+                if (distance < best) {
+                    best = distance;
+                    choice = direction;
+                }
+            }
+            return choice;
+        }
+        case ScriptAction::CHASE:
+            return chaserMove(&ghost, index, ghost.Ghost::decideMove(pacman.getRow(), pacman.getCol()));
+        case ScriptAction::WAIT:
+            // This tick is the first of the wait; the wheel wakes the
+            // script on the tick after the last
+            if (action.ticks > 1) {
+                slot.sleeping = true;
+                slot.timer = timers.schedule(static_cast<uint32_t>(action.ticks), SCRIPT_EVENT | static_cast<uint32_t>(index));
+            }
+            return Direction::STAY;
+    }
+    return Direction::STAY;
+}
+
+/**
+ * The board's table when it has one; otherwise a field searched from the
+ * target, kept while scripts head for the same cell
+ */
+uint32_t Board::scriptDistance(int from, int to) {
+    if (distanceTable != nullptr) {
+        uint16_t distance = distanceTable->distance(from, to);
+        return distance == DistanceTable::UNREACHABLE ? DistanceField::UNREACHABLE : distance;
+    }
+    if (scriptDistances == nullptr) {
+        scriptDistances = new DistanceField(*navigation, GRID_SIZE);
+    }
+    scriptDistances->setSource(to);
+    return scriptDistances->distanceTo(from);
+}
+
+/**
+ * Chasers first, then Blinky, Pinky, Inky and Clyde ghosts - the order
+ * move() runs them in
+ */
+void Board::linkGhosts() {
+    ghosts.clear();
+    ghosts.reserve(chasers.size() + blinkies.size() + pinkies.size() + inkies.size() + clydes.size());
+    for (Ghost& ghost : chasers) {
+        ghosts.push_back(&ghost);
+    }
+    for (Ghost& ghost : blinkies) {
+        ghosts.push_back(&ghost);
+    }
+    for (Ghost& ghost : pinkies) {
+        ghosts.push_back(&ghost);
+    }
+    for (Ghost& ghost : inkies) {
+        ghosts.push_back(&ghost);
+    }
+    for (Ghost& ghost : clydes) {
+        ghosts.push_back(&ghost);
+    }
+}
+
+/**
+ * Follow the distances to Pacman: the distance field, which every ghost
+ * of the tick shares and which is only searched again after Pacman
+ * changes cell, or the board's table when it has one
+ */
+Direction Board::chaseMove(const PacCharacter* ghost, Direction preferred) {
+    return navigation->chaseMove(cellIndex(ghost->getRow(), ghost->getCol()), preferred,
+                                 [this](int cell) { return distanceToPacman(cell); });
+}
+
+/**
+ * A table lookup when the board has one, otherwise the shared field
+ */
+uint32_t Board::distanceToPacman(int cell) {
+    int target = cellIndex(pacman.getRow(), pacman.getCol());
+    if (distanceTable != nullptr) {
+        uint16_t distance = distanceTable->distance(cell, target);
+        return distance == DistanceTable::UNREACHABLE ? DistanceField::UNREACHABLE : distance;
+    }
+    distances->setSource(target);
+    return distances->distanceTo(cell);
 }
 
 /**
  * Convert board to string for display
  */
 std::string Board::toString() const {
-    std::ostringstream oss;
-    oss << "Score: " << score << std::endl;
-    oss << toStringHelper();
-    return oss.str();
+    std::string str;
+    writeString(str);
+    return str;
 }
 
 /**
- * Helper function - converts grid to string
+ * Write the score line and the grid into out
  */
-std::string Board::toStringHelper() const {
-    std::string str = "";
+void Board::writeString(std::string& out) const {
+    char digits[16];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), score);
+
+    out.clear();
+    out.reserve(32 + static_cast<size_t>(GRID_SIZE) * (3 * GRID_SIZE + 1));
+    out += "Score: ";
+    out.append(digits, result.ptr);
+    out += '\n';
+    const char* cell = grid.data();
     for (int i = 0; i < GRID_SIZE; i++) {
         for (int j = 0; j < GRID_SIZE; j++) {
-            str += "  ";
-            str += grid[i][j];
+            out += "  ";
+            out += *cell++;
         }
-        str += "\n";
+        out += '\n';
     }
-    return str;
 }
 
 // Getters
@@ -292,23 +893,166 @@ bool Board::getIsGameOver() const {
     return gameOver;
 }
 
+int Board::getDotsRemaining() const {
+    return dotsRemaining;
+}
+
 int Board::getGridSize() const{
     return GRID_SIZE;
 }
 
 char Board::getGridChar(int row, int col) const {
     if (row >= 0 && row < GRID_SIZE && col >= 0 && col < GRID_SIZE) {
-        return grid[row][col];
+        return grid[cellIndex(row, col)];
     }
     return ' ';
 }
 
 void Board::setGridChar(int row, int col, char ch) {
     if (row >= 0 && row < GRID_SIZE && col >= 0 && col < GRID_SIZE) {
-        grid[row][col] = ch;
+        grid[cellIndex(row, col)] = ch;
     }
 }
 
-const std::vector<std::vector<char>>& Board::getGrid() const {
+const std::vector<char>& Board::getGrid() const {
     return grid;
-}
\ No newline at end of file
+}
+
+const std::vector<char>& Board::getVisited() const {
+    return visited;
+}
+
+const std::vector<Ghost*>& Board::getGhosts() const {
+    return ghosts;
+}
+
+const Pacman* Board::getPacman() const {
+    return &pacman;
+}
+
+const NavGraph& Board::getNavGraph() const {
+    return *navigation;
+}
+
+void Board::setGhostNav(GhostNav nav) {
+    if (nav == GhostNav::ASTAR && pathfinder == nullptr) {
+        pathfinder = new Pathfinder(*navigation, GRID_SIZE, static_cast<int>(ghosts.size()));
+    } else if (nav == GhostNav::DISTANCE_FIELD) {
+        delete pathfinder;
+        pathfinder = nullptr;
+    }
+}
+
+GhostNav Board::getGhostNav() const {
+    return pathfinder != nullptr ? GhostNav::ASTAR : GhostNav::DISTANCE_FIELD;
+}
+
+const Pathfinder* Board::getPathfinder() const {
+    return pathfinder;
+}
+
+const DistanceTable* Board::getDistanceTable() const {
+    return distanceTable;
+}
+
+void Board::setDistanceTableBudget(size_t bytes) {
+    distanceTableBudget = bytes;
+}
+
+void Board::setDistanceTableCache(bool enabled) {
+    distanceTableCache = enabled;
+}
+
+const std::vector<int>& Board::getChangedCells() const {
+    return changedCells;
+}
+
+void Board::setGhostDifficulty(GhostDifficulty difficulty, const GhostSearchOptions& options) {
+    delete ghostSearch;
+    ghostSearch = nullptr;
+    if (difficulty == GhostDifficulty::HARD) {
+        ghostSearch = new GhostSearch(*navigation, distanceTable, GRID_SIZE, options);
+        ghostSearch->reserve(ghosts.size());
+        searchCells.reserve(ghosts.size());
+        searchGhosts.reserve(chasers.size());
+        searchMoves.reserve(chasers.size());
+    }
+}
+
+GhostDifficulty Board::getGhostDifficulty() const {
+    return ghostSearch != nullptr ? GhostDifficulty::HARD : GhostDifficulty::NORMAL;
+}
+
+const GhostSearch* Board::getGhostSearch() const {
+    return ghostSearch;
+}
+
+GhostMode Board::getGhostMode() const {
+    return ghostMode;
+}
+
+bool Board::isFrightened() const {
+    return frightened;
+}
+
+bool Board::isGhostFrightened(int index) const {
+    return frightened && index >= 0 && index < static_cast<int>(ghosts.size()) && ghostFrightened(index);
+}
+
+int Board::getTickCount() const {
+    return tickCount;
+}
+/**
+ * Add up the capacity of every container the board owns
+ */
+BoardMemory Board::memoryUsage() const {
+    BoardMemory memory;
+    memory.object = sizeof(Board);
+    memory.grid = grid.capacity() * sizeof(char);
+    memory.visited = visited.capacity() * sizeof(char);
+    size_t personalities = blinkies.capacity() + pinkies.capacity() + inkies.capacity() + clydes.capacity();
+    memory.characters = chasers.capacity() * sizeof(Ghost) + personalities * sizeof(Blinky)
+                      + ghosts.capacity() * sizeof(Ghost*)
+                      + scripts.capacity() * sizeof(ScriptSlot) + scriptArena.memoryUsage();
+    memory.tracking = drawnCells.capacity() * sizeof(int) + changedCells.capacity() * sizeof(int)
+                    + touchedCells.capacity() * sizeof(int) + touchedBefore.capacity() * sizeof(char)
+                    + timers.memoryUsage() + pellets.capacity() * sizeof(char)
+                    + eatenEpoch.capacity() * sizeof(uint32_t) + waiting.capacity() * sizeof(char)
+                    + homes.capacity() * sizeof(int);
+    memory.navigation = sizeof(NavGraph) + navigation->memoryUsage()
+                      + sizeof(DistanceField) + distances->memoryUsage();
+    if (pathfinder != nullptr) {
+        memory.navigation += sizeof(Pathfinder) + pathfinder->memoryUsage();
+    }
+    if (distanceTable != nullptr) {
+        memory.navigation += sizeof(DistanceTable) + distanceTable->memoryUsage();
+    }
+    if (scriptDistances != nullptr) {
+        memory.navigation += sizeof(DistanceField) + scriptDistances->memoryUsage();
+    }
+    if (ghostSearch != nullptr) {
+        memory.navigation += sizeof(GhostSearch) + ghostSearch->memoryUsage()
+                           + (searchCells.capacity() + searchGhosts.capacity()) * sizeof(int)
+                           + searchMoves.capacity() * sizeof(Direction);
+    }
+    return memory;
+}
+
+/**
+ * Same sums as memoryUsage, from the sizes the constructor allocates
+ */
+BoardMemory Board::estimateMemory(int size, int ghostCount) {
+    size_t cells = static_cast<size_t>(size) * size;
+    size_t ghostNum = static_cast<size_t>(std::max(1, ghostCount));
+    size_t characters = ghostNum + 1;
+
+    BoardMemory memory;
+    memory.object = sizeof(Board);
+    memory.grid = cells * sizeof(char);
+    memory.visited = cells * sizeof(char);
+    memory.characters = ghostNum * (sizeof(Ghost) + sizeof(Ghost*));
+    memory.tracking = characters * sizeof(int) + 2 * characters * (2 * sizeof(int) + sizeof(char));
+    // New boards have no walls: masks only, and nothing for the field to search
+    memory.navigation = sizeof(NavGraph) + NavGraph::estimateMemory(size) + sizeof(DistanceField);
+    return memory;
+}
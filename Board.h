@@ -6,8 +6,55 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <utility>
 #include "ipac_character.h"
 #include "Direction.h"
+#include "nav_graph.h"
+#include "distance_field.h"
+#include "pathfinder.h"
+#include "distance_table.h"
+#include "ghost_personality.h"
+#include "timer_wheel.h"
+#include "ghost_script.h"
+#include "ghost_search.h"
+
+/**
+ * BoardMemory - bytes owned by a Board, by part
+ */
+struct BoardMemory {
+    size_t object;       // The Board itself, Pacman included
+    size_t grid;         // Cell characters
+    size_t visited;      // Visited flags
+    size_t characters;   // Ghost arrays, the ghost pointer list and ghost scripts
+    size_t tracking;     // Per-tick change tracking buffers, timers and ghost modes
+    size_t navigation;   // Navigation graph, distance field/table ghosts chase along
+
+    size_t total() const { return object + grid + visited + characters + tracking + navigation; }
+};
+
+/**
+ * How ghosts find their way to Pacman
+ */
+enum class GhostNav {
+    DISTANCE_FIELD,   // One breadth-first field from Pacman shared by all ghosts
+    ASTAR             // A* path per ghost, cached and repaired (see Pathfinder)
+};
+
+/**
+ * How chasers ('G') choose their moves
+ */
+enum class GhostDifficulty {
+    NORMAL,   // Step along the distances to Pacman (see GhostNav)
+    HARD      // Look ahead with a GhostSearch
+};
+
+/**
+ * What personality ghosts aim for outside frightened mode
+ */
+enum class GhostMode {
+    SCATTER,   // Their own corner
+    CHASE      // Their targeting rule (see ghost_personality.h)
+};
 
 /**
  * Board class - manages the Pac-Man game board
@@ -24,8 +71,32 @@ public:
      */
     Board(int size);
 
+    /**
+     * Constructor - creates a new game board with any number of ghosts
+     * The first four ghosts start in the corners, the rest are spread
+     * evenly along the border.
+     * @param size The size of the square board
+     * @param ghostCount Number of ghosts (at least 1)
+     */
+    Board(int size, int ghostCount);
+
+    /**
+     * Constructor - as Board(size, ghostCount), optionally with the classic
+     * ghosts: Blinky, Pinky, Inky and Clyde each start in their scatter
+     * corner (see ghost_personality.h) and any further ghosts are chasers
+     * @param size The size of the square board
+     * @param ghostCount Number of ghosts (at least 1)
+     * @param classicGhosts Use the four personalities in the corners
+     */
+    Board(int size, int ghostCount, bool classicGhosts);
+
     /**
      * Constructor - loads a game board from a file
+     * Cells are '*' (dot), 'o' (power pellet), ' ' (eaten), 'P', '#' (wall)
+     * and ghosts: 'G' (chaser), 'A' (Blinky), 'D' (Pinky), 'C' (Inky) or
+     * 'B' (Clyde).
+     * A board with walls whose DistanceTable fits the budget (see
+     * setDistanceTableBudget) gets one at load time.
      * @param fileName The file to load from
      */
     Board(const std::string& fileName);
@@ -35,6 +106,10 @@ public:
      */
     ~Board();
 
+    // Owns its navigation, pathfinding, distance and search objects
+    Board(const Board&) = delete;
+    Board& operator=(const Board&) = delete;
+
     /**
      * Save the current board state to a file
      * @param outputFile The file to save to
@@ -50,11 +125,13 @@ public:
 
     /**
      * Refresh the grid to reflect current character positions
+     * Only cells characters left or entered are rewritten.
      */
     void refreshGrid();
 
     /**
      * Check if Pacman can move in the given direction
+     * Moves off the board or into a wall are invalid; STAY always is valid.
      * @param direction The direction to check
      * @return true if move is valid, false otherwise
      */
@@ -74,6 +151,12 @@ public:
 
     /**
      * Get the direction a ghost should move
+     * The ghost steps to the neighbour closest to Pacman by path length
+     * (never into a wall), keeping its own decideMove choice when that is
+     * one of the closest. A ghost walled off from Pacman stays. With
+     * GhostNav::ASTAR the ghost follows its cached path instead.
+     * Personality ghosts are steered by move() itself (see
+     * PersonalityGhost); for them this gives the chaser's move.
      * @param ghost Pointer to the ghost character
      * @return The direction for the ghost to move
      */
@@ -85,9 +168,22 @@ public:
      */
     std::string toString() const;
 
+    /**
+     * Write the same text as toString into a caller-owned buffer
+     * Reusing the buffer avoids heap allocation once it has grown.
+     * @param out Buffer to overwrite
+     */
+    void writeString(std::string& out) const;
+
     // Getters
     int getScore() const;
     bool getIsGameOver() const;
+
+    /**
+     * Get the number of cells Pacman has not visited yet
+     * @return Dots left to eat (0 means the board is cleared)
+     */
+    int getDotsRemaining() const;
     
     /**
      * Get the grid size
@@ -113,28 +209,421 @@ public:
     
     /**
      * Get the entire grid (for GUI rendering)
-     * @return Reference to the grid
+     * @return Reference to the grid, row by row (index row * size + col)
+     */
+    const std::vector<char>& getGrid() const;
+
+    /**
+     * Get the visited flags
+     * @return Reference to the flags (0/1), same layout as getGrid
+     */
+    const std::vector<char>& getVisited() const;
+
+    /**
+     * Get the ghosts on the board
+     * Grouped by kind, in the order they move: chasers, then Blinky,
+     * Pinky, Inky and Clyde ghosts. The ghosts are owned by the board.
+     * @return Reference to the ghost pointers
+     */
+    const std::vector<Ghost*>& getGhosts() const;
+
+    /**
+     * Get Pacman
+     * @return Pointer to Pacman (owned by the board)
+     */
+    const Pacman* getPacman() const;
+
+    /**
+     * Get the cells whose character changed during the last move()
+     * Cells are row * size + col; changes made with setGridChar are not tracked.
+     * @return Reference to the changed cell indices
+     */
+    const std::vector<int>& getChangedCells() const;
+
+    /**
+     * Get the navigation graph (open moves per cell and junctions)
+     * @return Reference to the graph, built when the board was created/loaded
      */
-    const std::vector<std::vector<char>>& getGrid() const;
+    const NavGraph& getNavGraph() const;
+
+    /**
+     * Choose how ghosts find Pacman (GhostNav::DISTANCE_FIELD by default)
+     * ASTAR builds the pathfinder's search arrays on first use.
+     */
+    void setGhostNav(GhostNav nav);
+    GhostNav getGhostNav() const;
+
+    /**
+     * Get the pathfinder (nullptr unless ghosts use GhostNav::ASTAR)
+     */
+    const Pathfinder* getPathfinder() const;
+
+    /**
+     * Get the all-pairs distance table
+     * With a table, GhostNav::DISTANCE_FIELD ghosts look their distances
+     * up in it instead of searching.
+     * @return The table, or nullptr if the board has none
+     */
+    const DistanceTable* getDistanceTable() const;
+
+    /**
+     * Set the memory a loaded board's distance table may use
+     * Boards whose table would be larger load without one; 0 turns tables
+     * off. Applies to boards loaded afterwards (default
+     * DistanceTable::DEFAULT_BUDGET).
+     */
+    static void setDistanceTableBudget(size_t bytes);
+
+    /**
+     * Cache distance tables next to their board files (fileName + ".apsp")
+     * Off by default; applies to boards loaded afterwards.
+     */
+    static void setDistanceTableCache(bool enabled);
+
+    /**
+     * Choose how chasers move
+     * HARD searches ahead every tick (see GhostSearch) within the options'
+     * time budget; frightened, resting and scripted chasers are left out
+     * of the search. Personality ghosts keep their own rules.
+     * @param options Search limits (HARD only)
+     */
+    void setGhostDifficulty(GhostDifficulty difficulty, const GhostSearchOptions& options = GhostSearchOptions());
+
+    GhostDifficulty getGhostDifficulty() const;
+
+    /**
+     * Get the chasers' search (null unless HARD)
+     */
+    const GhostSearch* getGhostSearch() const;
+
+    /**
+     * Get the mode personality ghosts are in
+     * Boards with personality ghosts start in SCATTER and switch on a
+     * fixed schedule, ending in CHASE. Chasers ('G') always chase.
+     */
+    GhostMode getGhostMode() const;
+
+    /**
+     * Check if a power pellet's fright is running
+     * Frightened ghosts show as 'V', wander at half speed and are eaten
+     * (sent home for a while) instead of catching Pacman.
+     */
+    bool isFrightened() const;
+
+    /**
+     * Check if one ghost is frightened (a ghost eaten during the fright
+     * comes back unfrightened)
+     * @param index Index in getGhosts()
+     */
+    bool isGhostFrightened(int index) const;
+
+    /**
+     * Drive a ghost by a script instead of its own rule, until the script
+     * returns (replacing any script it already runs)
+     * The script is resumed once per tick while the ghost is free to move:
+     * frightened ghosts wander and ghosts waiting at home stay, with the
+     * script paused. Exceptions a script throws leave move() once the
+     * script is dropped.
+     * @param index Index in getGhosts()
+     * @param behaviour A coroutine taking the ghost's ScriptSelf& first
+     *        (see ghost_script.h), e.g. GhostScripts::patrol
+     * @param args The behaviour's other arguments
+     */
+    template <typename Behaviour, typename... Args>
+    void setGhostScript(int index, Behaviour&& behaviour, Args&&... args) {
+        ScriptSelf& self = prepareScript(index);
+        startScript(index, behaviour(self, std::forward<Args>(args)...));
+    }
+
+    /**
+     * Stop a ghost's script; the ghost goes back to its own rule
+     * @param index Index in getGhosts()
+     */
+    void clearGhostScript(int index);
+
+    /**
+     * Check if a ghost runs a script
+     * @param index Index in getGhosts()
+     */
+    bool hasGhostScript(int index) const;
+
+    /**
+     * Get the arena the board's script frames live in
+     */
+    const ScriptArena& getScriptArena() const;
+
+    /**
+     * Get the number of moves made on this board since it was created/loaded
+     * @return The tick count
+     */
+    int getTickCount() const;
+
+    /**
+     * Get the heap and object bytes this board owns
+     * @return Bytes by part (allocator overhead not included)
+     */
+    BoardMemory memoryUsage() const;
+
+    /**
+     * Predict memoryUsage() of a new Board(size, ghostCount) without building it
+     * @param size The size of the square board
+     * @param ghostCount Number of ghosts
+     */
+    static BoardMemory estimateMemory(int size, int ghostCount);
 
 private:
     const int GRID_SIZE;
-    static const int G_NUM = 4;  // Number of ghosts
+    static const int G_NUM = 4;  // Default number of ghosts
+
+    // Power pellets and ghost modes
+    static const int PELLET_POINTS = 50;
+    static const int GHOST_POINTS = 200;       // Doubles for each ghost eaten in one fright
+    static const int FRIGHTENED_TICKS = 20;
+    static const int RESPAWN_TICKS = 10;       // An eaten ghost waits at home this long
+    static const char FRIGHTENED_APPEARANCE = 'V';
+
+    // Timer events: kind in the top byte, ghost index below
+    static const uint32_t MODE_EVENT = 1u << 24;
+    static const uint32_t FRIGHT_EVENT = 2u << 24;
+    static const uint32_t RESPAWN_EVENT = 3u << 24;
+    static const uint32_t SCRIPT_EVENT = 4u << 24;
+
+    /**
+     * ScriptSlot - a scripted ghost
+     */
+    struct ScriptSlot {
+        ScriptSelf self;       // Scripts hold its address, so slots never move
+        GhostScript script;    // Empty when the ghost runs no script
+        bool sleeping;         // Parked on the timer wheel by a wait
+        int timer;             // The wait's timer, or -1
+    };
 
-    std::vector<std::vector<char>> grid;      // Board representation
-    std::vector<std::vector<bool>> visited;   // Track visited positions
+    std::vector<char> grid;                   // Board representation, row by row
+    std::vector<char> visited;                // Track visited positions (0/1), same layout
 
-    Pacman* pacman;                           // Pointer to Pacman (polymorphism)
-    std::vector<Ghost*> ghosts;               // Pointers to ghosts (polymorphism)
+    // Characters are stored by value: one array per ghost kind, so the
+    // tick loop knows every ghost's type without a virtual call
+    Pacman pacman;
+    std::vector<Ghost> chasers;
+    std::vector<Blinky> blinkies;
+    std::vector<Pinky> pinkies;
+    std::vector<Inky> inkies;
+    std::vector<Clyde> clydes;
+    std::vector<Ghost*> ghosts;               // Every ghost, in move order (see linkGhosts)
+    Direction pacmanHeading;                  // Pacman's last move (for Pinky and Inky)
 
     int score;
     bool gameOver;
+    int dotsRemaining;                        // Unvisited cells
+    int tickCount;                            // Number of move() calls
+
+    // Ghost modes. Fright ends for every ghost at once: a ghost is
+    // frightened while a fright runs unless it was eaten during this one
+    // (eatenEpoch == frightEpoch), so no per-ghost timer is ever checked.
+    TimerWheel timers;                        // Mode switches, fright end, respawns
+    GhostMode ghostMode;
+    int modePhase;                            // Next entry of the mode schedule
+    bool frightened;
+    uint32_t frightEpoch;                     // Counts power pellets eaten
+    int frightTimer;                          // Timer ending the fright, or -1
+    int ghostsEaten;                          // In the current fright
+    uint32_t randomState;                     // For frightened wandering
+    std::vector<char> pellets;                // Per cell, empty without power pellets
+    std::vector<uint32_t> eatenEpoch;         // Per ghost, empty without power pellets
+    std::vector<char> waiting;                // Per ghost: eaten, waiting at home
+    std::vector<int> homes;                   // Per ghost: starting cell
+
+    // Ghost scripts. The arena is declared first so the frames in the
+    // slots are destroyed before it.
+    ScriptArena scriptArena;
+    std::vector<ScriptSlot> scripts;          // Per ghost, empty until the first script
+
+    std::vector<int> drawnCells;              // Cells characters were last drawn on
+    std::vector<int> changedCells;            // Cells changed during the current tick
+    std::vector<int> touchedCells;            // Scratch for refreshGrid
+    std::vector<char> touchedBefore;          // Scratch for refreshGrid
+    NavGraph* navigation;                     // Open moves, built from the walls once
+    DistanceField* distances;                 // Steps to Pacman, shared by the ghosts
+    Pathfinder* pathfinder;                   // Per-ghost paths (GhostNav::ASTAR only)
+    DistanceTable* distanceTable;             // All-pairs distances (small loaded boards only)
+    DistanceField* scriptDistances;           // Steps to scripts' targets (created on first use)
+    GhostSearch* ghostSearch;                 // Chaser lookahead (GhostDifficulty::HARD only)
+    std::vector<int> searchCells;             // Scratch for planChasers: every ghost's cell
+    std::vector<int> searchGhosts;            // Scratch for planChasers: chasers to search for
+    std::vector<Direction> searchMoves;       // Per chaser, this tick's searched move
+
+    static size_t distanceTableBudget;
+    static bool distanceTableCache;
+
+    /**
+     * Get the cell index of a grid position
+     */
+    int cellIndex(int row, int col) const { return row * GRID_SIZE + col; }
+
+    /**
+     * Get the number of cells on the board
+     */
+    size_t cellCount() const { return static_cast<size_t>(GRID_SIZE) * GRID_SIZE; }
+
+    /**
+     * Record the cells characters are drawn on (for refreshGrid)
+     */
+    void rememberDrawnCells();
+
+    /**
+     * Size the refresh scratch buffers for the character count, record
+     * the initial drawn cells and build the navigation graph and distance
+     * field, so move() never allocates
+     */
+    void initTracking();
+
+    /**
+     * List every ghost in ghosts, once the arrays are filled
+     */
+    void linkGhosts();
+
+    /**
+     * Get the move of a chaser (see ghostMove)
+     * @param ghost The ghost to move
+     * @param index Its index in ghosts, or -1
+     * @param preferred Its own decideMove choice
+     */
+    Direction chaserMove(const PacCharacter* ghost, int index, Direction preferred);
+
+    /**
+     * Move every ghost of a personality group, calling the policy directly
+     * @param index Index in ghosts of the group's first ghost; advanced
+     *        past the group
+     * @param caught Set once a ghost reaches Pacman; later ghosts stay
+     */
+    template <typename Policy>
+    void moveGroup(std::vector<PersonalityGhost<Policy>>& group, int& index, bool& caught);
+
+    /**
+     * Call visit(ghost, index) for every ghost in move order, reading the
+     * group arrays directly rather than through ghosts
+     */
+    template <typename Visit>
+    void forEachGhost(Visit&& visit);
+
+    /**
+     * Move a ghost one step and check whether it caught Pacman (or, if
+     * frightened, was eaten)
+     * @param index The ghost's index in ghosts
+     */
+    void stepGhost(Ghost& ghost, int index, Direction direction, bool& caught);
+
+    /**
+     * Check if the ghost at an index is frightened
+     */
+    bool ghostFrightened(int index) const {
+        return frightened && eatenEpoch[index] != frightEpoch;
+    }
+
+    /**
+     * Check if the ghost at an index sits out this tick: waiting at home,
+     * or frightened on an odd tick
+     */
+    bool ghostResting(int index) const;
+
+    /**
+     * Get a random open move for a frightened ghost
+     */
+    Direction wanderMove(const Ghost& ghost);
+
+    /**
+     * Get the character a ghost is drawn as
+     * @param index The ghost's index in ghosts
+     */
+    char ghostChar(const Ghost& ghost, int index) const;
+
+    /**
+     * Get what an empty cell shows: ' ', '*' or 'o'
+     */
+    char floorChar(size_t cell) const;
+
+    /**
+     * Set up pellets, per-ghost mode state and the mode schedule
+     * (after the ghosts are linked)
+     */
+    void initModes();
+
+    /**
+     * Handle the timers due this tick
+     */
+    void runTimers();
+
+    /**
+     * Frighten every ghost (Pacman ate a power pellet)
+     */
+    void startFright();
+
+    /**
+     * Send a ghost home and score it
+     * @param index The ghost's index in ghosts
+     */
+    void eatGhost(Ghost& ghost, int index);
+
+    /**
+     * Eat every frightened ghost on Pacman's cell
+     */
+    void eatGhostsAtPacman();
+
+    /**
+     * Search this tick's moves for the chasers free to chase
+     */
+    void planChasers();
+
+    /**
+     * Get a ghost's slot ready for a new script
+     */
+    ScriptSelf& prepareScript(int index);
+
+    /**
+     * Hand a ghost's new script to its slot
+     */
+    void startScript(int index, GhostScript script);
+
+    /**
+     * Resume a ghost's script, if it runs one, and carry out its action
+     * @param direction Set to the ghost's move
+     * @return false if the ghost has no script (or it just returned)
+     */
+    bool runScript(Ghost& ghost, int index, Direction& direction) {
+        return !scripts.empty() && stepScript(ghost, index, direction);
+    }
+
+    /**
+     * Resume a script (see runScript)
+     */
+    bool stepScript(Ghost& ghost, int index, Direction& direction);
+
+    /**
+     * Get the move that carries out a script's action
+     */
+    Direction scriptMove(Ghost& ghost, int index, ScriptSlot& slot);
+
+    /**
+     * Get the steps between two cells for scripts (UINT32_MAX if walled off)
+     */
+    uint32_t scriptDistance(int from, int to);
+
+    /**
+     * Get what the personality ghosts target this tick
+     */
+    GhostTargetContext targetContext() const;
+
+    /**
+     * Pick the neighbour of a ghost closest to Pacman
+     * @param ghost The ghost to move
+     * @param preferred Taken when it is one of the closest neighbours
+     */
+    Direction chaseMove(const PacCharacter* ghost, Direction preferred);
 
     /**
-     * Helper function for toString
-     * @return Grid as string
+     * Get the steps from a cell to Pacman (UINT32_MAX if walled off)
      */
-    std::string toStringHelper() const;
+    uint32_t distanceToPacman(int cell);
 };
 
 #endif // BOARD_H
\ No newline at end of file
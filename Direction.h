@@ -52,6 +52,22 @@ struct DirectionHelper {
         }
         return 0;
     }
+
+    /**
+     * Get the direction that undoes a move
+     * @param dir The direction
+     * @return The opposite direction (STAY for STAY)
+     */
+    static Direction opposite(Direction dir) {
+        switch(dir) {
+            case Direction::UP:    return Direction::DOWN;
+            case Direction::DOWN:  return Direction::UP;
+            case Direction::LEFT:  return Direction::RIGHT;
+            case Direction::RIGHT: return Direction::LEFT;
+            case Direction::STAY:  return Direction::STAY;
+        }
+        return Direction::STAY;
+    }
 };
 
 #endif // DIRECTION_H
\ No newline at end of file
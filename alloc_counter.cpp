@@ -0,0 +1,82 @@
+// alloc_counter.cpp
+
+#include "alloc_counter.h"
+#include <cstdlib>
+#include <new>
+
+namespace {
+// Per thread, so a measurement is not disturbed by worker threads
+thread_local uint64_t allocationCount = 0;
+thread_local uint64_t allocationBytes = 0;
+}
+
+bool AllocCounter::isActive() {
+#ifdef PACMAN_ALLOC_COUNT
+    return true;
+#else
+    return false;
+#endif
+}
+
+uint64_t AllocCounter::allocations() {
+    return allocationCount;
+}
+
+uint64_t AllocCounter::bytes() {
+    return allocationBytes;
+}
+
+#ifdef PACMAN_ALLOC_COUNT
+
+// Replacement global allocation functions. The over-aligned forms are left
+// to the standard library (nothing in the game uses them).
+
+void* operator new(std::size_t size) {
+    allocationCount++;
+    allocationBytes += size;
+    void* ptr = std::malloc(size != 0 ? size : 1);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    allocationCount++;
+    allocationBytes += size;
+    return std::malloc(size != 0 ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept {
+    return operator new(size, tag);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+    std::free(ptr);
+}
+
+#endif // PACMAN_ALLOC_COUNT
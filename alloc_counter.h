@@ -0,0 +1,47 @@
+// alloc_counter.h
+
+#ifndef ALLOC_COUNTER_H
+#define ALLOC_COUNTER_H
+
+#include <cstdint>
+
+/**
+ * AllocCounter class - counts heap allocations made by the calling thread
+ * Counting works by replacing the global operator new, which is only
+ * compiled in with PACMAN_ALLOC_COUNT (make ALLOC_COUNT=1). Without it
+ * every count stays zero and isActive() returns false.
+ */
+class AllocCounter {
+public:
+    /**
+     * Check if allocations are being counted in this build
+     */
+    static bool isActive();
+
+    /**
+     * Get the number of allocations made by the calling thread
+     */
+    static uint64_t allocations();
+
+    /**
+     * Get the number of bytes requested by the calling thread
+     */
+    static uint64_t bytes();
+};
+
+/**
+ * AllocScope class - allocations made by the calling thread since construction
+ */
+class AllocScope {
+public:
+    AllocScope() : startAllocations(AllocCounter::allocations()), startBytes(AllocCounter::bytes()) {}
+
+    uint64_t allocations() const { return AllocCounter::allocations() - startAllocations; }
+    uint64_t bytes() const { return AllocCounter::bytes() - startBytes; }
+
+private:
+    uint64_t startAllocations;
+    uint64_t startBytes;
+};
+
+#endif // ALLOC_COUNTER_H
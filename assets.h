@@ -0,0 +1,41 @@
+// assets.h
+
+#ifndef ASSETS_H
+#define ASSETS_H
+
+#include <cstddef>
+#include <string_view>
+#include "assets_generated.h"   // Built from image/ and fonts/ by tools/embed_assets
+
+/**
+ * EmbeddedAsset - bytes of one file compiled into the executable
+ */
+struct EmbeddedAsset {
+    const unsigned char* data;
+    std::size_t size;
+};
+
+/**
+ * Find an embedded file by its path relative to the repository root
+ * Usable in constant expressions, e.g. static_assert(findAsset("x") >= 0)
+ * @param name The asset path, e.g. "image/cherry.png"
+ * @return Index into ASSET_INDEX, or -1 if the file was not embedded
+ */
+constexpr int findAsset(std::string_view name) {
+    for (int i = 0; i < ASSET_COUNT; i++) {
+        if (std::string_view(ASSET_INDEX[i].name) == name) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Get the bytes of an embedded file
+ * @param index Index returned by findAsset (must be >= 0)
+ */
+inline EmbeddedAsset getAsset(int index) {
+    return EmbeddedAsset{ASSET_BLOB + ASSET_INDEX[index].offset, ASSET_INDEX[index].size};
+}
+
+#endif // ASSETS_H
@@ -0,0 +1,288 @@
+// batch_driver.cpp
+
+#include "batch_driver.h"
+#include <charconv>
+#include <stdexcept>
+
+namespace {
+
+/**
+ * Split off the next space-separated word of a line
+ * @return The word (empty at the end of the line)
+ */
+std::string_view nextWord(std::string_view& line) {
+    size_t start = line.find_first_not_of(" \t\r");
+    if (start == std::string_view::npos) {
+        line = std::string_view();
+        return line;
+    }
+    size_t end = line.find_first_of(" \t\r", start);
+    if (end == std::string_view::npos) {
+        end = line.size();
+    }
+    std::string_view word = line.substr(start, end - start);
+    line.remove_prefix(end);
+    return word;
+}
+
+/**
+ * Parse a whole word as a number
+ * @return false if the word is not a number
+ */
+bool parseInt(std::string_view word, int& value) {
+    std::from_chars_result result = std::from_chars(word.data(), word.data() + word.size(), value);
+    return result.ec == std::errc() && result.ptr == word.data() + word.size();
+}
+
+void appendInt(std::string& out, long long value) {
+    char digits[24];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+    out.append(digits, result.ptr);
+}
+
+const char* statusName(GameStatus status) {
+    switch (status) {
+        case GameStatus::CAUGHT:  return "caught";
+        case GameStatus::CLEARED: return "cleared";
+        default:                  return "playing";
+    }
+}
+
+} // namespace
+
+/**
+ * Constructor
+ */
+BatchDriver::BatchDriver(std::istream& in, std::ostream& out, int maxBoardSize)
+    : in(in), out(out), binary(false), errors(0), maxBoardSize(maxBoardSize) {}
+
+/**
+ * Destructor
+ */
+BatchDriver::~BatchDriver() {
+    for (auto& entry : games) {
+        delete entry.second;
+    }
+}
+
+/**
+ * Answers are written when no more input is waiting, so a driver that
+ * pipes many lines at once gets them back in few large writes
+ */
+int BatchDriver::run() {
+    std::string line;
+    while (std::getline(in, line)) {
+        bool keepGoing = handleLine(line);
+        if (!keepGoing || in.rdbuf()->in_avail() <= 0) {
+            flush();
+        }
+        if (!keepGoing) {
+            break;
+        }
+    }
+    flush();
+    return errors;
+}
+
+bool BatchDriver::handleLine(std::string_view line) {
+    std::string_view command = nextWord(line);
+    if (command.empty() || command[0] == '#') {
+        return true;
+    }
+
+    if (command == "move") {
+        while (true) {
+            std::string_view id = nextWord(line);
+            if (id.empty()) {
+                break;
+            }
+            std::string_view keys = nextWord(line);
+            GameSession* session = findGame(id);
+            if (session == nullptr) {
+                continue;
+            }
+            moves.clear();
+            bool valid = true;
+            for (char key : keys) {
+                switch (key) {
+                    case 'w': moves.push_back(Direction::UP); break;
+                    case 's': moves.push_back(Direction::DOWN); break;
+                    case 'a': moves.push_back(Direction::LEFT); break;
+                    case 'd': moves.push_back(Direction::RIGHT); break;
+                    case '.': moves.push_back(Direction::STAY); break;
+                    default:  valid = false; break;
+                }
+            }
+            if (!valid) {
+                appendError(id, "bad move key");
+                continue;
+            }
+            session->move(moves.data(), static_cast<int>(moves.size()));
+            appendStatus(id, *session);
+        }
+    }
+    else if (command == "new") {
+        std::string_view id = nextWord(line);
+        int size = 0, ghostCount = 4;
+        std::string_view ghostWord;
+        if (id.empty() || !parseInt(nextWord(line), size) ||
+            (!(ghostWord = nextWord(line)).empty() && !parseInt(ghostWord, ghostCount))) {
+            appendError(command, "usage: new <id> <size> [ghosts]");
+        } else if (size < 3 || size > maxBoardSize) {
+            appendError(id, ("size must be 3 to " + std::to_string(maxBoardSize)).c_str());
+        } else if (ghostCount < 1 || ghostCount > 4 * (size - 1)) {
+            appendError(id, ("ghosts must be 1 to " + std::to_string(4 * (size - 1))).c_str());
+        } else {
+            // Built before it replaces anything, as load does
+            GameSession* session = new GameSession();
+            try {
+                session->newGame(size, ghostCount);
+            } catch (const std::exception&) {
+                delete session;
+                appendError(id, "cannot start game");
+                return true;
+            }
+            auto it = games.find(id);
+            if (it != games.end()) {
+                delete it->second;
+                it->second = session;
+            } else {
+                games.emplace(std::string(id), session);
+            }
+            appendStatus(id, *session);
+        }
+    }
+    else if (command == "load") {
+        std::string_view id = nextWord(line);
+        std::string_view file = nextWord(line);
+        if (id.empty() || file.empty()) {
+            appendError(command, "usage: load <id> <file>");
+            return true;
+        }
+        GameSession* session = new GameSession();
+        try {
+            session->loadGame(std::string(file));
+        } catch (const std::exception&) {
+            delete session;
+            appendError(id, "cannot load board");
+            return true;
+        }
+        auto it = games.find(id);
+        if (it != games.end()) {
+            delete it->second;
+            it->second = session;
+        } else {
+            games.emplace(std::string(id), session);
+        }
+        appendStatus(id, *session);
+    }
+    else if (command == "state") {
+        for (std::string_view id = nextWord(line); !id.empty(); id = nextWord(line)) {
+            GameSession* session = findGame(id);
+            if (session != nullptr) {
+                appendStatus(id, *session);
+            }
+        }
+    }
+    else if (command == "board") {
+        std::string_view id = nextWord(line);
+        GameSession* session = findGame(id);
+        if (session != nullptr) {
+            session->getBoard()->writeString(boardText);
+            reply += boardText;
+            appendStatus(id, *session);
+        }
+    }
+    else if (command == "save") {
+        std::string_view id = nextWord(line);
+        std::string_view file = nextWord(line);
+        GameSession* session = findGame(id);
+        if (session != nullptr) {
+            try {
+                session->saveGame(std::string(file));
+                appendStatus(id, *session);
+            } catch (const std::exception&) {
+                appendError(id, "cannot save board");
+            }
+        }
+    }
+    else if (command == "drop") {
+        std::string_view id = nextWord(line);
+        auto it = games.find(id);
+        if (it == games.end()) {
+            appendError(id, "no such game");
+        } else {
+            delete it->second;
+            games.erase(it);
+        }
+    }
+    else if (command == "binary") {
+        std::string_view mode = nextWord(line);
+        if (mode == "on" || mode == "off") {
+            binary = mode == "on";
+        } else {
+            appendError(command, "usage: binary on|off");
+        }
+    }
+    else if (command == "quit") {
+        return false;
+    }
+    else {
+        appendError(command, "unknown command");
+    }
+    return true;
+}
+
+GameSession* BatchDriver::findGame(std::string_view id) {
+    auto it = games.find(id);
+    if (it == games.end()) {
+        appendError(id.empty() ? std::string_view("-") : id, "no such game");
+        return nullptr;
+    }
+    return it->second;
+}
+
+void BatchDriver::appendStatus(std::string_view id, const GameSession& session) {
+    StateFrame state = session.getState();
+    if (binary) {
+        uint8_t header[4];
+        WireFormat::putU32(header, static_cast<uint32_t>(id.size()));
+        reply.append(reinterpret_cast<const char*>(header), sizeof(header));
+        reply += id;
+        uint8_t frame[StateFrame::SIZE];
+        state.encode(frame);
+        reply.append(reinterpret_cast<const char*>(frame), sizeof(frame));
+        return;
+    }
+    reply += id;
+    reply += ' ';
+    reply += statusName(state.status);
+    reply += ' ';
+    appendInt(reply, state.score);
+    reply += ' ';
+    appendInt(reply, state.ticks);
+    reply += ' ';
+    appendInt(reply, state.dotsRemaining);
+    reply += ' ';
+    appendInt(reply, state.pacmanRow);
+    reply += ' ';
+    appendInt(reply, state.pacmanCol);
+    reply += '\n';
+}
+
+void BatchDriver::appendError(std::string_view subject, const char* reason) {
+    errors++;
+    reply += "err ";
+    reply += subject;
+    reply += ' ';
+    reply += reason;
+    reply += '\n';
+}
+
+void BatchDriver::flush() {
+    if (!reply.empty()) {
+        out.write(reply.data(), static_cast<std::streamsize>(reply.size()));
+        reply.clear();
+    }
+    out.flush();
+}
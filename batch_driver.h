@@ -0,0 +1,101 @@
+// batch_driver.h
+
+#ifndef BATCH_DRIVER_H
+#define BATCH_DRIVER_H
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <map>
+#include <vector>
+#include "game_session.h"
+
+/**
+ * BatchDriver class - machine interface for scripted drivers (pacman --batch)
+ * Reads one command per line and answers with one status line per game
+ * touched; the board is only printed when asked for. Games are named by
+ * any word without spaces, so one driver can run many games at once.
+ *
+ * Commands:
+ *   new <id> <size> [ghosts]       Start a new game (3 .. maxBoardSize, and at
+ *                                  most one ghost per border cell)
+ *   load <id> <file>               Start a game from a saved board
+ *   move <id> <keys> [<id> <keys>...]
+ *                                  Apply moves (w/a/s/d, '.' stays) to each game
+ *   state <id>...                  Report games without moving
+ *   board <id>                     Print the board text, then the status line
+ *   save <id> <file>               Save a game to a file
+ *   drop <id>                      Forget a game
+ *   binary on|off                  Answer with binary STATE frames instead of lines
+ *   quit                           Stop reading
+ *
+ * Status line: <id> <playing|caught|cleared> <score> <ticks> <dots> <row> <col>
+ * Error line:  err <id or command> <reason>
+ * Binary mode: each status is a u32 length-prefixed id followed by a
+ * StateFrame (see game_protocol.h); errors and boards stay text.
+ */
+class BatchDriver {
+public:
+    static const int DEFAULT_MAX_BOARD_SIZE = 1000;
+
+    /**
+     * Constructor
+     * @param in Command stream
+     * @param out Answer stream
+     * @param maxBoardSize Largest board new may start
+     */
+    BatchDriver(std::istream& in, std::ostream& out, int maxBoardSize = DEFAULT_MAX_BOARD_SIZE);
+
+    /**
+     * Destructor - frees every game
+     */
+    ~BatchDriver();
+
+    BatchDriver(const BatchDriver&) = delete;
+    BatchDriver& operator=(const BatchDriver&) = delete;
+
+    /**
+     * Process commands until quit or end of input
+     * @return Number of commands answered with an error
+     */
+    int run();
+
+private:
+    std::istream& in;
+    std::ostream& out;
+    std::map<std::string, GameSession*, std::less<>> games;
+    std::string reply;          // Answers not yet written
+    std::string boardText;      // Reused buffer for board output
+    std::vector<Direction> moves;
+    bool binary;
+    int errors;
+    int maxBoardSize;
+
+    /**
+     * Handle one command line
+     * @return false on quit
+     */
+    bool handleLine(std::string_view line);
+
+    /**
+     * Find a game by id, answering with an error if it does not exist
+     */
+    GameSession* findGame(std::string_view id);
+
+    /**
+     * Append the status of a game to the reply
+     */
+    void appendStatus(std::string_view id, const GameSession& session);
+
+    /**
+     * Append an error line to the reply
+     */
+    void appendError(std::string_view subject, const char* reason);
+
+    /**
+     * Write the pending reply
+     */
+    void flush();
+};
+
+#endif // BATCH_DRIVER_H
@@ -0,0 +1,458 @@
+// board_bench.cpp
+// Micro-benchmarks for the Board hot paths across board sizes and ghost counts
+//
+// Every (operation, size, ghosts) case is repeated until it has run for at
+// least the time budget, and one JSON document with ns per call is printed.
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <unistd.h>
+#include "../Board.h"
+#include "../alloc_counter.h"
+#include "../observation_encoder.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const Direction MOVE_CYCLE[] = {Direction::LEFT, Direction::UP, Direction::RIGHT, Direction::DOWN};
+
+/**
+ * Result of one benchmark case
+ */
+struct Result {
+    std::string op;
+    int size;
+    int ghosts;
+    long long iterations;   // Calls of the measured operation
+    double totalMs;
+    uint64_t allocations;   // Heap allocations inside the timed batches
+    bool skipped;
+    std::string reason;
+};
+
+// Operations that must not touch the heap once the board is set up
+const char* const ALLOCATION_FREE_OPS[] = {
+    "move", "moveHard", "moveScripted", "refreshGrid", "ghostMove", "decideMove", "isGameOver", "writeString",
+    "encode", "encodeBits", "encodeUpdate"
+};
+
+// Keeps results observable so the compiler cannot drop the measured calls
+volatile size_t sink = 0;
+
+/**
+ * Run op in growing batches until budgetMs has been spent inside it
+ * One untimed warm-up call lets reusable buffers reach their size first.
+ * op() returns false when the state is used up; reset() then runs untimed.
+ * @param calls Number of operation calls made by one op() invocation
+ */
+template <typename Op, typename Reset>
+void measure(Result& result, double budgetMs, long long calls, Op op, Reset reset) {
+    if (!op()) {
+        reset();
+    }
+
+    double elapsedMs = 0;
+    long long iterations = 0;
+    long long batch = 1;
+    uint64_t allocations = 0;
+    while (elapsedMs < budgetMs) {
+        bool needsReset = false;
+        long long done = 0;
+        AllocScope allocs;
+        auto start = Clock::now();
+        while (done < batch) {
+            done++;
+            if (!op()) {
+                needsReset = true;
+                break;
+            }
+        }
+        elapsedMs += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        allocations += allocs.allocations();
+        iterations += done;
+        if (needsReset) {
+            reset();
+        } else if (elapsedMs < budgetMs / 4) {
+            batch *= 2;
+        }
+    }
+    result.iterations = iterations * calls;
+    result.totalMs = elapsedMs;
+    result.allocations = allocations;
+}
+
+/**
+ * Parse a comma separated list of integers
+ */
+std::vector<int> parseList(const std::string& text) {
+    std::vector<int> values;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) {
+            values.push_back(std::stoi(item));
+        }
+    }
+    return values;
+}
+
+void printUsage() {
+    std::cout << "Usage: pacman-bench [--sizes list] [--ghosts list] [--ops list]" << std::endl;
+    std::cout << "                    [--budget ms] [--max-cells n] [--max-planes-mb mb] [-o file]" << std::endl;
+    std::cout << std::endl;
+    std::cout << "  --sizes [list]  -> Board sizes (default: 10,100,1000,10000)" << std::endl;
+    std::cout << "  --ghosts [list] -> Ghost counts (default: 4,40,1000)" << std::endl;
+    std::cout << "  --ops [list]    -> Operations (default: all)" << std::endl;
+    std::cout << "                     move,moveHard,moveScripted,refreshGrid,ghostMove,decideMove," << std::endl;
+    std::cout << "                     isGameOver,toString,writeString,saveBoard,loadBoard," << std::endl;
+    std::cout << "                     encode,encodeBits,encodeUpdate" << std::endl;
+    std::cout << "  --budget [ms]   -> Minimum measured time per case (default: 200)" << std::endl;
+    std::cout << "  --max-cells [n] -> Skip boards with more cells (default: 100000000)" << std::endl;
+    std::cout << "  --max-planes-mb [mb] -> Skip encode cases needing larger planes (default: 1024)" << std::endl;
+    std::cout << "  -o [file]       -> Write the JSON report to a file instead of stdout" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Built with make ALLOC_COUNT=1, allocations per call are reported and the" << std::endl;
+    std::cout << "run fails (exit 2) if an operation that must be allocation-free allocates." << std::endl;
+}
+
+/**
+ * Check if an operation must be allocation-free
+ */
+bool mustNotAllocate(const std::string& op) {
+    for (const char* name : ALLOCATION_FREE_OPS) {
+        if (op == name) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Check if an operation was selected
+ */
+bool wanted(const std::vector<std::string>& ops, const std::string& op) {
+    if (ops.empty()) {
+        return true;
+    }
+    for (const std::string& name : ops) {
+        if (name == op) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Run every selected operation for one board configuration
+ */
+void runCase(int size, int ghostCount, double budgetMs, const std::vector<std::string>& ops,
+             size_t maxPlaneBytes, const std::string& tempFile, std::vector<Result>& results) {
+    Board* board = new Board(size, ghostCount);
+    int tick = 0;
+    auto freshBoard = [&]() {
+        delete board;
+        board = new Board(size, ghostCount);
+        tick = 0;
+    };
+    auto add = [&](const std::string& op) -> Result& {
+        results.push_back(Result{op, size, ghostCount, 0, 0.0, 0, false, ""});
+        return results.back();
+    };
+    auto skip = [&](const std::string& op, const std::string& reason) {
+        results.push_back(Result{op, size, ghostCount, 0, 0.0, 0, true, reason});
+    };
+
+    if (wanted(ops, "move")) {
+        freshBoard();
+        measure(add("move"), budgetMs, 1, [&]() {
+            board->move(MOVE_CYCLE[(tick++ / 3) % 4]);
+            return !board->getIsGameOver();
+        }, freshBoard);
+    }
+
+    // HARD ghosts searching on four threads to a fixed depth, so the
+    // steady state includes handing every depth out to the helpers
+    if (wanted(ops, "moveHard")) {
+        auto hardBoard = [&]() {
+            freshBoard();
+            GhostSearchOptions options;
+            options.budgetMs = 0;
+            options.maxDepth = 3;
+            options.threads = 4;
+            board->setGhostDifficulty(GhostDifficulty::HARD, options);
+        };
+        hardBoard();
+        measure(add("moveHard"), budgetMs, 1, [&]() {
+            board->move(MOVE_CYCLE[(tick++ / 3) % 4]);
+            return !board->getIsGameOver();
+        }, hardBoard);
+    }
+
+    // Every ghost patrolling the corners as a coroutine script. The first
+    // tick starts each script's first step, whose frames fill the arena,
+    // so it runs with the setup.
+    if (wanted(ops, "moveScripted")) {
+        auto scriptedBoard = [&]() {
+            freshBoard();
+            std::vector<GridTarget> corners = GhostScripts::corners(size);
+            for (int i = 0; i < ghostCount; i++) {
+                board->setGhostScript(i, GhostScripts::patrol, corners, 5, 10);
+            }
+            board->move(MOVE_CYCLE[(tick++ / 3) % 4]);
+        };
+        scriptedBoard();
+        measure(add("moveScripted"), budgetMs, 1, [&]() {
+            board->move(MOVE_CYCLE[(tick++ / 3) % 4]);
+            return !board->getIsGameOver();
+        }, scriptedBoard);
+    }
+
+    if (wanted(ops, "refreshGrid")) {
+        freshBoard();
+        measure(add("refreshGrid"), budgetMs, 1, [&]() {
+            board->refreshGrid();
+            return true;
+        }, freshBoard);
+    }
+
+    if (wanted(ops, "ghostMove")) {
+        freshBoard();
+        measure(add("ghostMove"), budgetMs, ghostCount, [&]() {
+            size_t sum = 0;
+            for (Ghost* ghost : board->getGhosts()) {
+                sum += static_cast<size_t>(board->ghostMove(ghost));
+            }
+            sink = sink + sum;
+            return true;
+        }, freshBoard);
+    }
+
+    if (wanted(ops, "decideMove")) {
+        freshBoard();
+        int center = size / 2;
+        measure(add("decideMove"), budgetMs, ghostCount, [&]() {
+            size_t sum = 0;
+            for (Ghost* ghost : board->getGhosts()) {
+                sum += static_cast<size_t>(ghost->decideMove(center, center));
+            }
+            sink = sink + sum;
+            return true;
+        }, freshBoard);
+    }
+
+    if (wanted(ops, "isGameOver")) {
+        freshBoard();
+        measure(add("isGameOver"), budgetMs, 1, [&]() {
+            sink = sink + board->isGameOver();
+            return true;
+        }, freshBoard);
+    }
+
+    if (wanted(ops, "toString")) {
+        freshBoard();
+        measure(add("toString"), budgetMs, 1, [&]() {
+            sink = sink + board->toString().size();
+            return true;
+        }, freshBoard);
+    }
+
+    if (wanted(ops, "writeString")) {
+        freshBoard();
+        std::string text;
+        measure(add("writeString"), budgetMs, 1, [&]() {
+            board->writeString(text);
+            sink = sink + text.size();
+            return true;
+        }, freshBoard);
+    }
+
+    // Observation planes: full encodes, and a move followed by an update.
+    // The planes grow with cells times ghosts, so large cases are skipped.
+    const char* const encodeOps[] = {"encode", "encodeBits"};
+    for (int bits = 0; bits < 2; bits++) {
+        if (!wanted(ops, encodeOps[bits])) {
+            continue;
+        }
+        ObservationEncoder encoder(size, ghostCount,
+                                   bits ? ObservationEncoder::Format::BITS : ObservationEncoder::Format::UINT8);
+        if (encoder.getBufferSize() > maxPlaneBytes) {
+            skip(encodeOps[bits], "over --max-planes-mb");
+            continue;
+        }
+        freshBoard();
+        std::vector<uint8_t> planes(encoder.getBufferSize());
+        measure(add(encodeOps[bits]), budgetMs, 1, [&]() {
+            encoder.encode(*board, planes.data());
+            sink = sink + planes[0];
+            return true;
+        }, freshBoard);
+    }
+
+    if (wanted(ops, "encodeUpdate")) {
+        ObservationEncoder encoder(size, ghostCount, ObservationEncoder::Format::BITS);
+        if (encoder.getBufferSize() > maxPlaneBytes) {
+            skip("encodeUpdate", "over --max-planes-mb");
+        } else {
+            freshBoard();
+            std::vector<uint8_t> planes(encoder.getBufferSize());
+            encoder.encode(*board, planes.data());
+            measure(add("encodeUpdate"), budgetMs, 1, [&]() {
+                board->move(MOVE_CYCLE[(tick++ / 3) % 4]);
+                encoder.update(*board, planes.data());
+                return !board->getIsGameOver();
+            }, [&]() {
+                freshBoard();
+                encoder.encode(*board, planes.data());
+            });
+        }
+    }
+
+    if (wanted(ops, "saveBoard")) {
+        freshBoard();
+        measure(add("saveBoard"), budgetMs, 1, [&]() {
+            board->saveBoard(tempFile);
+            return true;
+        }, freshBoard);
+    }
+
+    if (wanted(ops, "loadBoard")) {
+        freshBoard();
+        board->saveBoard(tempFile);
+        measure(add("loadBoard"), budgetMs, 1, [&]() {
+            Board loaded(tempFile);
+            sink = sink + loaded.getScore();
+            return true;
+        }, []() {});
+    }
+    std::remove(tempFile.c_str());
+
+    delete board;
+}
+
+/**
+ * Write the results as one JSON document
+ */
+void writeJson(std::ostream& out, const std::vector<Result>& results, double budgetMs) {
+    out << "{\"benchmark\": \"board\", \"budget_ms\": " << budgetMs
+        << ", \"alloc_counting\": " << (AllocCounter::isActive() ? "true" : "false")
+        << ", \"results\": [";
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result& r = results[i];
+        out << (i == 0 ? "\n" : ",\n")
+            << "  {\"op\": \"" << r.op << "\""
+            << ", \"size\": " << r.size
+            << ", \"ghosts\": " << r.ghosts;
+        if (r.skipped) {
+            out << ", \"skipped\": \"" << r.reason << "\"}";
+            continue;
+        }
+        out << ", \"iterations\": " << r.iterations
+            << ", \"total_ms\": " << r.totalMs
+            << ", \"ns_per_op\": " << (r.iterations > 0 ? r.totalMs * 1e6 / r.iterations : 0.0);
+        if (AllocCounter::isActive()) {
+            out << ", \"allocs_per_op\": "
+                << (r.iterations > 0 ? static_cast<double>(r.allocations) / r.iterations : 0.0);
+        }
+        out << "}";
+    }
+    out << "\n]}" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<std::string> args(argv, argv + argc);
+
+    std::vector<int> sizes = {10, 100, 1000, 10000};
+    std::vector<int> ghostCounts = {4, 40, 1000};
+    std::vector<std::string> ops;
+    double budgetMs = 200;
+    long long maxCells = 100000000LL;
+    double maxPlanesMb = 1024;
+    std::string outputFile = "";
+
+    for (size_t i = 1; i < args.size(); i++) {
+        if (args[i] == "--sizes" && i + 1 < args.size()) {
+            sizes = parseList(args[++i]);
+        }
+        else if (args[i] == "--ghosts" && i + 1 < args.size()) {
+            ghostCounts = parseList(args[++i]);
+        }
+        else if (args[i] == "--ops" && i + 1 < args.size()) {
+            std::stringstream ss(args[++i]);
+            std::string op;
+            while (std::getline(ss, op, ',')) {
+                ops.push_back(op);
+            }
+        }
+        else if (args[i] == "--budget" && i + 1 < args.size()) {
+            budgetMs = std::stod(args[++i]);
+        }
+        else if (args[i] == "--max-cells" && i + 1 < args.size()) {
+            maxCells = std::stoll(args[++i]);
+        }
+        else if (args[i] == "--max-planes-mb" && i + 1 < args.size()) {
+            maxPlanesMb = std::stod(args[++i]);
+        }
+        else if (args[i] == "-o" && i + 1 < args.size()) {
+            outputFile = args[++i];
+        }
+        else {
+            printUsage();
+            return args[i] == "-h" || args[i] == "--help" ? 0 : 1;
+        }
+    }
+
+    std::string tempFile = "/tmp/pacman-bench-" + std::to_string(getpid()) + ".board";
+    std::vector<Result> results;
+
+    try {
+        for (int size : sizes) {
+            for (int ghostCount : ghostCounts) {
+                if (size < 3 || ghostCount < 1) {
+                    results.push_back(Result{"*", size, ghostCount, 0, 0.0, 0, true, "invalid configuration"});
+                    continue;
+                }
+                if (static_cast<long long>(size) * size > maxCells) {
+                    results.push_back(Result{"*", size, ghostCount, 0, 0.0, 0, true, "over --max-cells"});
+                    continue;
+                }
+                std::cerr << "size " << size << ", ghosts " << ghostCount << "..." << std::endl;
+                runCase(size, ghostCount, budgetMs, ops, static_cast<size_t>(maxPlanesMb * 1024 * 1024),
+                        tempFile, results);
+            }
+        }
+    } catch (const std::exception& e) {
+        std::remove(tempFile.c_str());
+        std::cerr << "Error: " << e.what() << std::endl;
+        return -1;
+    }
+
+    if (outputFile.empty()) {
+        writeJson(std::cout, results, budgetMs);
+    } else {
+        std::ofstream out(outputFile);
+        if (!out.is_open()) {
+            std::cerr << "Error: could not write " << outputFile << std::endl;
+            return -1;
+        }
+        writeJson(out, results, budgetMs);
+    }
+
+    // Fail the run if a steady-state operation started allocating
+    int regressions = 0;
+    for (const Result& r : results) {
+        if (!r.skipped && r.allocations > 0 && mustNotAllocate(r.op)) {
+            std::cerr << "Allocation regression: " << r.op << " (size " << r.size << ", ghosts " << r.ghosts
+                      << ") made " << r.allocations << " allocations in " << r.iterations << " calls" << std::endl;
+            regressions++;
+        }
+    }
+    return regressions > 0 ? 2 : 0;
+}
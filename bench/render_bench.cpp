@@ -0,0 +1,137 @@
+// render_bench.cpp
+// Headless render benchmark: draws GameView frames into a FramebufferRenderer
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include "../Board.h"
+#include "../game_view.h"
+#include "../framebuffer_renderer.h"
+#include "../alloc_counter.h"
+
+void printUsage() {
+    std::cout << "Usage: pacman-render-bench [-s size] [-i inputFile] [-n frames]" << std::endl;
+    std::cout << "                           [--state start|playing|paused|gameover|win]" << std::endl;
+    std::cout << "                           [--dump prefix] [--save file]" << std::endl;
+    std::cout << std::endl;
+    std::cout << "  -s [size]      -> Board size (default: 10)" << std::endl;
+    std::cout << "  -i [file]      -> Load board from file" << std::endl;
+    std::cout << "  -n [frames]    -> Number of frames to render (default: 300)" << std::endl;
+    std::cout << "  --state [name] -> Screen to render (default: playing)" << std::endl;
+    std::cout << "  --dump [prefix]-> Write every frame to <prefix>NNNNN.ppm" << std::endl;
+    std::cout << "  --save [file]  -> Write the last frame as PPM" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::string> args(argv, argv + argc);
+
+    int boardSize = 10;
+    int frames = 300;
+    std::string inputFile = "";
+    std::string stateName = "playing";
+    std::string dumpPrefix = "";
+    std::string saveFile = "";
+
+    for (size_t i = 1; i < args.size(); i++) {
+        if (args[i] == "-s" && i + 1 < args.size()) {
+            boardSize = std::stoi(args[++i]);
+        }
+        else if (args[i] == "-i" && i + 1 < args.size()) {
+            inputFile = args[++i];
+        }
+        else if (args[i] == "-n" && i + 1 < args.size()) {
+            frames = std::stoi(args[++i]);
+        }
+        else if (args[i] == "--state" && i + 1 < args.size()) {
+            stateName = args[++i];
+        }
+        else if (args[i] == "--dump" && i + 1 < args.size()) {
+            dumpPrefix = args[++i];
+        }
+        else if (args[i] == "--save" && i + 1 < args.size()) {
+            saveFile = args[++i];
+        }
+        else {
+            printUsage();
+            return args[i] == "-h" || args[i] == "--help" ? 0 : 1;
+        }
+    }
+
+    GameState gameState = GameState::PLAYING;
+    if (stateName == "start") gameState = GameState::START_SCREEN;
+    else if (stateName == "paused") gameState = GameState::PAUSED;
+    else if (stateName == "gameover") gameState = GameState::GAME_OVER;
+    else if (stateName == "win") gameState = GameState::YOU_WIN;
+
+    try {
+        Board* board = inputFile.empty() ? new Board(boardSize) : new Board(inputFile);
+        boardSize = board->getGridSize();
+
+        FramebufferRenderer renderer(GameView::windowWidth(boardSize), GameView::windowHeight(boardSize));
+        renderer.setFrameDump(dumpPrefix);
+        GameView view(renderer);
+        view.loadAssets();
+
+        ViewState state;
+        state.gameState = gameState;
+        state.board = board;
+        state.lastDirection = Direction::RIGHT;
+        state.lives = 3;
+        state.highScore = 0;
+        state.hasCherryOnBoard = boardSize > 1;
+        state.cherryRow = 1;
+        state.cherryCol = 1;
+
+        // An untimed warm-up frame sizes any reusable buffers; later frames must not allocate
+        if (frames > 0 && dumpPrefix.empty()) {
+            view.render(state);
+        }
+
+        AllocScope allocs;
+        auto start = std::chrono::steady_clock::now();
+        for (int f = 0; f < frames; f++) {
+            view.render(state);
+        }
+        auto end = std::chrono::steady_clock::now();
+        uint64_t frameAllocations = allocs.allocations();
+        double totalMs = std::chrono::duration<double, std::milli>(end - start).count();
+
+        if (!saveFile.empty() && !renderer.saveFrame(saveFile)) {
+            std::cerr << "Error: could not write " << saveFile << std::endl;
+        }
+
+        char checksum[32];
+        std::snprintf(checksum, sizeof(checksum), "%016llx",
+                      static_cast<unsigned long long>(renderer.checksum()));
+
+        std::cout << "{\"benchmark\": \"render\", \"backend\": \"framebuffer\""
+                  << ", \"state\": \"" << stateName << "\""
+                  << ", \"size\": " << boardSize
+                  << ", \"width\": " << renderer.getWidth()
+                  << ", \"height\": " << renderer.getHeight()
+                  << ", \"frames\": " << frames
+                  << ", \"total_ms\": " << totalMs
+                  << ", \"ms_per_frame\": " << (frames > 0 ? totalMs / frames : 0.0);
+        if (AllocCounter::isActive()) {
+            std::cout << ", \"allocs_per_frame\": "
+                      << (frames > 0 ? static_cast<double>(frameAllocations) / frames : 0.0);
+        }
+        std::cout << ", \"checksum\": \"" << checksum << "\"}" << std::endl;
+
+        delete board;
+
+        // Frame dumps write files, so only plain runs are held to zero allocations
+        if (frameAllocations > 0 && dumpPrefix.empty()) {
+            std::cerr << "Allocation regression: " << frameAllocations << " allocations in "
+                      << frames << " frames" << std::endl;
+            return 2;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
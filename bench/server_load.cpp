@@ -0,0 +1,313 @@
+// server_load.cpp
+// Load generator for pacman-server: opens many connections from one thread,
+// plays random games on each and reports moves per second and latency.
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/resource.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include "../game_protocol.h"
+#include "../Direction.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * One client connection and where its game is
+ */
+struct Client {
+    int fd;
+    std::vector<uint8_t> input;
+    std::vector<uint8_t> output;
+    size_t outputSent;
+    uint32_t lastTicks;      // Ticks reported by the previous STATE frame
+    long long movesLeft;     // Moves still to send before quitting
+    bool done;
+    Clock::time_point sentAt;
+};
+
+/**
+ * Totals over all clients
+ */
+struct LoadStats {
+    long long moves = 0;
+    long long games = 0;
+    long long frames = 0;
+    long long errors = 0;
+    std::vector<double> latenciesUs;   // Round trip of every request
+};
+
+int connectTo(const std::string& unixPath, int port) {
+    int fd;
+    int result;
+    if (port > 0) {
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address;
+        std::memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_port = htons(static_cast<uint16_t>(port));
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        result = connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+        int noDelay = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+    } else {
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un address;
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, unixPath.c_str(), sizeof(address.sun_path) - 1);
+        result = connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    }
+    if (fd < 0 || result != 0) {
+        std::string message = std::string("connect: ") + std::strerror(errno);
+        if (fd >= 0) {
+            close(fd);
+        }
+        throw std::runtime_error(message);
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    return fd;
+}
+
+void queueNewGame(Client& client, int size, int ghostCount) {
+    uint8_t frame[5];
+    frame[0] = static_cast<uint8_t>(Opcode::NEW_GAME);
+    WireFormat::putU16(frame + 1, static_cast<uint16_t>(size));
+    WireFormat::putU16(frame + 3, static_cast<uint16_t>(ghostCount));
+    client.output.insert(client.output.end(), frame, frame + 5);
+    client.lastTicks = 0;
+}
+
+void queueMoves(Client& client, int batch, std::mt19937& rng) {
+    int count = static_cast<int>(std::min<long long>(batch, client.movesLeft));
+    client.output.push_back(static_cast<uint8_t>(Opcode::MOVE));
+    client.output.push_back(static_cast<uint8_t>(count));
+    std::uniform_int_distribution<int> direction(0, 3);
+    for (int i = 0; i < count; i++) {
+        client.output.push_back(static_cast<uint8_t>(direction(rng)));
+    }
+}
+
+void printUsage() {
+    std::cout << "Usage: pacman-server-load [--unix path | --port n] [-c clients] [-n moves]" << std::endl;
+    std::cout << "                          [--batch k] [-s size] [--ghosts n] [--seed n]" << std::endl;
+    std::cout << std::endl;
+    std::cout << "  --unix [path]   -> Server Unix socket (default: pacman.sock)" << std::endl;
+    std::cout << "  --port [n]      -> Server TCP port on 127.0.0.1 instead" << std::endl;
+    std::cout << "  -c [clients]    -> Concurrent connections (default: 1000)" << std::endl;
+    std::cout << "  -n [moves]      -> Moves each client sends (default: 1000)" << std::endl;
+    std::cout << "  --batch [k]     -> Moves per MOVE frame, 1..255 (default: 16)" << std::endl;
+    std::cout << "  -s [size]       -> Board size (default: 10)" << std::endl;
+    std::cout << "  --ghosts [n]    -> Ghosts per board (default: 4)" << std::endl;
+    std::cout << "  --seed [n]      -> Random seed (default: 1)" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<std::string> args(argv, argv + argc);
+
+    std::string unixPath = "pacman.sock";
+    int port = 0;
+    int clientCount = 1000;
+    long long movesPerClient = 1000;
+    int batch = 16;
+    int boardSize = 10;
+    int ghostCount = 4;
+    unsigned seed = 1;
+
+    for (size_t i = 1; i < args.size(); i++) {
+        if (args[i] == "--unix" && i + 1 < args.size()) {
+            unixPath = args[++i];
+        }
+        else if (args[i] == "--port" && i + 1 < args.size()) {
+            port = std::stoi(args[++i]);
+        }
+        else if (args[i] == "-c" && i + 1 < args.size()) {
+            clientCount = std::stoi(args[++i]);
+        }
+        else if (args[i] == "-n" && i + 1 < args.size()) {
+            movesPerClient = std::stoll(args[++i]);
+        }
+        else if (args[i] == "--batch" && i + 1 < args.size()) {
+            batch = std::max(1, std::min(255, std::stoi(args[++i])));
+        }
+        else if (args[i] == "-s" && i + 1 < args.size()) {
+            boardSize = std::stoi(args[++i]);
+        }
+        else if (args[i] == "--ghosts" && i + 1 < args.size()) {
+            ghostCount = std::stoi(args[++i]);
+        }
+        else if (args[i] == "--seed" && i + 1 < args.size()) {
+            seed = static_cast<unsigned>(std::stoul(args[++i]));
+        }
+        else {
+            printUsage();
+            return args[i] == "-h" || args[i] == "--help" ? 0 : 1;
+        }
+    }
+
+    // Thousands of sockets need more than the usual 1024 descriptors
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+
+    std::mt19937 rng(seed);
+    std::vector<Client> clients(clientCount);
+    LoadStats stats;
+    stats.latenciesUs.reserve(static_cast<size_t>(clientCount) * (movesPerClient / batch + 2));
+
+    try {
+        auto connectStart = Clock::now();
+        for (Client& client : clients) {
+            client.fd = connectTo(unixPath, port);
+            client.outputSent = 0;
+            client.movesLeft = movesPerClient;
+            client.done = false;
+            queueNewGame(client, boardSize, ghostCount);
+            client.sentAt = Clock::now();
+        }
+        double connectMs = std::chrono::duration<double, std::milli>(Clock::now() - connectStart).count();
+
+        auto start = Clock::now();
+        std::vector<pollfd> fds(clients.size());
+        size_t running = clients.size();
+        uint8_t buffer[16384];
+        while (running > 0) {
+            for (size_t i = 0; i < clients.size(); i++) {
+                Client& client = clients[i];
+                short events = 0;
+                if (!client.done) {
+                    events = POLLIN;
+                    if (client.outputSent < client.output.size()) events |= POLLOUT;
+                }
+                fds[i] = pollfd{client.done ? -1 : client.fd, events, 0};
+            }
+            if (poll(fds.data(), fds.size(), 5000) <= 0) {
+                throw std::runtime_error("server stopped answering");
+            }
+
+            for (size_t i = 0; i < clients.size(); i++) {
+                Client& client = clients[i];
+                if (client.done || fds[i].revents == 0) {
+                    continue;
+                }
+                if (fds[i].revents & POLLOUT) {
+                    ssize_t sent = send(client.fd, client.output.data() + client.outputSent,
+                                        client.output.size() - client.outputSent, 0);
+                    if (sent > 0) {
+                        client.outputSent += static_cast<size_t>(sent);
+                        if (client.outputSent == client.output.size()) {
+                            client.output.clear();
+                            client.outputSent = 0;
+                        }
+                    }
+                }
+                if (!(fds[i].revents & (POLLIN | POLLHUP | POLLERR))) {
+                    continue;
+                }
+                ssize_t received = recv(client.fd, buffer, sizeof(buffer), 0);
+                if (received <= 0) {
+                    if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) continue;
+                    throw std::runtime_error("server closed a connection");
+                }
+                client.input.insert(client.input.end(), buffer, buffer + received);
+
+                size_t offset = 0;
+                while (true) {
+                    size_t length = WireFormat::replyLength(client.input.data() + offset,
+                                                            client.input.size() - offset);
+                    if (length == 0) break;
+                    const uint8_t* frame = client.input.data() + offset;
+                    offset += length;
+                    stats.frames++;
+                    stats.latenciesUs.push_back(
+                        std::chrono::duration<double, std::micro>(Clock::now() - client.sentAt).count());
+
+                    if (static_cast<Opcode>(frame[0]) != Opcode::STATE) {
+                        stats.errors++;
+                        client.done = true;
+                        break;
+                    }
+                    StateFrame state = StateFrame::decode(frame);
+                    stats.moves += state.ticks - client.lastTicks;
+                    client.lastTicks = state.ticks;
+
+                    if (client.movesLeft <= 0) {
+                        client.output.push_back(static_cast<uint8_t>(Opcode::QUIT));
+                        send(client.fd, client.output.data(), client.output.size(), 0);
+                        client.done = true;
+                    } else if (state.status != GameStatus::PLAYING) {
+                        stats.games++;
+                        queueNewGame(client, boardSize, ghostCount);
+                    } else {
+                        int count = static_cast<int>(std::min<long long>(batch, client.movesLeft));
+                        queueMoves(client, batch, rng);
+                        client.movesLeft -= count;
+                    }
+                    client.sentAt = Clock::now();
+                }
+                client.input.erase(client.input.begin(), client.input.begin() + static_cast<std::ptrdiff_t>(offset));
+                if (!client.done && client.outputSent < client.output.size()) {
+                    // Send the next request now rather than on the next poll
+                    ssize_t sent = send(client.fd, client.output.data() + client.outputSent,
+                                        client.output.size() - client.outputSent, 0);
+                    if (sent > 0) {
+                        client.outputSent += static_cast<size_t>(sent);
+                        if (client.outputSent == client.output.size()) {
+                            client.output.clear();
+                            client.outputSent = 0;
+                        }
+                    }
+                }
+                if (client.done) {
+                    close(client.fd);
+                    running--;
+                }
+            }
+        }
+        double totalMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        std::vector<double>& latencies = stats.latenciesUs;
+        std::sort(latencies.begin(), latencies.end());
+        auto percentile = [&](double p) {
+            return latencies.empty() ? 0.0 : latencies[static_cast<size_t>(p * (latencies.size() - 1))];
+        };
+
+        std::cout << "{\"benchmark\": \"server\""
+                  << ", \"transport\": \"" << (port > 0 ? "tcp" : "unix") << "\""
+                  << ", \"clients\": " << clientCount
+                  << ", \"batch\": " << batch
+                  << ", \"size\": " << boardSize
+                  << ", \"connect_ms\": " << connectMs
+                  << ", \"total_ms\": " << totalMs
+                  << ", \"frames\": " << stats.frames
+                  << ", \"moves\": " << stats.moves
+                  << ", \"games\": " << stats.games
+                  << ", \"errors\": " << stats.errors
+                  << ", \"moves_per_sec\": " << (totalMs > 0 ? stats.moves * 1000.0 / totalMs : 0.0)
+                  << ", \"frames_per_sec\": " << (totalMs > 0 ? stats.frames * 1000.0 / totalMs : 0.0)
+                  << ", \"latency_us_p50\": " << percentile(0.5)
+                  << ", \"latency_us_p99\": " << percentile(0.99) << "}" << std::endl;
+        return stats.errors > 0 ? 1 : 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return -1;
+    }
+}
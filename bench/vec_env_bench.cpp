@@ -0,0 +1,213 @@
+// vec_env_bench.cpp
+// Checks VecEnv against Board and compares their stepping throughput
+//
+// Parity: the first boards of a VecEnv are mirrored by real Board objects
+// fed the same actions; score, ticks, positions, dots and episode ends
+// must match on every step. Throughput: the same action stream is played
+// by a VecEnv and by one Board per environment.
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include "../Board.h"
+#include "../vec_env.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * Compare one mirrored board with its VecEnv slot after a step
+ * @return Empty if they match, otherwise what differs
+ */
+std::string compare(const VecEnv& env, int e, const Board& board) {
+    EnvDone done = static_cast<EnvDone>(env.getDones()[e]);
+    bool boardCaught = board.getIsGameOver();
+    bool boardCleared = !boardCaught && board.getDotsRemaining() == 0;
+    if ((done == EnvDone::CAUGHT) != boardCaught) return "caught";
+    if ((done == EnvDone::CLEARED) != boardCleared) return "cleared";
+    if (done != EnvDone::RUNNING) {
+        return env.getFinalScores()[e] == board.getScore() ? "" : "final score";
+    }
+
+    if (env.getScores()[e] != board.getScore()) return "score";
+    if (env.getTicks()[e] != board.getTickCount()) return "ticks";
+    if (env.getPacmanRow(e) != board.getPacman()->getRow() ||
+        env.getPacmanCol(e) != board.getPacman()->getCol()) return "pacman position";
+    const std::vector<Ghost*>& ghosts = board.getGhosts();
+    for (int g = 0; g < env.getGhostCount(); g++) {
+        if (env.getGhostRow(e, g) != ghosts[g]->getRow() || env.getGhostCol(e, g) != ghosts[g]->getCol()) {
+            return "ghost " + std::to_string(g) + " position";
+        }
+    }
+
+    // Cells the board shows as dots or as eaten must agree with the dot plane
+    const uint8_t* dots = env.getObservations() + env.observationSize() * e;
+    int size = env.getSize();
+    for (int cell = 0; cell < size * size; cell++) {
+        char ch = board.getGridChar(cell / size, cell % size);
+        if ((ch == '*' && dots[cell] != 1) || (ch == ' ' && dots[cell] != 0)) {
+            return "dot plane at cell " + std::to_string(cell);
+        }
+    }
+    return "";
+}
+
+void printUsage() {
+    std::cout << "Usage: pacman-vec-bench [-e envs] [-s size] [--ghosts n] [-n steps]" << std::endl;
+    std::cout << "                        [-t maxTicks] [--parity k] [--seed n]" << std::endl;
+    std::cout << std::endl;
+    std::cout << "  -e [envs]       -> Boards stepped together (default: 1024)" << std::endl;
+    std::cout << "  -s [size]       -> Board size (default: 10)" << std::endl;
+    std::cout << "  --ghosts [n]    -> Ghosts per board (default: 4)" << std::endl;
+    std::cout << "  -n [steps]      -> Steps to time (default: 1000)" << std::endl;
+    std::cout << "  -t [ticks]      -> Episode tick limit (default: 200)" << std::endl;
+    std::cout << "  --parity [k]    -> Boards mirrored by Board objects (default: 16)" << std::endl;
+    std::cout << "  --seed [n]      -> Random seed (default: 1)" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Exit status 1 if any mirrored board differs from its VecEnv slot." << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<std::string> args(argv, argv + argc);
+
+    int envCount = 1024;
+    int boardSize = 10;
+    int ghostCount = 4;
+    int steps = 1000;
+    int maxTicks = 200;
+    int parityCount = 16;
+    unsigned seed = 1;
+
+    for (size_t i = 1; i < args.size(); i++) {
+        if (args[i] == "-e" && i + 1 < args.size()) {
+            envCount = std::stoi(args[++i]);
+        }
+        else if (args[i] == "-s" && i + 1 < args.size()) {
+            boardSize = std::stoi(args[++i]);
+        }
+        else if (args[i] == "--ghosts" && i + 1 < args.size()) {
+            ghostCount = std::stoi(args[++i]);
+        }
+        else if (args[i] == "-n" && i + 1 < args.size()) {
+            steps = std::stoi(args[++i]);
+        }
+        else if (args[i] == "-t" && i + 1 < args.size()) {
+            maxTicks = std::stoi(args[++i]);
+        }
+        else if (args[i] == "--parity" && i + 1 < args.size()) {
+            parityCount = std::stoi(args[++i]);
+        }
+        else if (args[i] == "--seed" && i + 1 < args.size()) {
+            seed = static_cast<unsigned>(std::stoul(args[++i]));
+        }
+        else {
+            printUsage();
+            return args[i] == "-h" || args[i] == "--help" ? 0 : 1;
+        }
+    }
+    if (envCount < 1 || boardSize < 3 || ghostCount < 1 || steps < 1) {
+        printUsage();
+        return 1;
+    }
+    parityCount = std::max(0, std::min(parityCount, envCount));
+
+    // One action stream shared by every run
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> direction(0, 4);
+    std::vector<uint8_t> actions(static_cast<size_t>(steps) * envCount);
+    for (uint8_t& action : actions) {
+        action = static_cast<uint8_t>(direction(rng));
+    }
+
+    // Parity against Board
+    long long episodes = 0;
+    int failures = 0;
+    {
+        VecEnv env(envCount, boardSize, ghostCount, maxTicks);
+        std::vector<Board*> boards;
+        for (int e = 0; e < parityCount; e++) {
+            boards.push_back(new Board(boardSize, ghostCount));
+        }
+        for (int s = 0; s < steps && failures < 10; s++) {
+            const uint8_t* stepActions = &actions[static_cast<size_t>(s) * envCount];
+            env.step(stepActions);
+            for (int e = 0; e < parityCount; e++) {
+                boards[e]->move(static_cast<Direction>(stepActions[e]));
+                std::string mismatch = compare(env, e, *boards[e]);
+                if (!mismatch.empty()) {
+                    std::cerr << "Parity mismatch: env " << e << ", step " << s << ": " << mismatch << std::endl;
+                    failures++;
+                }
+                if (env.getDones()[e] != static_cast<uint8_t>(EnvDone::RUNNING)) {
+                    delete boards[e];
+                    boards[e] = new Board(boardSize, ghostCount);
+                }
+            }
+        }
+        for (Board* board : boards) {
+            delete board;
+        }
+    }
+
+    // VecEnv throughput
+    double vecMs;
+    {
+        VecEnv env(envCount, boardSize, ghostCount, maxTicks);
+        auto start = Clock::now();
+        for (int s = 0; s < steps; s++) {
+            env.step(&actions[static_cast<size_t>(s) * envCount]);
+            for (int e = 0; e < envCount; e++) {
+                episodes += env.getDones()[e] != 0;
+            }
+        }
+        vecMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    // One Board per environment, same rules for ending episodes
+    double boardMs;
+    {
+        std::vector<Board*> boards;
+        for (int e = 0; e < envCount; e++) {
+            boards.push_back(new Board(boardSize, ghostCount));
+        }
+        auto start = Clock::now();
+        for (int s = 0; s < steps; s++) {
+            const uint8_t* stepActions = &actions[static_cast<size_t>(s) * envCount];
+            for (int e = 0; e < envCount; e++) {
+                Board*& board = boards[e];
+                board->move(static_cast<Direction>(stepActions[e]));
+                if (board->getIsGameOver() || board->getDotsRemaining() == 0 ||
+                    (maxTicks > 0 && board->getTickCount() >= maxTicks)) {
+                    delete board;
+                    board = new Board(boardSize, ghostCount);
+                }
+            }
+        }
+        boardMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        for (Board* board : boards) {
+            delete board;
+        }
+    }
+
+    double envSteps = static_cast<double>(steps) * envCount;
+    std::cout << "{\"benchmark\": \"vec_env\""
+              << ", \"envs\": " << envCount
+              << ", \"size\": " << boardSize
+              << ", \"ghosts\": " << ghostCount
+              << ", \"steps\": " << steps
+              << ", \"episodes\": " << episodes
+              << ", \"vec_ms\": " << vecMs
+              << ", \"board_ms\": " << boardMs
+              << ", \"vec_steps_per_sec\": " << (vecMs > 0 ? envSteps * 1000.0 / vecMs : 0.0)
+              << ", \"board_steps_per_sec\": " << (boardMs > 0 ? envSteps * 1000.0 / boardMs : 0.0)
+              << ", \"speedup\": " << (vecMs > 0 ? boardMs / vecMs : 0.0)
+              << ", \"parity_envs\": " << parityCount
+              << ", \"parity_failures\": " << failures << "}" << std::endl;
+    return failures > 0 ? 1 : 0;
+}
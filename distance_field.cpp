@@ -0,0 +1,83 @@
+// distance_field.cpp
+
+#include "distance_field.h"
+#include "trace.h"
+#include <algorithm>
+#include <cstdlib>
+
+/**
+ * Constructor
+ */
+DistanceField::DistanceField(const NavGraph& graph, int size)
+    : graph(graph), size(size), source(-1), open(graph.getWallCount() == 0), base(1), head(0), tail(0) {
+    if (!open) {
+        size_t cells = static_cast<size_t>(size) * size;
+        marks.assign(cells, 0);
+        queue.assign(cells, 0);
+    }
+}
+
+void DistanceField::setSource(int cell) {
+    if (cell == source) {
+        return;
+    }
+    if (open) {
+        source = cell;
+        return;
+    }
+    PAC_TRACE_SCOPE("DistanceField::setSource");
+
+    // Move base past every mark of the last search (the last cell queued
+    // is the farthest), or clear the marks when base would overflow
+    uint32_t farthest = tail > 0 ? marks[queue[tail - 1]] - base : 0;
+    if (base > UINT32_MAX - 2 - farthest - marks.size()) {
+        std::fill(marks.begin(), marks.end(), 0);
+        base = 1;
+    } else {
+        base += farthest + 1;
+    }
+
+    source = cell;
+    marks[cell] = base;
+    queue[0] = cell;
+    head = 0;
+    tail = 1;
+}
+
+uint32_t DistanceField::distanceTo(int cell) {
+    if (open) {
+        return static_cast<uint32_t>(std::abs(cell / size - source / size) + std::abs(cell % size - source % size));
+    }
+    while (marks[cell] < base && head < tail) {
+        expand();
+    }
+    return marks[cell] >= base ? marks[cell] - base : UNREACHABLE;
+}
+
+int DistanceField::getSource() const {
+    return source;
+}
+
+size_t DistanceField::memoryUsage() const {
+    return marks.capacity() * sizeof(uint32_t) + queue.capacity() * sizeof(int32_t);
+}
+
+void DistanceField::expand() {
+    int cell = queue[head++];
+    uint8_t mask = graph.getMask(cell);
+    uint32_t next = marks[cell] + 1;
+
+    // Neighbours in Direction order: up, down, left, right
+    const int neighbours[4] = {
+        mask & 1 ? cell - size : -1,
+        mask & 2 ? cell + size : -1,
+        mask & 4 ? cell - 1 : -1,
+        mask & 8 ? cell + 1 : -1
+    };
+    for (int neighbour : neighbours) {
+        if (neighbour >= 0 && marks[neighbour] < base) {
+            marks[neighbour] = next;
+            queue[tail++] = neighbour;
+        }
+    }
+}
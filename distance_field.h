@@ -0,0 +1,78 @@
+// distance_field.h
+
+#ifndef DISTANCE_FIELD_H
+#define DISTANCE_FIELD_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "nav_graph.h"
+
+/**
+ * DistanceField class - breadth-first distances from one source cell
+ * Moves follow the board's NavGraph (cell = row * size + col). Shared by
+ * every ghost in a tick: the search runs lazily, only as far as the
+ * farthest cell asked for, and is kept while the source stays put. On a
+ * board without walls the distance is the Manhattan distance and no
+ * search runs. Nothing is allocated after construction.
+ */
+class DistanceField {
+public:
+    static const uint32_t UNREACHABLE = UINT32_MAX;
+
+    /**
+     * Constructor
+     * @param graph The moves of the board (must outlive the field)
+     * @param size The size of the square board
+     */
+    DistanceField(const NavGraph& graph, int size);
+
+    /**
+     * Measure distances from a cell
+     * Starts a new search unless the cell is already the source.
+     * @param cell The source cell
+     */
+    void setSource(int cell);
+
+    /**
+     * Get the number of steps from the source to a cell
+     * Extends the search until the cell has been reached.
+     * @param cell The cell to measure
+     * @return Steps, or UNREACHABLE
+     */
+    uint32_t distanceTo(int cell);
+
+    /**
+     * Get the source cell (-1 before the first setSource)
+     */
+    int getSource() const;
+
+    /**
+     * Get the heap bytes this field owns (none without walls)
+     */
+    size_t memoryUsage() const;
+
+private:
+    const NavGraph& graph;
+    int size;
+    int source;
+    bool open;                       // No walls: Manhattan distances
+
+    // A cell is reached in the current search when marks[cell] >= base;
+    // its distance is then marks[cell] - base. Starting a search only
+    // moves base past the old marks instead of clearing them.
+    std::vector<uint32_t> marks;
+    uint32_t base;
+
+    // Breadth-first queue; cells before head have been expanded
+    std::vector<int32_t> queue;
+    size_t head;
+    size_t tail;
+
+    /**
+     * Expand the next queued cell
+     */
+    void expand();
+};
+
+#endif // DISTANCE_FIELD_H
@@ -0,0 +1,165 @@
+// distance_table.cpp
+
+#include "distance_table.h"
+#include "thread_pool.h"
+#include "trace.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+const char CACHE_MAGIC[8] = {'P', 'A', 'C', 'A', 'P', 'S', 'P', '1'};
+
+// Boards with fewer cells are searched on the calling thread: starting
+// the workers costs more than the searches
+const size_t PARALLEL_CELLS = 1024;
+
+// Source chunks per worker, so uneven searches still share out evenly
+const int CHUNKS_PER_WORKER = 4;
+
+} // namespace
+
+const uint16_t DistanceTable::UNREACHABLE;
+const size_t DistanceTable::DEFAULT_BUDGET;
+
+/**
+ * Constructor
+ */
+DistanceTable::DistanceTable(const NavGraph& graph, int size, const std::string& cacheFile)
+    : cells(static_cast<size_t>(size) * size), buildMs(0.0), fromCache(false) {
+    PAC_TRACE_SCOPE("DistanceTable::build");
+    auto start = std::chrono::steady_clock::now();
+    table.assign(cells * cells, UNREACHABLE);
+
+    uint64_t layout = cacheFile.empty() ? 0 : layoutHash(graph, size);
+    fromCache = !cacheFile.empty() && load(cacheFile, layout);
+    if (!fromCache) {
+        build(graph, size);
+        if (!cacheFile.empty() && !save(cacheFile, layout)) {
+            std::cerr << "Warning: could not write distance table to " << cacheFile << std::endl;
+        }
+    }
+    buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+double DistanceTable::getBuildMs() const {
+    return buildMs;
+}
+
+bool DistanceTable::isFromCache() const {
+    return fromCache;
+}
+
+size_t DistanceTable::memoryUsage() const {
+    return table.capacity() * sizeof(uint16_t);
+}
+
+size_t DistanceTable::estimateMemory(int size) {
+    size_t cells = static_cast<size_t>(size) * size;
+    return cells * cells * sizeof(uint16_t);
+}
+
+bool DistanceTable::fits(int size, size_t budgetBytes) {
+    size_t cells = static_cast<size_t>(size) * size;
+    return size > 0 && cells < UNREACHABLE && estimateMemory(size) <= budgetBytes;
+}
+
+/**
+ * Rows are independent, so workers take contiguous runs of sources and
+ * write their own rows; each keeps its own queue
+ */
+void DistanceTable::build(const NavGraph& graph, int size) {
+    auto searchRange = [&](size_t first, size_t last) {
+        std::vector<int32_t> queue(cells);
+        for (size_t from = first; from < last; from++) {
+            search(graph, size, static_cast<int>(from), queue);
+        }
+    };
+
+    unsigned threads = ThreadPool::defaultThreadCount();
+    if (cells < PARALLEL_CELLS || threads < 2) {
+        searchRange(0, cells);
+        return;
+    }
+    ThreadPool pool(threads);
+    int chunks = static_cast<int>(threads) * CHUNKS_PER_WORKER;
+    pool.parallelFor(chunks, [&](int chunk) {
+        searchRange(cells * chunk / chunks, cells * (chunk + 1) / chunks);
+    });
+}
+
+void DistanceTable::search(const NavGraph& graph, int size, int from, std::vector<int32_t>& queue) {
+    uint16_t* row = &table[static_cast<size_t>(from) * cells];
+    row[from] = 0;
+    queue[0] = from;
+    size_t head = 0;
+    size_t tail = 1;
+    while (head < tail) {
+        int cell = queue[head++];
+        uint8_t mask = graph.getMask(cell);
+        uint16_t next = static_cast<uint16_t>(row[cell] + 1);
+
+        // Neighbours in Direction order: up, down, left, right
+        const int neighbours[4] = {
+            mask & 1 ? cell - size : -1,
+            mask & 2 ? cell + size : -1,
+            mask & 4 ? cell - 1 : -1,
+            mask & 8 ? cell + 1 : -1
+        };
+        for (int neighbour : neighbours) {
+            if (neighbour >= 0 && row[neighbour] == UNREACHABLE) {
+                row[neighbour] = next;
+                queue[tail++] = neighbour;
+            }
+        }
+    }
+}
+
+bool DistanceTable::load(const std::string& fileName, uint64_t layout) {
+    std::ifstream file(fileName, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    char magic[sizeof(CACHE_MAGIC)];
+    uint64_t cellCount = 0;
+    uint64_t fileLayout = 0;
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&cellCount), sizeof(cellCount));
+    file.read(reinterpret_cast<char*>(&fileLayout), sizeof(fileLayout));
+    if (!file || std::memcmp(magic, CACHE_MAGIC, sizeof(magic)) != 0 ||
+        cellCount != cells || fileLayout != layout) {
+        return false;
+    }
+    file.read(reinterpret_cast<char*>(table.data()), static_cast<std::streamsize>(table.size() * sizeof(uint16_t)));
+    if (!file) {
+        std::fill(table.begin(), table.end(), UNREACHABLE);
+        return false;
+    }
+    return true;
+}
+
+bool DistanceTable::save(const std::string& fileName, uint64_t layout) const {
+    std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+    uint64_t cellCount = cells;
+    file.write(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    file.write(reinterpret_cast<const char*>(&cellCount), sizeof(cellCount));
+    file.write(reinterpret_cast<const char*>(&layout), sizeof(layout));
+    file.write(reinterpret_cast<const char*>(table.data()), static_cast<std::streamsize>(table.size() * sizeof(uint16_t)));
+    return static_cast<bool>(file);
+}
+
+uint64_t DistanceTable::layoutHash(const NavGraph& graph, int size) {
+    uint64_t hash = 14695981039346656037ULL;
+    size_t cellCount = static_cast<size_t>(size) * size;
+    for (size_t cell = 0; cell < cellCount; cell++) {
+        hash ^= graph.getMask(static_cast<int>(cell));
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
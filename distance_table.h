@@ -0,0 +1,109 @@
+// distance_table.h
+
+#ifndef DISTANCE_TABLE_H
+#define DISTANCE_TABLE_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include "nav_graph.h"
+
+/**
+ * DistanceTable class - shortest path lengths between every pair of cells
+ * One breadth-first search per open cell over the board's NavGraph, run
+ * across a thread pool when the board is large enough to pay for it.
+ * Distances are 16-bit, row after row (from * cells + to), so a 64x64
+ * board takes 32 MB; fits() tells whether a board stays within a budget.
+ *
+ * The table can be cached in a file: it is kept there with the board size
+ * and a hash of its walls, and only read back when both still match.
+ */
+class DistanceTable {
+public:
+    static const uint16_t UNREACHABLE = UINT16_MAX;
+
+    // Default memory budget: enough for a 64x64 board
+    static const size_t DEFAULT_BUDGET = 32u * 1024 * 1024;
+
+    /**
+     * Constructor - reads the cache file if it matches, otherwise builds
+     * the table and (if a cache file is given) writes it
+     * @param graph The moves of the board
+     * @param size The size of the square board
+     * @param cacheFile File to read or write, or empty for no caching
+     */
+    DistanceTable(const NavGraph& graph, int size, const std::string& cacheFile = "");
+
+    /**
+     * Get the number of steps between two cells
+     * @return Steps, or UNREACHABLE (walls are unreachable from every
+     *         other cell)
+     */
+    uint16_t distance(int from, int to) const {
+        return table[static_cast<size_t>(from) * cells + to];
+    }
+
+    /**
+     * Get the milliseconds spent building or reading the table
+     */
+    double getBuildMs() const;
+
+    /**
+     * Check if the table was read from the cache file
+     */
+    bool isFromCache() const;
+
+    /**
+     * Get the heap bytes this table owns
+     */
+    size_t memoryUsage() const;
+
+    /**
+     * Predict memoryUsage() for a board
+     */
+    static size_t estimateMemory(int size);
+
+    /**
+     * Check if a board's table stays within a budget
+     * Boards with 65535 or more cells never fit: their distances may not
+     * fit in 16 bits.
+     */
+    static bool fits(int size, size_t budgetBytes);
+
+private:
+    size_t cells;
+    std::vector<uint16_t> table;
+    double buildMs;
+    bool fromCache;
+
+    /**
+     * Fill the table, one search per open cell
+     */
+    void build(const NavGraph& graph, int size);
+
+    /**
+     * Search from one cell, filling its row
+     * @param queue Scratch of at least cells entries
+     */
+    void search(const NavGraph& graph, int size, int from, std::vector<int32_t>& queue);
+
+    /**
+     * Read the table from a cache file
+     * @return false if the file is missing or made for other walls
+     */
+    bool load(const std::string& fileName, uint64_t layout);
+
+    /**
+     * Write the table to a cache file
+     * @return false if the file could not be written
+     */
+    bool save(const std::string& fileName, uint64_t layout) const;
+
+    /**
+     * Hash the moves of every cell (FNV-1a), to tell boards apart
+     */
+    static uint64_t layoutHash(const NavGraph& graph, int size);
+};
+
+#endif // DISTANCE_TABLE_H
@@ -0,0 +1,433 @@
+// framebuffer_renderer.cpp
+
+#include "framebuffer_renderer.h"
+#include <png.h>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+namespace {
+
+// 5x7 bitmap font for ' ' .. 'Z' (bit 4 is the leftmost column)
+const uint8_t FONT_5X7[][7] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // ' '
+    {0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x04}, // '!'
+    {0x0A, 0x0A, 0x00, 0x00, 0x00, 0x00, 0x00}, // '"'
+    {0x0A, 0x0A, 0x1F, 0x0A, 0x1F, 0x0A, 0x0A}, // '#'
+    {0x04, 0x0F, 0x14, 0x0E, 0x05, 0x1E, 0x04}, // '$'
+    {0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03}, // '%'
+    {0x0C, 0x12, 0x14, 0x08, 0x15, 0x12, 0x0D}, // '&'
+    {0x04, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00}, // '''
+    {0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02}, // '('
+    {0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08}, // ')'
+    {0x00, 0x04, 0x15, 0x0E, 0x15, 0x04, 0x00}, // '*'
+    {0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00}, // '+'
+    {0x00, 0x00, 0x00, 0x00, 0x0C, 0x04, 0x08}, // ','
+    {0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00}, // '-'
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C}, // '.'
+    {0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00}, // '/'
+    {0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E}, // '0'
+    {0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E}, // '1'
+    {0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F}, // '2'
+    {0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E}, // '3'
+    {0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02}, // '4'
+    {0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E}, // '5'
+    {0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E}, // '6'
+    {0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08}, // '7'
+    {0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E}, // '8'
+    {0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C}, // '9'
+    {0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00}, // ':'
+    {0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x04, 0x08}, // ';'
+    {0x02, 0x04, 0x08, 0x10, 0x08, 0x04, 0x02}, // '<'
+    {0x00, 0x00, 0x1F, 0x00, 0x1F, 0x00, 0x00}, // '='
+    {0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08}, // '>'
+    {0x0E, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04}, // '?'
+    {0x0E, 0x11, 0x01, 0x0D, 0x15, 0x15, 0x0E}, // '@'
+    {0x0E, 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11}, // 'A'
+    {0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E}, // 'B'
+    {0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E}, // 'C'
+    {0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C}, // 'D'
+    {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F}, // 'E'
+    {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10}, // 'F'
+    {0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F}, // 'G'
+    {0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11}, // 'H'
+    {0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E}, // 'I'
+    {0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C}, // 'J'
+    {0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11}, // 'K'
+    {0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F}, // 'L'
+    {0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11}, // 'M'
+    {0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11}, // 'N'
+    {0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E}, // 'O'
+    {0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10}, // 'P'
+    {0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D}, // 'Q'
+    {0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11}, // 'R'
+    {0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E}, // 'S'
+    {0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04}, // 'T'
+    {0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E}, // 'U'
+    {0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04}, // 'V'
+    {0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A}, // 'W'
+    {0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11}, // 'X'
+    {0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04}, // 'Y'
+    {0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F}, // 'Z'
+};
+
+const uint8_t GLYPH_BAR[7] = {0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04}; // '|'
+
+const int GLYPH_WIDTH = 5;
+const int GLYPH_HEIGHT = 7;
+const int GLYPH_ADVANCE = 6;
+
+/**
+ * Look up the bitmap for a character (lowercase shares the uppercase glyph)
+ * @return nullptr if the font has no glyph for the character
+ */
+const uint8_t* findGlyph(char ch) {
+    if (ch >= 'a' && ch <= 'z') {
+        ch = static_cast<char>(ch - 'a' + 'A');
+    }
+    if (ch == '|') {
+        return GLYPH_BAR;
+    }
+    if (ch >= ' ' && ch <= 'Z') {
+        return FONT_5X7[ch - ' '];
+    }
+    return nullptr;
+}
+
+/**
+ * Pixel scale of the bitmap font for a character size
+ */
+int glyphScale(unsigned size) {
+    int scale = static_cast<int>(size) / 10;
+    return scale < 1 ? 1 : scale;
+}
+
+} // namespace
+
+/**
+ * Constructor
+ */
+FramebufferRenderer::FramebufferRenderer(unsigned width, unsigned height)
+    : width(width),
+      height(height),
+      pixels(static_cast<size_t>(width) * height * 4, 0),
+      frameCount(0) {}
+
+/**
+ * Destructor
+ */
+FramebufferRenderer::~FramebufferRenderer() {}
+
+/**
+ * Decode PNG images into RGBA textures, one image per pool task
+ */
+std::vector<bool> FramebufferRenderer::loadTextures(const std::vector<TextureData>& images, ThreadPool& pool) {
+    std::vector<Image> decodedImages(images.size());
+    std::vector<char> decoded(images.size(), 0);
+
+    pool.parallelFor(static_cast<int>(images.size()), [&](int i) {
+        decoded[i] = decodePng(images[i].data, images[i].size, decodedImages[i]);
+    });
+
+    std::vector<bool> loaded(images.size(), false);
+    for (size_t i = 0; i < images.size(); i++) {
+        if (decoded[i]) {
+            textures[images[i].name] = std::move(decodedImages[i]);
+            loaded[i] = true;
+        }
+    }
+    return loaded;
+}
+
+/**
+ * Decode one in-memory PNG with libpng's simplified API
+ */
+bool FramebufferRenderer::decodePng(const unsigned char* data, size_t size, Image& image) {
+    png_image png;
+    std::memset(&png, 0, sizeof(png));
+    png.version = PNG_IMAGE_VERSION;
+
+    if (!png_image_begin_read_from_memory(&png, data, size)) {
+        return false;
+    }
+    png.format = PNG_FORMAT_RGBA;
+
+    image.width = png.width;
+    image.height = png.height;
+    image.pixels.resize(PNG_IMAGE_SIZE(png));
+    if (!png_image_finish_read(&png, nullptr, image.pixels.data(), 0, nullptr)) {
+        png_image_free(&png);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Text uses the built-in bitmap font, so any font is accepted
+ */
+bool FramebufferRenderer::loadFont([[maybe_unused]] const unsigned char* data, [[maybe_unused]] size_t size) {
+    return true;
+}
+
+bool FramebufferRenderer::hasTexture(const std::string& name) const {
+    return textures.count(name) > 0;
+}
+
+bool FramebufferRenderer::getTextureSize(const std::string& name, unsigned& width, unsigned& height) const {
+    auto it = textures.find(name);
+    if (it == textures.end()) {
+        return false;
+    }
+    width = it->second.width;
+    height = it->second.height;
+    return true;
+}
+
+unsigned FramebufferRenderer::getWidth() const {
+    return width;
+}
+
+unsigned FramebufferRenderer::getHeight() const {
+    return height;
+}
+
+/**
+ * Fill the whole surface with one color
+ */
+void FramebufferRenderer::clear(RenderColor color) {
+    for (size_t i = 0; i < pixels.size(); i += 4) {
+        pixels[i] = color.r;
+        pixels[i + 1] = color.g;
+        pixels[i + 2] = color.b;
+        pixels[i + 3] = color.a;
+    }
+}
+
+/**
+ * Draw a texture with nearest-neighbour sampling, rotated around its center
+ */
+void FramebufferRenderer::drawTexture(const std::string& name, float x, float y,
+                                      float width, float height, float rotation) {
+    auto it = textures.find(name);
+    if (it == textures.end() || width <= 0 || height <= 0) {
+        return;
+    }
+    const Image& image = it->second;
+
+    float centerX = x + width / 2.0f;
+    float centerY = y + height / 2.0f;
+    float radians = rotation * 3.14159265f / 180.0f;
+    float cosA = std::cos(radians);
+    float sinA = std::sin(radians);
+
+    // Bounding box of the rotated rectangle
+    float halfW = (std::fabs(width * cosA) + std::fabs(height * sinA)) / 2.0f;
+    float halfH = (std::fabs(width * sinA) + std::fabs(height * cosA)) / 2.0f;
+    int minX = static_cast<int>(std::floor(centerX - halfW));
+    int maxX = static_cast<int>(std::ceil(centerX + halfW));
+    int minY = static_cast<int>(std::floor(centerY - halfH));
+    int maxY = static_cast<int>(std::ceil(centerY + halfH));
+
+    for (int py = minY; py < maxY; py++) {
+        for (int px = minX; px < maxX; px++) {
+            // Inverse-rotate the pixel center into the unrotated rectangle
+            float dx = px + 0.5f - centerX;
+            float dy = py + 0.5f - centerY;
+            float localX = dx * cosA + dy * sinA + width / 2.0f;
+            float localY = -dx * sinA + dy * cosA + height / 2.0f;
+            if (localX < 0 || localY < 0 || localX >= width || localY >= height) {
+                continue;
+            }
+
+            unsigned u = static_cast<unsigned>(localX / width * image.width);
+            unsigned v = static_cast<unsigned>(localY / height * image.height);
+            if (u >= image.width) u = image.width - 1;
+            if (v >= image.height) v = image.height - 1;
+
+            const uint8_t* src = &image.pixels[(static_cast<size_t>(v) * image.width + u) * 4];
+            blendPixel(px, py, src[0], src[1], src[2], src[3]);
+        }
+    }
+}
+
+/**
+ * Draw a filled rectangle
+ */
+void FramebufferRenderer::drawRect(float x, float y, float width, float height, RenderColor color) {
+    int minX = static_cast<int>(std::lround(x));
+    int minY = static_cast<int>(std::lround(y));
+    int maxX = static_cast<int>(std::lround(x + width));
+    int maxY = static_cast<int>(std::lround(y + height));
+
+    for (int py = minY; py < maxY; py++) {
+        for (int px = minX; px < maxX; px++) {
+            blendPixel(px, py, color.r, color.g, color.b, color.a);
+        }
+    }
+}
+
+/**
+ * Draw a filled circle
+ */
+void FramebufferRenderer::drawCircle(float x, float y, float radius, RenderColor color) {
+    float centerX = x + radius;
+    float centerY = y + radius;
+    int minX = static_cast<int>(std::floor(x));
+    int minY = static_cast<int>(std::floor(y));
+    int maxX = static_cast<int>(std::ceil(x + 2 * radius));
+    int maxY = static_cast<int>(std::ceil(y + 2 * radius));
+
+    for (int py = minY; py < maxY; py++) {
+        for (int px = minX; px < maxX; px++) {
+            float dx = px + 0.5f - centerX;
+            float dy = py + 0.5f - centerY;
+            if (dx * dx + dy * dy <= radius * radius) {
+                blendPixel(px, py, color.r, color.g, color.b, color.a);
+            }
+        }
+    }
+}
+
+/**
+ * Draw text with the built-in bitmap font
+ */
+void FramebufferRenderer::drawText(std::string_view text, unsigned size, RenderColor color,
+                                   float x, float y, TextAlign align, bool bold) {
+    int scale = glyphScale(size);
+    int left = static_cast<int>(std::lround(x));
+    int top = static_cast<int>(std::lround(y));
+
+    if (align == TextAlign::CENTER) {
+        int textWidth = static_cast<int>(text.size()) * GLYPH_ADVANCE * scale - scale;
+        left -= textWidth / 2;
+        top -= GLYPH_HEIGHT * scale / 2;
+    }
+
+    for (size_t i = 0; i < text.size(); i++) {
+        int glyphX = left + static_cast<int>(i) * GLYPH_ADVANCE * scale;
+        drawGlyph(text[i], glyphX, top, scale, color);
+        if (bold) {
+            drawGlyph(text[i], glyphX + 1, top, scale, color);
+        }
+    }
+}
+
+/**
+ * Finish a frame, dumping it to disk if requested
+ */
+void FramebufferRenderer::display() {
+    if (!dumpPrefix.empty()) {
+        char number[16];
+        std::snprintf(number, sizeof(number), "%05d", frameCount);
+        saveFrame(dumpPrefix + number + ".ppm");
+    }
+    frameCount++;
+}
+
+/**
+ * Text is drawn straight from the built-in font, so nothing is cached for it
+ */
+RendererMemory FramebufferRenderer::memoryUsage() const {
+    RendererMemory memory{0, 0, 0};
+    for (const auto& entry : textures) {
+        memory.textures += sizeof(entry) + entry.first.capacity() + entry.second.pixels.capacity();
+    }
+    memory.surface = pixels.capacity();
+    return memory;
+}
+
+void FramebufferRenderer::setFrameDump(const std::string& prefix) {
+    dumpPrefix = prefix;
+}
+
+/**
+ * Save the surface as a binary PPM (alpha is dropped)
+ */
+bool FramebufferRenderer::saveFrame(const std::string& fileName) const {
+    std::ofstream file(fileName, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    file << "P6\n" << width << " " << height << "\n255\n";
+    std::vector<char> row(static_cast<size_t>(width) * 3);
+    for (unsigned py = 0; py < height; py++) {
+        for (unsigned px = 0; px < width; px++) {
+            const uint8_t* src = &pixels[(static_cast<size_t>(py) * width + px) * 4];
+            row[px * 3] = static_cast<char>(src[0]);
+            row[px * 3 + 1] = static_cast<char>(src[1]);
+            row[px * 3 + 2] = static_cast<char>(src[2]);
+        }
+        file.write(row.data(), row.size());
+    }
+    return file.good();
+}
+
+/**
+ * FNV-1a hash over all surface bytes
+ */
+uint64_t FramebufferRenderer::checksum() const {
+    uint64_t hash = 14695981039346656037ULL;
+    for (uint8_t byte : pixels) {
+        hash ^= byte;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+const std::vector<uint8_t>& FramebufferRenderer::getPixels() const {
+    return pixels;
+}
+
+int FramebufferRenderer::getFrameCount() const {
+    return frameCount;
+}
+
+/**
+ * Source-over blend of one pixel, clipped to the surface
+ */
+void FramebufferRenderer::blendPixel(int px, int py, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    if (px < 0 || py < 0 || px >= static_cast<int>(width) || py >= static_cast<int>(height) || a == 0) {
+        return;
+    }
+
+    uint8_t* dst = &pixels[(static_cast<size_t>(py) * width + px) * 4];
+    if (a == 255) {
+        dst[0] = r;
+        dst[1] = g;
+        dst[2] = b;
+        dst[3] = 255;
+        return;
+    }
+
+    unsigned inv = 255 - a;
+    dst[0] = static_cast<uint8_t>((r * a + dst[0] * inv) / 255);
+    dst[1] = static_cast<uint8_t>((g * a + dst[1] * inv) / 255);
+    dst[2] = static_cast<uint8_t>((b * a + dst[2] * inv) / 255);
+    dst[3] = static_cast<uint8_t>(a + dst[3] * inv / 255);
+}
+
+/**
+ * Draw one glyph, each font pixel becoming a scale x scale block
+ */
+void FramebufferRenderer::drawGlyph(char ch, int x, int y, int scale, RenderColor color) {
+    const uint8_t* glyph = findGlyph(ch);
+    if (glyph == nullptr) {
+        return;
+    }
+
+    for (int row = 0; row < GLYPH_HEIGHT; row++) {
+        for (int col = 0; col < GLYPH_WIDTH; col++) {
+            if (!(glyph[row] & (0x10 >> col))) {
+                continue;
+            }
+            for (int sy = 0; sy < scale; sy++) {
+                for (int sx = 0; sx < scale; sx++) {
+                    blendPixel(x + col * scale + sx, y + row * scale + sy,
+                               color.r, color.g, color.b, color.a);
+                }
+            }
+        }
+    }
+}
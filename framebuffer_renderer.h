@@ -0,0 +1,104 @@
+// framebuffer_renderer.h
+
+#ifndef FRAMEBUFFER_RENDERER_H
+#define FRAMEBUFFER_RENDERER_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdint>
+#include "renderer.h"
+
+/**
+ * FramebufferRenderer class - Renderer backend that draws into CPU memory
+ * Needs no display or GPU, so the render path can be benchmarked and
+ * pixel-checked on headless machines. Textures are decoded from the same
+ * embedded PNG assets as the SFML backend; text uses a built-in 5x7 bitmap font.
+ */
+class FramebufferRenderer : public Renderer {
+public:
+    /**
+     * Constructor - creates a black RGBA surface
+     * @param width Surface width in pixels
+     * @param height Surface height in pixels
+     */
+    FramebufferRenderer(unsigned width, unsigned height);
+
+    ~FramebufferRenderer();
+
+    std::vector<bool> loadTextures(const std::vector<TextureData>& images, ThreadPool& pool) override;
+    bool loadFont(const unsigned char* data, size_t size) override;
+    bool hasTexture(const std::string& name) const override;
+    bool getTextureSize(const std::string& name, unsigned& width, unsigned& height) const override;
+    unsigned getWidth() const override;
+    unsigned getHeight() const override;
+    void clear(RenderColor color) override;
+    void drawTexture(const std::string& name, float x, float y,
+                     float width, float height, float rotation) override;
+    void drawRect(float x, float y, float width, float height, RenderColor color) override;
+    void drawCircle(float x, float y, float radius, RenderColor color) override;
+    void drawText(std::string_view text, unsigned size, RenderColor color,
+                  float x, float y, TextAlign align, bool bold) override;
+    void display() override;
+    RendererMemory memoryUsage() const override;
+
+    /**
+     * Write every displayed frame to <prefix>NNNNN.ppm
+     * @param prefix Path prefix for the frame files (empty disables dumping)
+     */
+    void setFrameDump(const std::string& prefix);
+
+    /**
+     * Save the current surface as a binary PPM image
+     * @param fileName The file to write
+     * @return true if the file was written
+     */
+    bool saveFrame(const std::string& fileName) const;
+
+    /**
+     * Get a 64-bit FNV-1a hash of the surface pixels (for pixel checks)
+     */
+    uint64_t checksum() const;
+
+    /**
+     * Get the RGBA pixels of the surface, row by row
+     */
+    const std::vector<uint8_t>& getPixels() const;
+
+    /**
+     * Get the number of frames displayed so far
+     */
+    int getFrameCount() const;
+
+private:
+    struct Image {
+        unsigned width;
+        unsigned height;
+        std::vector<uint8_t> pixels;  // RGBA, row by row
+    };
+
+    unsigned width;
+    unsigned height;
+    std::vector<uint8_t> pixels;      // RGBA, row by row
+    std::map<std::string, Image> textures;
+    std::string dumpPrefix;
+    int frameCount;
+
+    /**
+     * Decode an in-memory PNG into RGBA pixels (safe to call from any thread)
+     * @return true if the image was decoded
+     */
+    static bool decodePng(const unsigned char* data, size_t size, Image& image);
+
+    /**
+     * Blend one source pixel over the surface pixel at (px, py)
+     */
+    void blendPixel(int px, int py, uint8_t r, uint8_t g, uint8_t b, uint8_t a);
+
+    /**
+     * Draw one bitmap font glyph with its top-left corner at (x, y)
+     */
+    void drawGlyph(char ch, int x, int y, int scale, RenderColor color);
+};
+
+#endif // FRAMEBUFFER_RENDERER_H
@@ -1,23 +1,37 @@
 // game_manager.cpp
 
 #include "game_manager.h"
+#include <unistd.h>
+#include <chrono>
+#include <algorithm>
+#include "terminal_renderer.h"
+#include "terminal_input.h"
+
+namespace {
+const int DEFAULT_TICK_MILLIS = 200;
+const int DEFAULT_MAX_FPS = 30;
+const int AUTOPILOT_MOVES_PER_CELL = 50;   // Autopilot gives up after size * size times this
+}
 
 /**
  * Default constructor
  */
-GameManager::GameManager() : board(nullptr), outputFileName("") {}
+GameManager::GameManager() : board(nullptr), outputFileName(""), plainOutput(false), useColor(true),
+      realtime(false), tickMillis(DEFAULT_TICK_MILLIS), maxFps(DEFAULT_MAX_FPS), autopilot(nullptr) {}
 
 /**
  * Constructor - creates a new game
  */
 GameManager::GameManager(int boardSize, const std::string& outputBoard) 
-    : board(new Board(boardSize)), outputFileName(outputBoard) {}
+    : board(new Board(boardSize)), outputFileName(outputBoard), plainOutput(false), useColor(true),
+      realtime(false), tickMillis(DEFAULT_TICK_MILLIS), maxFps(DEFAULT_MAX_FPS), autopilot(nullptr) {}
 
 /**
  * Constructor - loads existing game
  */
 GameManager::GameManager(const std::string& inputBoard, const std::string& outputBoard)
-    : board(new Board(inputBoard)), outputFileName(outputBoard) {}
+    : board(new Board(inputBoard)), outputFileName(outputBoard), plainOutput(false), useColor(true),
+      realtime(false), tickMillis(DEFAULT_TICK_MILLIS), maxFps(DEFAULT_MAX_FPS), autopilot(nullptr) {}
 
 /**
  * Destructor
@@ -25,6 +39,8 @@ GameManager::GameManager(const std::string& inputBoard, const std::string& outpu
 GameManager::~GameManager() {
     delete board;
     board = nullptr;
+    delete autopilot;
+    autopilot = nullptr;
 }
 
 /**
@@ -36,7 +52,14 @@ GameManager& GameManager::operator=(const GameManager& other) {
         // Note: This creates a new board with the same size
         // A proper deep copy would require more complex logic
         board = nullptr;
+        delete autopilot;
+        autopilot = other.autopilot != nullptr ? new PacmanAutopilot(other.autopilot->getOptions()) : nullptr;
         outputFileName = other.outputFileName;
+        plainOutput = other.plainOutput;
+        useColor = other.useColor;
+        realtime = other.realtime;
+        tickMillis = other.tickMillis;
+        maxFps = other.maxFps;
     }
     return *this;
 }
@@ -45,8 +68,12 @@ GameManager& GameManager::operator=(const GameManager& other) {
  * Move constructor
  */
 GameManager::GameManager(GameManager&& other) noexcept 
-    : board(other.board), outputFileName(std::move(other.outputFileName)) {
+    : board(other.board), outputFileName(std::move(other.outputFileName)),
+      plainOutput(other.plainOutput), useColor(other.useColor),
+      realtime(other.realtime), tickMillis(other.tickMillis), maxFps(other.maxFps),
+      autopilot(other.autopilot) {
     other.board = nullptr;
+    other.autopilot = nullptr;
 }
 
 /**
@@ -57,11 +84,51 @@ GameManager& GameManager::operator=(GameManager&& other) noexcept {
         delete board;
         board = other.board;
         outputFileName = std::move(other.outputFileName);
+        plainOutput = other.plainOutput;
+        useColor = other.useColor;
+        realtime = other.realtime;
+        tickMillis = other.tickMillis;
+        maxFps = other.maxFps;
+        delete autopilot;
+        autopilot = other.autopilot;
         other.board = nullptr;
+        other.autopilot = nullptr;
     }
     return *this;
 }
 
+/**
+ * Set display options
+ */
+void GameManager::setDisplayOptions(bool plain, bool color) {
+    plainOutput = plain;
+    useColor = color;
+}
+
+/**
+ * Set real-time options
+ */
+void GameManager::setRealtime(bool enabled, int tickMillis, int maxFps) {
+    realtime = enabled;
+    this->tickMillis = std::max(1, tickMillis);
+    this->maxFps = std::max(1, maxFps);
+}
+
+/**
+ * Set the autopilot (a new one, so its stats start at zero)
+ */
+void GameManager::setAutopilot(bool enabled, const AutopilotOptions& options) {
+    delete autopilot;
+    autopilot = enabled ? new PacmanAutopilot(options) : nullptr;
+}
+
+/**
+ * Diff rendering needs cursor addressing, so only use it on a terminal
+ */
+bool GameManager::useTerminalRenderer() const {
+    return !plainOutput && isatty(STDOUT_FILENO);
+}
+
 /**
  * Main game loop
  */
@@ -71,7 +138,22 @@ void GameManager::play() {
         return;
     }
 
-    std::cout << board->toString() << std::endl;
+    if (autopilot != nullptr && !(realtime && useTerminalRenderer() && isatty(STDIN_FILENO))) {
+        playAutopilot();
+        return;
+    }
+
+    if (useTerminalRenderer()) {
+        if (realtime && isatty(STDIN_FILENO)) {
+            playRealtime();
+        } else {
+            playTerminal();
+        }
+        return;
+    }
+
+    board->writeString(boardText);
+    std::cout << boardText << std::endl;
     bool isQ = false;
 
     while (!isQ) {
@@ -89,19 +171,23 @@ void GameManager::play() {
 
         if (ans == "w") {
             board->move(Direction::UP);
-            std::cout << board->toString() << std::endl;
+            board->writeString(boardText);
+            std::cout << boardText << std::endl;
         }
         else if (ans == "s") {
             board->move(Direction::DOWN);
-            std::cout << board->toString() << std::endl;
+            board->writeString(boardText);
+            std::cout << boardText << std::endl;
         }
         else if (ans == "a") {
             board->move(Direction::LEFT);
-            std::cout << board->toString() << std::endl;
+            board->writeString(boardText);
+            std::cout << boardText << std::endl;
         }
         else if (ans == "d") {
             board->move(Direction::RIGHT);
-            std::cout << board->toString() << std::endl;
+            board->writeString(boardText);
+            std::cout << boardText << std::endl;
         }
         else if (ans == "q") {
             isQ = true;
@@ -114,6 +200,219 @@ void GameManager::play() {
     }
 }
 
+/**
+ * Game loop for ANSI terminals - the board stays in place and only
+ * changed cells are redrawn; prompts go in the status area below it
+ */
+void GameManager::playTerminal() {
+    TerminalRenderer renderer(std::cout, useColor);
+    std::string message;
+    bool isQ = false;
+
+    while (!isQ) {
+        renderer.draw(*board);
+        if (!message.empty()) {
+            std::cout << message << std::endl;
+            message.clear();
+        }
+
+        if (board->getIsGameOver()) {
+            std::cout << "Game Over!" << std::endl;
+            isQ = true;
+            board->saveBoard(outputFileName);
+            continue;
+        }
+
+        std::cout << "  w/a/s/d - Move   q - Quit and Save Board" << std::endl;
+        std::cout << "> " << std::flush;
+
+        std::string ans;
+        if (!(std::cin >> ans)) {
+            ans = "q";
+        }
+
+        if (ans == "w") {
+            board->move(Direction::UP);
+        }
+        else if (ans == "s") {
+            board->move(Direction::DOWN);
+        }
+        else if (ans == "a") {
+            board->move(Direction::LEFT);
+        }
+        else if (ans == "d") {
+            board->move(Direction::RIGHT);
+        }
+        else if (ans == "q") {
+            isQ = true;
+            board->saveBoard(outputFileName);
+            std::cout << "Game saved to: " << outputFileName << std::endl;
+        }
+        else {
+            message = "Invalid command. Please try again.";
+        }
+    }
+}
+
+/**
+ * Real-time game loop - the board moves every tick in the direction last
+ * pressed, while frames are drawn only when something changed and at
+ * most maxFps times per second. Between events the loop sleeps in poll.
+ */
+void GameManager::playRealtime() {
+    using Clock = std::chrono::steady_clock;
+
+    TerminalInput input(STDIN_FILENO);
+    if (!input.isRaw()) {
+        playTerminal();
+        return;
+    }
+    TerminalRenderer renderer(std::cout, useColor);
+
+    const Clock::duration tickInterval = std::chrono::milliseconds(tickMillis);
+    const Clock::duration frameInterval = std::chrono::microseconds(1000000 / maxFps);
+    const int MAX_CATCH_UP_TICKS = 5;   // After a stall, drop ticks instead of racing
+
+    Direction direction = Direction::STAY;
+    bool started = autopilot != nullptr;   // The clock starts with the first move key
+    bool paused = false;
+    bool quit = false;
+    bool dirty = true;
+    Clock::time_point nextTick = Clock::now() + tickInterval;
+    Clock::time_point lastFrame = Clock::now() - frameInterval;
+
+    while (!quit && !board->getIsGameOver()) {
+        Key key;
+        while ((key = input.readKey()) != Key::NONE) {
+            if (autopilot != nullptr && key != Key::PAUSE && key != Key::QUIT) {
+                continue;
+            }
+            switch (key) {
+                case Key::UP:    direction = Direction::UP;    break;
+                case Key::DOWN:  direction = Direction::DOWN;  break;
+                case Key::LEFT:  direction = Direction::LEFT;  break;
+                case Key::RIGHT: direction = Direction::RIGHT; break;
+                case Key::PAUSE: paused = !paused; dirty = true; break;
+                case Key::QUIT:  quit = true; break;
+                default: break;
+            }
+            if (!started && direction != Direction::STAY) {
+                started = true;
+                nextTick = Clock::now();
+                dirty = true;
+            }
+        }
+        if (quit) {
+            break;
+        }
+
+        Clock::time_point now = Clock::now();
+        if (started && !paused) {
+            int ticks = 0;
+            while (now >= nextTick && !board->getIsGameOver()) {
+                if (autopilot != nullptr) {
+                    direction = autopilot->chooseMove(*board);
+                }
+                board->move(direction);
+                nextTick += tickInterval;
+                dirty = true;
+                if (++ticks == MAX_CATCH_UP_TICKS) {
+                    nextTick = now + tickInterval;
+                }
+            }
+        } else {
+            nextTick = now + tickInterval;
+        }
+
+        if (board->getIsGameOver()) {
+            break;
+        }
+
+        if (dirty && now - lastFrame >= frameInterval) {
+            renderer.draw(*board);
+            if (!started) {
+                std::cout << "  Press w/a/s/d or an arrow key to start   q - Quit and Save Board" << std::endl;
+            } else if (paused) {
+                std::cout << "  Paused - p to resume   q - Quit and Save Board" << std::endl;
+            } else if (autopilot != nullptr) {
+                const AutopilotStats& last = autopilot->getLastStats();
+                std::cout << "  Autopilot: " << last.playouts << " playouts, "
+                          << static_cast<long long>(last.nodesPerSecond()) << " nodes/s"
+                          << "   p - Pause   q - Quit and Save Board" << std::endl;
+            } else {
+                std::cout << "  w/a/s/d or arrows - Turn   p - Pause   q - Quit and Save Board" << std::endl;
+            }
+            lastFrame = now;
+            dirty = false;
+        }
+
+        // Sleep until the next tick, the next allowed frame, or a key
+        Clock::time_point wakeUp = now + std::chrono::milliseconds(100);
+        if (started && !paused) {
+            wakeUp = std::min(wakeUp, nextTick);
+        }
+        if (dirty) {
+            wakeUp = std::min(wakeUp, lastFrame + frameInterval);
+        }
+        int timeout = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            wakeUp - Clock::now()).count());
+        input.waitForInput(std::max(0, timeout));
+    }
+
+    renderer.draw(*board);
+    if (board->getIsGameOver()) {
+        std::cout << "Game Over!" << std::endl;
+        board->saveBoard(outputFileName);
+    } else {
+        board->saveBoard(outputFileName);
+        std::cout << "Game saved to: " << outputFileName << std::endl;
+    }
+    if (autopilot != nullptr) {
+        printAutopilotReport();
+    }
+}
+
+/**
+ * Autopilot game loop without input - every move is drawn (in place on a
+ * terminal, as text otherwise) with the last search's throughput. A
+ * Pacman that can no longer reach the dots left stops after
+ * AUTOPILOT_MOVES_PER_CELL moves per cell.
+ */
+void GameManager::playAutopilot() {
+    bool inPlace = useTerminalRenderer();
+    TerminalRenderer renderer(std::cout, useColor);
+    long long maxMoves = static_cast<long long>(board->getGridSize()) * board->getGridSize() * AUTOPILOT_MOVES_PER_CELL;
+    long long moves = 0;
+
+    while (!board->getIsGameOver() && board->getDotsRemaining() > 0 && moves < maxMoves) {
+        board->move(autopilot->chooseMove(*board));
+        moves++;
+        const AutopilotStats& last = autopilot->getLastStats();
+        if (inPlace) {
+            renderer.draw(*board);
+        } else {
+            board->writeString(boardText);
+            std::cout << boardText << std::endl;
+        }
+        std::cout << "  Autopilot: " << last.playouts << " playouts, "
+                  << static_cast<long long>(last.nodesPerSecond()) << " nodes/s" << std::endl;
+    }
+
+    if (board->getIsGameOver()) {
+        std::cout << "Game Over!" << std::endl;
+    } else if (board->getDotsRemaining() == 0) {
+        std::cout << "Board cleared!" << std::endl;
+    } else {
+        std::cout << "Autopilot stopped after " << moves << " moves" << std::endl;
+    }
+    board->saveBoard(outputFileName);
+    printAutopilotReport();
+}
+
+void GameManager::printAutopilotReport() {
+    writeAutopilotReport(std::cout, autopilot->getOptions(), autopilot->getTotalStats(), board);
+}
+
 /**
  * Print control instructions
  */
@@ -7,6 +7,7 @@
 #include <string>
 #include "Board.h"
 #include "Direction.h"
+#include "pacman_autopilot.h"
 
 /**
  * GameManager class - handles user input and game loop
@@ -66,12 +67,73 @@ public:
      *   a - Move Left
      *   d - Move Right
      *   q - Quit and Save Board
+     * In real-time mode the keys (or arrow keys) act immediately and
+     * p pauses.
      */
     void play();
 
+    /**
+     * Choose how the board is printed
+     * @param plain Always reprint the whole board as text (no cursor addressing)
+     * @param color Color the board when drawing on an ANSI terminal
+     */
+    void setDisplayOptions(bool plain, bool color);
+
+    /**
+     * Enable real-time play: keys are read without Enter and the board
+     * advances on its own clock in the direction last pressed
+     * @param enabled Use real-time play when stdin/stdout are a terminal
+     * @param tickMillis Time between board moves in milliseconds
+     * @param maxFps Upper limit on frames drawn per second
+     */
+    void setRealtime(bool enabled, int tickMillis, int maxFps);
+
+    /**
+     * Let a PacmanAutopilot play instead of the keyboard
+     * In real-time mode it moves on the tick clock (p pauses, q quits);
+     * otherwise it plays as fast as it searches until Pacman is caught or
+     * the board is cleared. Either way the game ends with a JSON line of
+     * the search's throughput.
+     * @param enabled Use the autopilot
+     * @param options Its search limits
+     */
+    void setAutopilot(bool enabled, const AutopilotOptions& options = AutopilotOptions());
+
 private:
     Board* board;              // The game board (pointer for polymorphism)
     std::string outputFileName; // File to save board to when exiting
+    bool plainOutput;          // Reprint toString() every move
+    bool useColor;             // ANSI colors in terminal renderer mode
+    bool realtime;             // Board runs on a clock instead of per command
+    int tickMillis;            // Real-time: time between moves
+    int maxFps;                // Real-time: frame rate cap
+    std::string boardText;     // Reused buffer for plain-mode board output
+    PacmanAutopilot* autopilot; // Plays instead of the keyboard, or null
+
+    /**
+     * Check if stdout is a terminal that should get the diff renderer
+     */
+    bool useTerminalRenderer() const;
+
+    /**
+     * Game loop using the diff-based terminal renderer
+     */
+    void playTerminal();
+
+    /**
+     * Game loop for real-time play with raw keyboard input
+     */
+    void playRealtime();
+
+    /**
+     * Game loop for the autopilot without real-time play
+     */
+    void playAutopilot();
+
+    /**
+     * Print the autopilot's totals as one JSON line
+     */
+    void printAutopilotReport();
 
     /**
      * Print control instructions
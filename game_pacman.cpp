@@ -1,20 +1,24 @@
 // game_pacman.cpp
 
 #include "game_pacman.h"
+#include <string_view>
 
 /**
  * Constructor
  */
-GamePacman::GamePacman() : boardSize(DEFAULT_SIZE), gm(nullptr) {}
+GamePacman::GamePacman() : boardSize(DEFAULT_SIZE), gm(nullptr), plainOutput(false), useColor(true),
+      realtime(false), tickMillis(DEFAULT_TICK_MILLIS), maxFps(DEFAULT_MAX_FPS), autopilot(false) {}
 
 /**
  * Start the game
  */
 void GamePacman::play(int argc, char** argv) {
-    std::vector<std::string> args(argv, argv + argc);
-    processArgs(args);
+    processArgs(argc, argv);
     
     if (gm != nullptr) {
+        gm->setDisplayOptions(plainOutput, useColor);
+        gm->setRealtime(realtime, tickMillis, maxFps);
+        gm->setAutopilot(autopilot, autopilotOptions);
         gm->play();
         delete gm;
         gm = nullptr;
@@ -24,48 +28,77 @@ void GamePacman::play(int argc, char** argv) {
 /**
  * Process command line arguments
  */
-void GamePacman::processArgs(const std::vector<std::string>& args) {
+void GamePacman::processArgs(int argc, char** argv) {
     bool hasI = false, hasO = false, hasS = false;
     int iNum = 0, oNum = 0, sNum = 0;
 
-    for (size_t a = 0; a < args.size(); a++) {
-        if (args[a] == "-i") {
+    for (int a = 0; a < argc; a++) {
+        std::string_view arg = argv[a];
+        bool hasValue = a + 1 < argc;
+        if (arg == "-i" && hasValue) {
             hasI = true;
             iNum = a;
         }
-        else if (args[a] == "-o") {
+        else if (arg == "-o" && hasValue) {
             hasO = true;
             oNum = a;
         }
-        else if (args[a] == "-s") {
+        else if (arg == "-s" && hasValue) {
             hasS = true;
             sNum = a;
         }
+        else if (arg == "--plain") {
+            plainOutput = true;
+        }
+        else if (arg == "--no-color") {
+            useColor = false;
+        }
+        else if (arg == "-r" || arg == "--realtime") {
+            realtime = true;
+        }
+        else if (arg == "--tick" && hasValue) {
+            tickMillis = std::stoi(argv[++a]);
+        }
+        else if (arg == "--fps" && hasValue) {
+            maxFps = std::stoi(argv[++a]);
+        }
+        else if (arg == "--autopilot") {
+            autopilot = true;
+        }
+        else if (arg == "--autopilot-ms" && hasValue) {
+            autopilotOptions.budgetMs = std::stod(argv[++a]);
+        }
+        else if (arg == "--autopilot-playouts" && hasValue) {
+            autopilotOptions.maxPlayouts = std::stoi(argv[++a]);
+        }
+        else if (arg == "--autopilot-threads" && hasValue) {
+            autopilotOptions.threads = static_cast<unsigned>(std::stoul(argv[++a]));
+        }
     }
 
     if (hasI && hasO) {
-        inputName = args[iNum + 1];
-        outputName = args[oNum + 1];
+        inputName = argv[iNum + 1];
+        outputName = argv[oNum + 1];
         gm = new GameManager(inputName, outputName);
     }
     else if (hasI && !hasO) {
-        inputName = args[iNum + 1];
+        inputName = argv[iNum + 1];
         outputName = DEFAULT_FILE_NAME;
         gm = new GameManager(inputName, outputName);
     }
     else if (!hasI && hasO && hasS) {
-        outputName = args[oNum + 1];
-        boardSize = std::stoi(args[sNum + 1]);
+        outputName = argv[oNum + 1];
+        boardSize = std::stoi(argv[sNum + 1]);
         gm = new GameManager(boardSize, outputName);
     }
     else if (!hasI && !hasO && hasS) {
-        boardSize = std::stoi(args[sNum + 1]);
+        boardSize = std::stoi(argv[sNum + 1]);
         outputName = DEFAULT_FILE_NAME;
         gm = new GameManager(boardSize, outputName);
     }
     else if (!hasI && hasO && !hasS) {
         boardSize = DEFAULT_SIZE;
-        outputName = args[oNum + 1];
+        outputName = argv[oNum + 1];
         gm = new GameManager(boardSize, outputName);
     }
     else {
@@ -77,5 +110,7 @@ void GamePacman::processArgs(const std::vector<std::string>& args) {
 
 void GamePacman::printUsage() {
     std::cout << "Pac-Man" << std::endl;
-    std::cout << "Usage: GamePacman [-s size] [-i inputFile] [-o outputFile]" << std::endl;
+    std::cout << "Usage: GamePacman [-s size] [-i inputFile] [-o outputFile] [--plain] [--no-color]"
+              << " [-r] [--tick ms] [--fps n]"
+              << " [--autopilot] [--autopilot-ms ms] [--autopilot-playouts n] [--autopilot-threads n]" << std::endl;
 }
\ No newline at end of file
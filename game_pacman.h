@@ -29,18 +29,28 @@ public:
 
 private:
     static const int DEFAULT_SIZE = 10;
+    static const int DEFAULT_TICK_MILLIS = 200;
+    static const int DEFAULT_MAX_FPS = 30;
     const std::string DEFAULT_FILE_NAME = "Pac-Man.board";
 
     int boardSize;
     std::string inputName;
     std::string outputName;
     GameManager* gm;
+    bool plainOutput;
+    bool useColor;
+    bool realtime;
+    int tickMillis;
+    int maxFps;
+    bool autopilot;
+    AutopilotOptions autopilotOptions;
 
     /**
      * Process command line arguments
-     * @param args Vector of argument strings
+     * @param argc Argument count
+     * @param argv Argument values (read in place, not copied)
      */
-    void processArgs(const std::vector<std::string>& args);
+    void processArgs(int argc, char** argv);
 
     /**
      * Print usage message
@@ -0,0 +1,159 @@
+// game_protocol.h
+// Compact binary protocol spoken by pacman-server and its clients
+//
+// Every message is one frame: an opcode byte followed by a fixed or
+// length-prefixed payload. Integers are little-endian.
+//
+//   Client -> server
+//     NEW_GAME  u16 size, u16 ghosts              -> STATE (ghosts 1 to 4 * (size - 1))
+//     MOVE      u8 count, count x u8 Direction    -> STATE (after the last move)
+//     GET_BOARD                                   -> BOARD
+//     QUIT                                        (server closes the session)
+//   Server -> client
+//     STATE     StateFrame fields
+//     BOARD     u32 length, board text (Board::writeString)
+//     ERROR     u8 ErrorCode
+
+#ifndef GAME_PROTOCOL_H
+#define GAME_PROTOCOL_H
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Frame opcodes
+ */
+enum class Opcode : uint8_t {
+    NEW_GAME = 0x01,
+    MOVE = 0x02,
+    GET_BOARD = 0x03,
+    QUIT = 0x04,
+    STATE = 0x81,
+    BOARD = 0x82,
+    ERROR = 0xFF
+};
+
+/**
+ * Reasons carried by an ERROR frame
+ */
+enum class ErrorCode : uint8_t {
+    BAD_OPCODE = 1,     // Unknown opcode; the session is closed
+    NO_GAME = 2,        // MOVE or GET_BOARD before NEW_GAME
+    BAD_SIZE = 3,       // NEW_GAME size or ghost count out of range
+    BAD_DIRECTION = 4   // MOVE with a direction byte above STAY
+};
+
+/**
+ * Game status reported in a STATE frame
+ */
+enum class GameStatus : uint8_t {
+    PLAYING = 0,
+    CAUGHT = 1,    // Pacman was caught by a ghost
+    CLEARED = 2    // Every dot was eaten
+};
+
+/**
+ * WireFormat - little-endian integer helpers for frame payloads
+ */
+struct WireFormat {
+    static void putU16(uint8_t* out, uint16_t value) {
+        out[0] = static_cast<uint8_t>(value);
+        out[1] = static_cast<uint8_t>(value >> 8);
+    }
+
+    static void putU32(uint8_t* out, uint32_t value) {
+        for (int i = 0; i < 4; i++) {
+            out[i] = static_cast<uint8_t>(value >> (8 * i));
+        }
+    }
+
+    static uint16_t getU16(const uint8_t* in) {
+        return static_cast<uint16_t>(in[0] | (in[1] << 8));
+    }
+
+    static uint32_t getU32(const uint8_t* in) {
+        return static_cast<uint32_t>(in[0]) | (static_cast<uint32_t>(in[1]) << 8) |
+               (static_cast<uint32_t>(in[2]) << 16) | (static_cast<uint32_t>(in[3]) << 24);
+    }
+
+    /**
+     * Get the length of the client frame at the start of a buffer
+     * @param data Received bytes
+     * @param available Number of received bytes
+     * @return Frame length, 0 if more bytes are needed, 1 for an unknown opcode
+     */
+    static size_t requestLength(const uint8_t* data, size_t available) {
+        if (available == 0) {
+            return 0;
+        }
+        size_t length = 1;
+        switch (static_cast<Opcode>(data[0])) {
+            case Opcode::NEW_GAME: length = 5; break;
+            case Opcode::MOVE:     length = available >= 2 ? 2 + static_cast<size_t>(data[1]) : 2; break;
+            default:               length = 1; break;
+        }
+        return available >= length ? length : 0;
+    }
+
+    /**
+     * Get the length of the server frame at the start of a buffer
+     * @return Frame length, or 0 if more bytes are needed
+     */
+    static size_t replyLength(const uint8_t* data, size_t available);
+};
+
+/**
+ * StateFrame - fields of a STATE frame
+ */
+struct StateFrame {
+    static const size_t SIZE = 18;   // Encoded bytes, opcode included
+
+    GameStatus status;
+    uint32_t score;
+    uint32_t ticks;
+    uint32_t dotsRemaining;
+    uint16_t pacmanRow;
+    uint16_t pacmanCol;
+
+    /**
+     * Write the frame (opcode included) into out[0 .. SIZE)
+     */
+    void encode(uint8_t* out) const {
+        out[0] = static_cast<uint8_t>(Opcode::STATE);
+        out[1] = static_cast<uint8_t>(status);
+        WireFormat::putU32(out + 2, score);
+        WireFormat::putU32(out + 6, ticks);
+        WireFormat::putU32(out + 10, dotsRemaining);
+        WireFormat::putU16(out + 14, pacmanRow);
+        WireFormat::putU16(out + 16, pacmanCol);
+    }
+
+    /**
+     * Read a frame encoded by encode()
+     */
+    static StateFrame decode(const uint8_t* in) {
+        StateFrame frame;
+        frame.status = static_cast<GameStatus>(in[1]);
+        frame.score = WireFormat::getU32(in + 2);
+        frame.ticks = WireFormat::getU32(in + 6);
+        frame.dotsRemaining = WireFormat::getU32(in + 10);
+        frame.pacmanRow = WireFormat::getU16(in + 14);
+        frame.pacmanCol = WireFormat::getU16(in + 16);
+        return frame;
+    }
+};
+
+inline size_t WireFormat::replyLength(const uint8_t* data, size_t available) {
+    if (available == 0) {
+        return 0;
+    }
+    size_t length;
+    switch (static_cast<Opcode>(data[0])) {
+        case Opcode::STATE: length = StateFrame::SIZE; break;
+        case Opcode::BOARD: length = available >= 5 ? 5 + static_cast<size_t>(getU32(data + 1)) : 5; break;
+        default:            length = 2; break;
+    }
+    return available >= length ? length : 0;
+}
+
+#endif // GAME_PROTOCOL_H
@@ -0,0 +1,474 @@
+// game_server.cpp
+
+#include "game_server.h"
+#include "thread_pool.h"
+#include "trace.h"
+#include <iostream>
+#include <stdexcept>
+#include <future>
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+namespace {
+
+const size_t READ_CHUNK = 16384;             // Bytes asked for per recv call
+const size_t MAX_PENDING_INPUT = 65536;      // Unhandled request bytes a connection may hold
+const size_t MAX_PENDING_OUTPUT = 1 << 20;   // Unsent reply bytes on top of one BOARD reply
+
+#ifdef MSG_NOSIGNAL
+const int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+const int SEND_FLAGS = 0;          // pacman-server ignores SIGPIPE instead
+#endif
+
+/**
+ * Make a descriptor non-blocking
+ */
+void setNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+}
+
+/**
+ * Build an error message from errno
+ */
+std::runtime_error systemError(const std::string& what) {
+    return std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+/**
+ * Wake a poll loop through its self-pipe
+ */
+void wake(int fd) {
+    char byte = 1;
+    ssize_t written = write(fd, &byte, 1);
+    (void)written;   // A full pipe already has a wake-up pending
+}
+
+/**
+ * Empty a self-pipe
+ */
+void drain(int fd) {
+    char bytes[64];
+    while (read(fd, bytes, sizeof(bytes)) > 0) {
+    }
+}
+
+} // namespace
+
+/**
+ * Constructor - creates the shards; sockets are opened by listenUnix/listenTcp
+ */
+GameServer::GameServer(unsigned workerCount, int maxBoardSize)
+    : workerCount(workerCount == 0 ? ThreadPool::defaultThreadCount() : workerCount),
+      maxBoardSize(maxBoardSize), listenFd(-1), stopRead(-1), stopWrite(-1),
+      stopping(false), sessions(0) {
+    // A client must be able to fetch the largest board, so the output cap leaves room for one
+    size_t boardReply = 5 + 32 + static_cast<size_t>(maxBoardSize) * (3 * static_cast<size_t>(maxBoardSize) + 1);
+    outputLimit = MAX_PENDING_OUTPUT + boardReply;
+    makePipe(stopRead, stopWrite);
+    for (unsigned i = 0; i < this->workerCount; i++) {
+        Shard* shard = new Shard();
+        makePipe(shard->wakeRead, shard->wakeWrite);
+        shard->frames = 0;
+        shard->moves = 0;
+        shard->active = 0;
+        shards.push_back(shard);
+    }
+}
+
+/**
+ * Destructor
+ */
+GameServer::~GameServer() {
+    for (Shard* shard : shards) {
+        for (Connection* connection : shard->connections) {
+            close(connection->fd);
+            delete connection;
+        }
+        for (int fd : shard->incoming) {
+            close(fd);
+        }
+        close(shard->wakeRead);
+        close(shard->wakeWrite);
+        delete shard;
+    }
+    if (listenFd >= 0) {
+        close(listenFd);
+    }
+    if (!unixPath.empty()) {
+        unlink(unixPath.c_str());
+    }
+    close(stopRead);
+    close(stopWrite);
+}
+
+void GameServer::makePipe(int& readFd, int& writeFd) {
+    int fds[2];
+    if (pipe(fds) != 0) {
+        throw systemError("pipe");
+    }
+    setNonBlocking(fds[0]);
+    setNonBlocking(fds[1]);
+    readFd = fds[0];
+    writeFd = fds[1];
+}
+
+void GameServer::listenUnix(const std::string& path) {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    if (path.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("socket path too long: " + path);
+    }
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, path.c_str(), path.size());
+
+    listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        throw systemError("socket");
+    }
+    unlink(path.c_str());
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        throw systemError("bind " + path);
+    }
+    unixPath = path;
+    if (listen(listenFd, SOMAXCONN) != 0) {
+        throw systemError("listen");
+    }
+    setNonBlocking(listenFd);
+}
+
+void GameServer::listenTcp(int port) {
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<uint16_t>(port));
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    listenFd = socket(AF_INET, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        throw systemError("socket");
+    }
+    int reuse = 1;
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        throw systemError("bind port " + std::to_string(port));
+    }
+    if (listen(listenFd, SOMAXCONN) != 0) {
+        throw systemError("listen");
+    }
+    setNonBlocking(listenFd);
+}
+
+/**
+ * Run one event loop per shard on the pool and accept on this thread
+ */
+void GameServer::run() {
+    if (listenFd < 0) {
+        throw std::runtime_error("server is not listening");
+    }
+
+    ThreadPool pool(workerCount);
+    std::vector<std::future<void>> loops;
+    for (Shard* shard : shards) {
+        loops.push_back(pool.submit([this, shard]() { shardLoop(*shard); }));
+    }
+
+    std::exception_ptr failure;
+    try {
+        acceptLoop();
+    } catch (...) {
+        failure = std::current_exception();
+    }
+
+    stopping = true;
+    for (Shard* shard : shards) {
+        wake(shard->wakeWrite);
+    }
+    for (std::future<void>& loop : loops) {
+        try {
+            loop.get();
+        } catch (...) {
+            if (!failure) {
+                failure = std::current_exception();
+            }
+        }
+    }
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+}
+
+void GameServer::stop() {
+    stopping = true;
+    wake(stopWrite);
+}
+
+ServerStats GameServer::getStats() const {
+    ServerStats stats{sessions, 0, 0, 0};
+    for (const Shard* shard : shards) {
+        stats.active += shard->active;
+        stats.frames += shard->frames;
+        stats.moves += shard->moves;
+    }
+    return stats;
+}
+
+/**
+ * Accept until stopped; connection n goes to shard n % workerCount and
+ * stays there for its whole life
+ */
+void GameServer::acceptLoop() {
+    size_t next = 0;
+    bool warned = false;
+    while (!stopping) {
+        pollfd fds[2] = {{listenFd, POLLIN, 0}, {stopRead, POLLIN, 0}};
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) continue;
+            throw systemError("poll");
+        }
+        if (fds[1].revents != 0) {
+            drain(stopRead);
+            continue;
+        }
+
+        while (true) {
+            int fd = accept(listenFd, nullptr, nullptr);
+            if (fd < 0) {
+                if (errno == EMFILE || errno == ENFILE) {
+                    // Out of descriptors: back off instead of spinning on poll
+                    if (!warned) {
+                        std::cerr << "Warning: out of file descriptors, delaying accepts" << std::endl;
+                        warned = true;
+                    }
+                    poll(nullptr, 0, 10);
+                }
+                break;
+            }
+            setNonBlocking(fd);
+            int noDelay = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));   // Fails harmlessly on Unix sockets
+            sessions++;
+
+            Shard& shard = *shards[next++ % shards.size()];
+            {
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                shard.incoming.push_back(fd);
+            }
+            wake(shard.wakeWrite);
+        }
+    }
+}
+
+/**
+ * Poll the shard's sockets, handle their frames and send the replies
+ */
+void GameServer::shardLoop(Shard& shard) {
+    std::vector<pollfd> fds;
+    std::vector<int> adopted;
+    while (!stopping) {
+        fds.clear();
+        fds.push_back(pollfd{shard.wakeRead, POLLIN, 0});
+        for (Connection* connection : shard.connections) {
+            short events = POLLIN;
+            if (connection->outputSent < connection->output.size()) {
+                events |= POLLOUT;
+            }
+            fds.push_back(pollfd{connection->fd, events, 0});
+        }
+
+        if (poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) continue;
+            throw systemError("poll");
+        }
+
+        // Serve the connections that were polled, then drop the closed ones
+        PAC_TRACE_SCOPE("GameServer::shardLoop");
+        size_t kept = 0;
+        for (size_t i = 0; i < shard.connections.size(); i++) {
+            Connection* connection = shard.connections[i];
+            short revents = fds[i + 1].revents;
+            bool open = true;
+            if (revents & (POLLIN | POLLHUP | POLLERR)) {
+                open = readConnection(shard, *connection);
+            }
+            if (open && (revents & POLLOUT)) {
+                open = flushConnection(*connection);
+            }
+            if (open && connection->closing && connection->outputSent == connection->output.size()) {
+                open = false;
+            }
+            if (open) {
+                shard.connections[kept++] = connection;
+            } else {
+                close(connection->fd);
+                delete connection;
+                shard.active--;
+            }
+        }
+        shard.connections.resize(kept);
+
+        // Adopt connections handed over by the acceptor
+        if (fds[0].revents != 0) {
+            drain(shard.wakeRead);
+            adopted.clear();
+            {
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                adopted.swap(shard.incoming);
+            }
+            for (int fd : adopted) {
+                Connection* connection = new Connection();
+                connection->fd = fd;
+                connection->outputSent = 0;
+                connection->closing = false;
+                shard.connections.push_back(connection);
+                shard.active++;
+            }
+        }
+    }
+
+    for (Connection* connection : shard.connections) {
+        close(connection->fd);
+        delete connection;
+    }
+    shard.connections.clear();
+    shard.active = 0;
+}
+
+/**
+ * Read what is available a chunk at a time, handling the complete frames
+ * and sending the replies after each chunk. A client that floods requests
+ * or stops reading replies is dropped once its buffers pass the limits.
+ */
+bool GameServer::readConnection(Shard& shard, Connection& connection) {
+    std::vector<uint8_t>& input = connection.input;
+    while (true) {
+        size_t used = input.size();
+        input.resize(used + READ_CHUNK);
+        ssize_t received = recv(connection.fd, input.data() + used, READ_CHUNK, 0);
+        input.resize(used + (received > 0 ? static_cast<size_t>(received) : 0));
+        if (received == 0) {
+            return false;
+        }
+        if (received < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            if (errno == EINTR) continue;
+            return false;
+        }
+
+        size_t offset = 0;
+        while (!connection.closing) {
+            size_t length = WireFormat::requestLength(input.data() + offset, input.size() - offset);
+            if (length == 0) {
+                break;
+            }
+            handleFrame(shard, connection, input.data() + offset, length);
+            offset += length;
+        }
+        if (connection.closing) {
+            input.clear();   // Nothing after QUIT or a bad opcode is handled
+        } else {
+            input.erase(input.begin(), input.begin() + static_cast<std::ptrdiff_t>(offset));
+        }
+
+        if (!flushConnection(connection)) {
+            return false;
+        }
+        if (input.size() > MAX_PENDING_INPUT || connection.output.size() - connection.outputSent > outputLimit) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void GameServer::handleFrame(Shard& shard, Connection& connection, const uint8_t* frame, size_t length) {
+    (void)length;
+    shard.frames++;
+    GameSession& session = connection.session;
+    std::vector<uint8_t>& output = connection.output;
+
+    switch (static_cast<Opcode>(frame[0])) {
+        case Opcode::NEW_GAME: {
+            int size = WireFormat::getU16(frame + 1);
+            int ghostCount = WireFormat::getU16(frame + 3);
+            if (size < 3 || size > maxBoardSize || ghostCount < 1 || ghostCount > 4 * (size - 1)) {
+                queueError(connection, ErrorCode::BAD_SIZE);
+                return;
+            }
+            session.newGame(size, ghostCount);
+            break;
+        }
+        case Opcode::MOVE: {
+            if (!session.hasGame()) {
+                queueError(connection, ErrorCode::NO_GAME);
+                return;
+            }
+            Direction moves[255];
+            int count = frame[1];
+            for (int i = 0; i < count; i++) {
+                if (frame[2 + i] > static_cast<uint8_t>(Direction::STAY)) {
+                    queueError(connection, ErrorCode::BAD_DIRECTION);
+                    return;
+                }
+                moves[i] = static_cast<Direction>(frame[2 + i]);
+            }
+            shard.moves += static_cast<uint64_t>(session.move(moves, count));
+            break;
+        }
+        case Opcode::GET_BOARD: {
+            if (!session.hasGame()) {
+                queueError(connection, ErrorCode::NO_GAME);
+                return;
+            }
+            std::string& text = shard.boardText;
+            session.getBoard()->writeString(text);
+            size_t start = output.size();
+            output.resize(start + 5 + text.size());
+            output[start] = static_cast<uint8_t>(Opcode::BOARD);
+            WireFormat::putU32(output.data() + start + 1, static_cast<uint32_t>(text.size()));
+            std::memcpy(output.data() + start + 5, text.data(), text.size());
+            return;
+        }
+        case Opcode::QUIT:
+            connection.closing = true;
+            return;
+        default:
+            queueError(connection, ErrorCode::BAD_OPCODE);
+            connection.closing = true;
+            return;
+    }
+
+    size_t start = output.size();
+    output.resize(start + StateFrame::SIZE);
+    session.getState().encode(output.data() + start);
+}
+
+bool GameServer::flushConnection(Connection& connection) {
+    std::vector<uint8_t>& output = connection.output;
+    while (connection.outputSent < output.size()) {
+        ssize_t sent = send(connection.fd, output.data() + connection.outputSent,
+                            output.size() - connection.outputSent, SEND_FLAGS);
+        if (sent < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return true;
+            if (errno == EINTR) continue;
+            return false;
+        }
+        connection.outputSent += static_cast<size_t>(sent);
+    }
+    output.clear();
+    connection.outputSent = 0;
+    return true;
+}
+
+void GameServer::queueError(Connection& connection, ErrorCode code) {
+    connection.output.push_back(static_cast<uint8_t>(Opcode::ERROR));
+    connection.output.push_back(static_cast<uint8_t>(code));
+}
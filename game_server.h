@@ -0,0 +1,153 @@
+// game_server.h
+
+#ifndef GAME_SERVER_H
+#define GAME_SERVER_H
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+#include "game_session.h"
+
+/**
+ * ServerStats - totals over the life of a server
+ */
+struct ServerStats {
+    uint64_t sessions;   // Connections accepted
+    uint64_t active;     // Connections open now
+    uint64_t frames;     // Client frames handled
+    uint64_t moves;      // Board moves applied
+};
+
+/**
+ * GameServer class - hosts many independent game sessions in one process
+ * Clients connect over a Unix or TCP socket and speak the binary protocol
+ * in game_protocol.h. One acceptor thread hands each connection to a
+ * shard; a shard is an event loop on one ThreadPool worker that owns its
+ * sessions for their whole life, so no session is shared between threads
+ * and there is no thread per client.
+ */
+class GameServer {
+public:
+    /**
+     * Constructor
+     * @param workerCount Number of shards (0 means ThreadPool::defaultThreadCount())
+     * @param maxBoardSize Largest board a client may ask for
+     */
+    GameServer(unsigned workerCount, int maxBoardSize);
+
+    /**
+     * Destructor - closes every socket
+     */
+    ~GameServer();
+
+    GameServer(const GameServer&) = delete;
+    GameServer& operator=(const GameServer&) = delete;
+
+    /**
+     * Listen on a Unix socket (an existing socket file is replaced)
+     * @throws std::runtime_error if the socket cannot be bound
+     */
+    void listenUnix(const std::string& path);
+
+    /**
+     * Listen on a TCP port on the loopback interface
+     * @throws std::runtime_error if the socket cannot be bound
+     */
+    void listenTcp(int port);
+
+    /**
+     * Serve clients until stop() is called
+     */
+    void run();
+
+    /**
+     * Ask run() to return; safe to call from a signal handler
+     */
+    void stop();
+
+    /**
+     * Get the server totals
+     */
+    ServerStats getStats() const;
+
+private:
+    /**
+     * Connection - one client socket and its game
+     */
+    struct Connection {
+        int fd;
+        GameSession session;
+        std::vector<uint8_t> input;    // Received bytes not yet handled
+        std::vector<uint8_t> output;   // Reply bytes not yet sent
+        size_t outputSent;             // Bytes of output already sent
+        bool closing;                  // Close once output is sent
+    };
+
+    /**
+     * Shard - event loop state for one worker
+     */
+    struct Shard {
+        int wakeRead;                    // Self-pipe: new connections or stop
+        int wakeWrite;
+        std::mutex mutex;
+        std::vector<int> incoming;       // Accepted sockets not yet picked up (guarded)
+        std::vector<Connection*> connections;
+        std::string boardText;           // Reused buffer for BOARD replies
+        std::atomic<uint64_t> frames;
+        std::atomic<uint64_t> moves;
+        std::atomic<uint64_t> active;
+    };
+
+    unsigned workerCount;
+    int maxBoardSize;
+    size_t outputLimit;                  // Unsent reply bytes before a connection is dropped
+    int listenFd;
+    std::string unixPath;                // Socket file to remove on exit
+    int stopRead;                        // Self-pipe for stop()
+    int stopWrite;
+    std::atomic<bool> stopping;
+    std::atomic<uint64_t> sessions;
+    std::vector<Shard*> shards;
+
+    /**
+     * Accept connections and deal them out to the shards round-robin
+     */
+    void acceptLoop();
+
+    /**
+     * Event loop of one shard
+     */
+    void shardLoop(Shard& shard);
+
+    /**
+     * Read from a connection and handle every complete frame
+     * @return false if the connection should be closed, including when it
+     *         holds too much unhandled input or unsent output
+     */
+    bool readConnection(Shard& shard, Connection& connection);
+
+    /**
+     * Handle one client frame and queue its reply
+     */
+    void handleFrame(Shard& shard, Connection& connection, const uint8_t* frame, size_t length);
+
+    /**
+     * Send as much queued output as the socket takes
+     * @return false if the connection failed
+     */
+    bool flushConnection(Connection& connection);
+
+    /**
+     * Queue an ERROR frame
+     */
+    static void queueError(Connection& connection, ErrorCode code);
+
+    /**
+     * Create the self-pipe of a shard or of stop()
+     */
+    static void makePipe(int& readFd, int& writeFd);
+};
+
+#endif // GAME_SERVER_H
@@ -0,0 +1,83 @@
+// game_session.cpp
+
+#include "game_session.h"
+#include <stdexcept>
+
+/**
+ * Constructor
+ */
+GameSession::GameSession() : board(nullptr) {}
+
+/**
+ * Destructor
+ */
+GameSession::~GameSession() {
+    delete board;
+}
+
+void GameSession::newGame(int size, int ghostCount) {
+    delete board;
+    board = nullptr;
+    board = new Board(size, ghostCount);
+}
+
+void GameSession::loadGame(const std::string& fileName) {
+    Board* loaded = new Board(fileName);
+    delete board;
+    board = loaded;
+}
+
+void GameSession::saveGame(const std::string& fileName) {
+    if (board == nullptr) {
+        throw std::runtime_error(Board::IO_EXCEPTION);
+    }
+    board->saveBoard(fileName);
+}
+
+bool GameSession::hasGame() const {
+    return board != nullptr;
+}
+
+bool GameSession::isFinished() const {
+    return board != nullptr && (board->getIsGameOver() || board->getDotsRemaining() == 0);
+}
+
+/**
+ * Apply moves until they run out or the game ends
+ */
+int GameSession::move(const Direction* moves, int count) {
+    if (board == nullptr) {
+        return 0;
+    }
+    int applied = 0;
+    while (applied < count && !isFinished()) {
+        board->move(moves[applied]);
+        applied++;
+    }
+    return applied;
+}
+
+/**
+ * Build a STATE frame from the board
+ */
+StateFrame GameSession::getState() const {
+    StateFrame state{GameStatus::PLAYING, 0, 0, 0, 0, 0};
+    if (board == nullptr) {
+        return state;
+    }
+    if (board->getIsGameOver()) {
+        state.status = GameStatus::CAUGHT;
+    } else if (board->getDotsRemaining() == 0) {
+        state.status = GameStatus::CLEARED;
+    }
+    state.score = static_cast<uint32_t>(board->getScore());
+    state.ticks = static_cast<uint32_t>(board->getTickCount());
+    state.dotsRemaining = static_cast<uint32_t>(board->getDotsRemaining());
+    state.pacmanRow = static_cast<uint16_t>(board->getPacman()->getRow());
+    state.pacmanCol = static_cast<uint16_t>(board->getPacman()->getCol());
+    return state;
+}
+
+const Board* GameSession::getBoard() const {
+    return board;
+}
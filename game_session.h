@@ -0,0 +1,84 @@
+// game_session.h
+
+#ifndef GAME_SESSION_H
+#define GAME_SESSION_H
+
+#include <string>
+#include "Board.h"
+#include "Direction.h"
+#include "game_protocol.h"
+
+/**
+ * GameSession class - one game driven by a program instead of a person
+ * Like GameManager without the terminal: no prompts, no board output
+ * unless asked for. Used by the game server and the batch protocol.
+ */
+class GameSession {
+public:
+    /**
+     * Constructor - a session without a game
+     */
+    GameSession();
+
+    /**
+     * Destructor - cleans up board memory
+     */
+    ~GameSession();
+
+    GameSession(const GameSession&) = delete;
+    GameSession& operator=(const GameSession&) = delete;
+
+    /**
+     * Start a new game, replacing the current one
+     * @param size The size of the square board (at least 3)
+     * @param ghostCount Number of ghosts (at least 1)
+     */
+    void newGame(int size, int ghostCount);
+
+    /**
+     * Start a game from a saved board, replacing the current one
+     * @param fileName The file to load from
+     * @throws std::runtime_error if the file cannot be read
+     */
+    void loadGame(const std::string& fileName);
+
+    /**
+     * Save the current game to a file
+     * @param fileName The file to save to
+     * @throws std::runtime_error if there is no game or the file cannot be written
+     */
+    void saveGame(const std::string& fileName);
+
+    /**
+     * Check if a game was started
+     */
+    bool hasGame() const;
+
+    /**
+     * Check if the game has ended (caught or board cleared)
+     */
+    bool isFinished() const;
+
+    /**
+     * Apply moves in order, stopping early when the game ends
+     * @param moves The moves to apply
+     * @param count Number of moves
+     * @return Number of moves applied
+     */
+    int move(const Direction* moves, int count);
+
+    /**
+     * Get the current game state
+     */
+    StateFrame getState() const;
+
+    /**
+     * Get the board (nullptr before the first game)
+     */
+    const Board* getBoard() const;
+
+private:
+    Board* board;
+};
+
+#endif // GAME_SESSION_H
@@ -0,0 +1,549 @@
+// game_view.cpp
+
+#include "game_view.h"
+#include "assets.h"
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <iterator>
+#include <cstdio>
+#include <algorithm>
+
+// Colors used by the view
+namespace {
+const RenderColor BLACK(0, 0, 0);
+const RenderColor WHITE(255, 255, 255);
+const RenderColor RED(255, 0, 0);
+const RenderColor YELLOW(255, 255, 0);
+const RenderColor ORANGE(255, 165, 0);
+const RenderColor USC_GOLD(255, 204, 0);
+const RenderColor USC_CARDINAL(153, 27, 30);
+const RenderColor LIGHT_GRAY(200, 200, 200);
+const RenderColor WALL_BLUE(33, 33, 222);
+}
+
+/**
+ * Constructor
+ */
+GameView::GameView(Renderer& renderer) : renderer(renderer), textBuffer() {}
+
+namespace {
+
+/**
+ * TextureAsset - texture name and the embedded file it is decoded from
+ */
+struct TextureAsset {
+    const char* name;
+    const char* path;
+};
+
+constexpr TextureAsset TEXTURE_ASSETS[] = {
+    {"pacman_right", "image/pacman_right.png"},
+    {"pacman_dead", "image/pacman_dead.png"},
+    {"blinky", "image/blinky_left.png"},
+    {"clyde", "image/clyde_up.png"},
+    {"inky", "image/inky_down.png"},
+    {"pinky", "image/pinky_left.png"},
+    {"ghostblue", "image/ghostblue.png"},
+    {"dot_uneaten", "image/dot_uneaten.png"},
+    {"dot_eaten", "image/dot_eaten.png"},
+    {"cherry", "image/cherry.png"},
+    {"fight_on", "image/fight_on.png"},
+    {"beat_bruins", "image/beat_bruins.png"}
+};
+
+constexpr int FONT_ASSET = findAsset("fonts/DejaVuSans-Bold.ttf");
+
+constexpr bool allTexturesEmbedded() {
+    for (const TextureAsset& texture : TEXTURE_ASSETS) {
+        if (findAsset(texture.path) < 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(allTexturesEmbedded(), "a texture is missing from the asset bundle");
+static_assert(FONT_ASSET >= 0, "the fallback font is missing from the asset bundle");
+
+} // namespace
+
+/**
+ * Load textures and font, reporting how long startup asset loading took
+ */
+void GameView::loadAssets() {
+    auto start = std::chrono::steady_clock::now();
+
+    ThreadPool pool;
+    loadTextures(pool);
+    auto texturesDone = std::chrono::steady_clock::now();
+
+    if (!loadFont()) {
+        std::cerr << "Warning: Could not load font" << std::endl;
+    }
+    auto fontDone = std::chrono::steady_clock::now();
+
+    std::cout << "Assets loaded in "
+              << std::chrono::duration<double, std::milli>(fontDone - start).count() << " ms"
+              << " (textures: " << std::chrono::duration<double, std::milli>(texturesDone - start).count()
+              << " ms on " << pool.size() << " threads"
+              << ", font: " << std::chrono::duration<double, std::milli>(fontDone - texturesDone).count()
+              << " ms)" << std::endl;
+}
+
+/**
+ * Load all textures from the embedded asset bundle
+ */
+void GameView::loadTextures(ThreadPool& pool) {
+    std::vector<TextureData> images;
+    images.reserve(std::size(TEXTURE_ASSETS));
+    for (const TextureAsset& texture : TEXTURE_ASSETS) {
+        EmbeddedAsset asset = getAsset(findAsset(texture.path));
+        images.push_back(TextureData{texture.name, asset.data, asset.size});
+    }
+
+    std::vector<bool> loaded = renderer.loadTextures(images, pool);
+    for (size_t i = 0; i < images.size(); i++) {
+        if (!loaded[i]) {
+            std::cerr << "Warning: Could not load texture: " << TEXTURE_ASSETS[i].path << std::endl;
+        }
+    }
+}
+
+/**
+ * Load the font from the embedded asset bundle
+ */
+bool GameView::loadFont() {
+    EmbeddedAsset font = getAsset(FONT_ASSET);
+    return renderer.loadFont(font.data, font.size);
+}
+
+int GameView::windowWidth(int boardSize) {
+    return boardSize * TILE_SIZE + 2 * PADDING;
+}
+
+int GameView::windowHeight(int boardSize) {
+    return (boardSize + 2) * TILE_SIZE + 2 * PADDING + HUD_HEIGHT;
+}
+
+/**
+ * Render the game based on current state
+ */
+void GameView::render(const ViewState& state) {
+    renderer.clear(BLACK);
+
+    switch (state.gameState) {
+        case GameState::START_SCREEN:
+            drawStartScreen(state);
+            break;
+
+        case GameState::PLAYING:
+            drawUI(state);
+            drawBoard(state);
+            // Draw cherry on top if it exists
+            if (state.board != nullptr && state.hasCherryOnBoard &&
+                state.cherryRow >= 0 && state.cherryCol >= 0) {
+                drawCherry(state.cherryRow, state.cherryCol);
+            }
+            drawLives(state);
+            break;
+
+        case GameState::PAUSED:
+            drawUI(state);
+            drawBoard(state);
+            // Draw cherry on top if it exists
+            if (state.board != nullptr && state.hasCherryOnBoard &&
+                state.cherryRow >= 0 && state.cherryCol >= 0) {
+                drawCherry(state.cherryRow, state.cherryCol);
+            }
+            drawLives(state);
+            drawPauseMenu();
+            break;
+
+        case GameState::GAME_OVER:
+            drawUI(state);
+            drawBoard(state);
+            drawLives(state);
+            drawGameOver(state);
+            break;
+
+        case GameState::YOU_WIN:
+            drawUI(state);
+            drawBoard(state);
+            drawLives(state);
+            drawWinScreen(state);
+            break;
+    }
+
+    renderer.display();
+}
+
+/**
+ * Draw every tile of the board
+ */
+void GameView::drawBoard(const ViewState& state) {
+    if (state.board == nullptr) return;
+
+    int gridSize = state.board->getGridSize();
+    for (int row = 0; row < gridSize; row++) {
+        for (int col = 0; col < gridSize; col++) {
+            char tileChar = state.board->getGridChar(row, col);
+            drawTile(tileChar, row, col, state.lastDirection);
+        }
+    }
+}
+
+/**
+ * Draw start screen
+ */
+void GameView::drawStartScreen(const ViewState& state) {
+    // Get window dimensions for dynamic scaling
+    float winW = static_cast<float>(renderer.getWidth());
+    float winH = static_cast<float>(renderer.getHeight());
+    float scaleFactor = getScaleFactor();
+    unsigned texW = 0, texH = 0;
+
+    // "BEAT THE BRUINS" banner at top
+    if (renderer.getTextureSize("beat_bruins", texW, texH)) {
+        float scale = (winW * 0.7f) / texW;
+        if (scale > 1.5f) scale = 1.5f;  // Cap the scale
+        drawCentered("beat_bruins", winW / 2.0f, winH * 0.08f, scale);
+    } else {
+        renderer.drawText("BEAT THE BRUINS!", static_cast<unsigned int>(30 * scaleFactor),
+                          USC_CARDINAL, winW / 2.0f, winH * 0.08f, TextAlign::CENTER, true);
+    }
+
+    // Title - TROJAN PAC-MAN (positioned ABOVE the Pac-Man image)
+    renderer.drawText("USC PAC-MAN", static_cast<unsigned int>(35 * scaleFactor),
+                      USC_GOLD, winW / 2.0f, winH * 0.18f, TextAlign::CENTER, true);
+
+    // Draw Trojan Pac-Man image - dynamically sized
+    if (renderer.getTextureSize("pacman_right", texW, texH)) {
+        // Scale Pac-Man based on window size
+        float pacScale = (winW * 0.4f) / texW;
+        if (pacScale > 1.2f) pacScale = 1.2f;  // Cap maximum size
+        if (pacScale < 0.3f) pacScale = 0.3f;  // Minimum size
+        drawCentered("pacman_right", winW / 2.0f, winH * 0.45f, pacScale);
+    }
+
+    // High Score - YELLOW color for visibility
+    renderer.drawText(formatText("High Score: ", state.highScore),
+                      static_cast<unsigned int>(22 * scaleFactor),
+                      USC_GOLD, winW / 2.0f, winH * 0.72f, TextAlign::CENTER, true);
+
+    // Instructions
+    renderer.drawText("Press ENTER or SPACE to Start", static_cast<unsigned int>(18 * scaleFactor),
+                      USC_GOLD, winW / 2.0f, winH * 0.82f, TextAlign::CENTER, false);
+
+    // Controls info
+    renderer.drawText("Controls: Arrow Keys or WASD | P to Pause | ESC to Quit",
+                      static_cast<unsigned int>(12 * scaleFactor),
+                      RenderColor(180, 180, 180), winW / 2.0f, winH * 0.90f, TextAlign::CENTER, false);
+
+    // Co-author credits
+    renderer.drawText("Co-authored by Tony Yoo & Pranet Jagtap", static_cast<unsigned int>(10 * scaleFactor),
+                      RenderColor(140, 140, 140), winW / 2.0f, winH * 0.96f, TextAlign::CENTER, false);
+}
+
+/**
+ * Draw pause menu
+ */
+void GameView::drawPauseMenu() {
+    float winW = static_cast<float>(renderer.getWidth());
+    float winH = static_cast<float>(renderer.getHeight());
+
+    // Semi-transparent overlay
+    renderer.drawRect(0, 0, winW, winH, RenderColor(0, 0, 0, 150));
+
+    // Pause text
+    renderer.drawText("PAUSED", 50, YELLOW, winW / 2.0f, winH / 2.0f - 30, TextAlign::CENTER, true);
+
+    // Resume instruction
+    renderer.drawText("Press P or ENTER to Resume", 20, WHITE,
+                      winW / 2.0f, winH / 2.0f + 30, TextAlign::CENTER, false);
+
+    // Quit instruction
+    renderer.drawText("Press Q to Save and Quit", 18, LIGHT_GRAY,
+                      winW / 2.0f, winH / 2.0f + 70, TextAlign::CENTER, false);
+}
+
+/**
+ * Draw game over overlay - Shows "BEAT THE BRUINS" as motivation
+ */
+void GameView::drawGameOver(const ViewState& state) {
+    float winW = static_cast<float>(renderer.getWidth());
+    float winH = static_cast<float>(renderer.getHeight());
+    float scaleFactor = getScaleFactor();
+    unsigned texW = 0, texH = 0;
+    int score = state.board != nullptr ? state.board->getScore() : 0;
+
+    // Full screen UCLA blue overlay
+    renderer.drawRect(0, 0, winW, winH, RenderColor(39, 116, 174, 220)); // UCLA Blue
+
+    // "BEAT THE BRUINS" image or text - dynamically scaled
+    if (renderer.getTextureSize("beat_bruins", texW, texH)) {
+        float scale = (winW * 0.6f) / texW;
+        if (scale > 1.5f) scale = 1.5f;
+        drawCentered("beat_bruins", winW / 2.0f, winH * 0.25f, scale);
+    } else {
+        renderer.drawText("BEAT THE BRUINS!", static_cast<unsigned int>(35 * scaleFactor),
+                          WHITE, winW / 2.0f, winH * 0.25f, TextAlign::CENTER, true);
+    }
+
+    // "THE BRUINS GOT YOU!" text
+    renderer.drawText("THE BRUINS GOT YOU!", static_cast<unsigned int>(24 * scaleFactor),
+                      USC_GOLD, winW / 2.0f, winH * 0.45f, TextAlign::CENTER, true);
+
+    // Final score
+    renderer.drawText(formatText("Final Score: ", score), static_cast<unsigned int>(20 * scaleFactor),
+                      WHITE, winW / 2.0f, winH * 0.55f, TextAlign::CENTER, false);
+
+    // High score
+    if (score >= state.highScore) {
+        renderer.drawText("NEW HIGH SCORE!", static_cast<unsigned int>(18 * scaleFactor),
+                          YELLOW, winW / 2.0f, winH * 0.65f, TextAlign::CENTER, false);
+    } else {
+        renderer.drawText(formatText("High Score: ", state.highScore),
+                          static_cast<unsigned int>(18 * scaleFactor),
+                          LIGHT_GRAY, winW / 2.0f, winH * 0.65f, TextAlign::CENTER, false);
+    }
+
+    // Restart instruction
+    renderer.drawText("Press ENTER to Try Again | ESC to Quit", static_cast<unsigned int>(14 * scaleFactor),
+                      WHITE, winW / 2.0f, winH * 0.78f, TextAlign::CENTER, false);
+}
+
+/**
+ * Draw win screen
+ */
+void GameView::drawWinScreen(const ViewState& state) {
+    float winW = static_cast<float>(renderer.getWidth());
+    float winH = static_cast<float>(renderer.getHeight());
+    float scaleFactor = getScaleFactor();
+    unsigned texW = 0, texH = 0;
+    int score = state.board != nullptr ? state.board->getScore() : 0;
+
+    // Full screen USC Cardinal overlay
+    renderer.drawRect(0, 0, winW, winH, RenderColor(153, 27, 30, 220)); // USC Cardinal
+
+    // "FIGHT ON!" image or text - dynamically scaled
+    if (renderer.getTextureSize("fight_on", texW, texH)) {
+        float scale = (winW * 0.6f) / texW;
+        if (scale > 1.5f) scale = 1.5f;
+        drawCentered("fight_on", winW / 2.0f, winH * 0.25f, scale);
+    } else {
+        renderer.drawText("FIGHT ON!", static_cast<unsigned int>(50 * scaleFactor),
+                          USC_GOLD, winW / 2.0f, winH * 0.25f, TextAlign::CENTER, true);
+    }
+
+    // "YOU BEAT THE BRUINS!" text
+    renderer.drawText("YOU BEAT THE BRUINS!", static_cast<unsigned int>(24 * scaleFactor),
+                      USC_GOLD, winW / 2.0f, winH * 0.45f, TextAlign::CENTER, true);
+
+    // Final score
+    renderer.drawText(formatText("Final Score: ", score), static_cast<unsigned int>(20 * scaleFactor),
+                      WHITE, winW / 2.0f, winH * 0.55f, TextAlign::CENTER, false);
+
+    // High score
+    if (score >= state.highScore) {
+        renderer.drawText("NEW HIGH SCORE!", static_cast<unsigned int>(18 * scaleFactor),
+                          YELLOW, winW / 2.0f, winH * 0.65f, TextAlign::CENTER, false);
+    } else {
+        renderer.drawText(formatText("High Score: ", state.highScore),
+                          static_cast<unsigned int>(18 * scaleFactor),
+                          LIGHT_GRAY, winW / 2.0f, winH * 0.65f, TextAlign::CENTER, false);
+    }
+
+    // Restart instruction
+    renderer.drawText("Press ENTER to Play Again | ESC to Quit", static_cast<unsigned int>(14 * scaleFactor),
+                      WHITE, winW / 2.0f, winH * 0.78f, TextAlign::CENTER, false);
+}
+
+/**
+ * Draw a single tile
+ */
+void GameView::drawTile(char tileChar, int row, int col, Direction lastDirection) {
+    const char* texture = nullptr;
+    float rotation = 0;
+
+    switch (tileChar) {
+        case 'P':
+            texture = "pacman_right";
+            rotation = getPacmanRotation(lastDirection);
+            break;
+        case 'X':
+            texture = "pacman_dead";
+            break;
+        case 'G':
+        case 'A':
+            texture = "blinky";
+            break;
+        case 'B':
+            texture = "clyde";
+            break;
+        case 'C':
+            texture = "inky";
+            break;
+        case 'D':
+            texture = "pinky";
+            break;
+        case 'V':
+            texture = "ghostblue";
+            break;
+        case '*':
+            texture = "dot_uneaten";
+            break;
+        case ' ':
+            texture = "dot_eaten";
+            break;
+        case 'F':
+            texture = "cherry";
+            break;
+        default:
+            break;
+    }
+
+    float x = PADDING + col * TILE_SIZE;
+    float y = PADDING + HUD_HEIGHT + row * TILE_SIZE;
+
+    if (texture != nullptr && renderer.hasTexture(texture)) {
+        renderer.drawTexture(texture, x, y, TILE_SIZE, TILE_SIZE, rotation);
+        return;
+    }
+
+    RenderColor fill = BLACK;
+    switch (tileChar) {
+        case 'P':
+            fill = YELLOW;
+            break;
+        case 'G':
+        case 'A':
+        case 'B':
+        case 'C':
+        case 'D':
+            fill = RED;
+            break;
+        case 'V':
+            fill = WALL_BLUE;
+            break;
+        case 'X':
+            fill = ORANGE;
+            break;
+        case '*':
+            fill = WHITE;
+            break;
+        case 'o':
+            // Power pellet - a larger dot, no sprite of its own
+            renderer.drawRect(x + TILE_SIZE / 4, y + TILE_SIZE / 4, TILE_SIZE / 2, TILE_SIZE / 2, WHITE);
+            return;
+        case '#':
+            // Walls fill the whole tile so neighbouring walls join up
+            renderer.drawRect(x, y, TILE_SIZE, TILE_SIZE, WALL_BLUE);
+            return;
+        default:
+            break;
+    }
+    renderer.drawRect(x + 1, y + 1, TILE_SIZE - 2, TILE_SIZE - 2, fill);
+}
+
+/**
+ * Draw title, score, and high score
+ */
+void GameView::drawUI(const ViewState& state) {
+    float winW = static_cast<float>(renderer.getWidth());
+
+    // Title - USC themed
+    renderer.drawText("TROJAN PAC-MAN", 24, USC_GOLD, PADDING, 10, TextAlign::LEFT, false);
+
+    // Current Score
+    renderer.drawText(formatText("Score: ", state.board != nullptr ? state.board->getScore() : 0),
+                      18, WHITE, winW / 2.0f - 40, 15, TextAlign::LEFT, false);
+
+    // High Score
+    renderer.drawText(formatText("HI: ", state.highScore), 18, USC_CARDINAL,
+                      winW - 100, 15, TextAlign::LEFT, false);
+}
+
+/**
+ * Draw lives as Pac-Man icons
+ */
+void GameView::drawLives(const ViewState& state) {
+    float y = renderer.getHeight() - TILE_SIZE - 5;
+    unsigned texW = 0, texH = 0;
+    bool hasIcon = renderer.getTextureSize("pacman_right", texW, texH);
+
+    // Lives label
+    renderer.drawText("Lives:", 16, WHITE, PADDING, y + 15, TextAlign::LEFT, false);
+
+    // Draw Pac-Man icons for each life
+    for (int i = 0; i < state.lives; i++) {
+        if (hasIcon) {
+            float scale = 30.0f / texW;
+            renderer.drawTexture("pacman_right", PADDING + 60 + i * 35, y + 10,
+                                 texW * scale, texH * scale, 0);
+        } else {
+            renderer.drawCircle(PADDING + 60 + i * 35, y + 12, 12, YELLOW);
+        }
+    }
+}
+
+/**
+ * Draw cherry at specified position
+ */
+void GameView::drawCherry(int row, int col) {
+    if (!renderer.hasTexture("cherry")) return;
+
+    float x = PADDING + col * TILE_SIZE;
+    float y = PADDING + HUD_HEIGHT + row * TILE_SIZE;
+    renderer.drawTexture("cherry", x, y, TILE_SIZE, TILE_SIZE, 0);
+}
+
+/**
+ * Draw a texture centered at (x, y), scaled uniformly
+ */
+void GameView::drawCentered(const std::string& name, float x, float y, float scale) {
+    unsigned texW = 0, texH = 0;
+    if (!renderer.getTextureSize(name, texW, texH)) return;
+
+    float width = texW * scale;
+    float height = texH * scale;
+    renderer.drawTexture(name, x - width / 2.0f, y - height / 2.0f, width, height, 0);
+}
+
+/**
+ * Get Pac-Man rotation based on last direction
+ */
+float GameView::getPacmanRotation(Direction lastDirection) {
+    switch (lastDirection) {
+        case Direction::UP:
+            return 270.0f;
+        case Direction::DOWN:
+            return 90.0f;
+        case Direction::LEFT:
+            return 180.0f;
+        case Direction::RIGHT:
+        default:
+            return 0.0f;
+    }
+}
+
+/**
+ * Scale factor based on window size (baseline: 500px width)
+ */
+float GameView::getScaleFactor() const {
+    float scaleFactor = renderer.getWidth() / 500.0f;
+    if (scaleFactor < 0.5f) scaleFactor = 0.5f;  // Minimum scale
+    if (scaleFactor > 2.0f) scaleFactor = 2.0f;  // Maximum scale
+    return scaleFactor;
+}
+
+/**
+ * Format "<label><value>" into the view's text buffer without allocating
+ */
+std::string_view GameView::formatText(const char* label, int value) {
+    int length = std::snprintf(textBuffer, sizeof(textBuffer), "%s%d", label, value);
+    if (length < 0) {
+        length = 0;
+    }
+    return std::string_view(textBuffer, std::min(static_cast<size_t>(length), sizeof(textBuffer) - 1));
+}
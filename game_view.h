@@ -0,0 +1,167 @@
+// game_view.h
+
+#ifndef GAME_VIEW_H
+#define GAME_VIEW_H
+
+#include <string>
+#include <string_view>
+#include "Board.h"
+#include "Direction.h"
+#include "renderer.h"
+
+// Game states
+enum class GameState {
+    START_SCREEN,
+    PLAYING,
+    PAUSED,
+    GAME_OVER,
+    YOU_WIN
+};
+
+/**
+ * ViewState - everything GameView needs to draw one frame
+ */
+struct ViewState {
+    GameState gameState;
+    const Board* board;        // May be nullptr before the first game starts
+    Direction lastDirection;   // Used to rotate Pac-Man
+    int lives;
+    int highScore;
+    bool hasCherryOnBoard;
+    int cherryRow;
+    int cherryCol;
+};
+
+/**
+ * GameView class - draws the tile layer, sprites and HUD through a Renderer
+ * Independent of the rendering backend, so the same frames can be drawn
+ * into an SFML window or into a CPU framebuffer.
+ */
+class GameView {
+public:
+    // Layout constants
+    static const int TILE_SIZE = 50;
+    static const int PADDING = 10;
+    static const int HUD_HEIGHT = 50;
+
+    /**
+     * Constructor
+     * @param renderer The backend to draw with (must outlive the view)
+     */
+    GameView(Renderer& renderer);
+
+    /**
+     * Load all textures and the font into the renderer
+     * Assets come from the bundle compiled into the executable, so no
+     * files are opened; images are decoded in parallel and the time
+     * taken is printed.
+     */
+    void loadAssets();
+
+    /**
+     * Load all image textures into the renderer
+     * @param pool Worker threads used to decode the images
+     */
+    void loadTextures(ThreadPool& pool);
+
+    /**
+     * Load the embedded fallback font into the renderer
+     * @return true if the font was loaded
+     */
+    bool loadFont();
+
+    /**
+     * Draw one complete frame
+     * @param state The game state to draw
+     */
+    void render(const ViewState& state);
+
+    /**
+     * Get the window width needed for a board
+     * @param boardSize Size of the game board
+     */
+    static int windowWidth(int boardSize);
+
+    /**
+     * Get the window height needed for a board (extra room for title and lives)
+     * @param boardSize Size of the game board
+     */
+    static int windowHeight(int boardSize);
+
+private:
+    Renderer& renderer;
+    char textBuffer[64];   // Formatted HUD text, so frames do not allocate
+
+    /**
+     * Format a label followed by a number into textBuffer
+     * @return View of the text, valid until the next call
+     */
+    std::string_view formatText(const char* label, int value);
+
+    /**
+     * Draw every tile of the board
+     */
+    void drawBoard(const ViewState& state);
+
+    /**
+     * Draw a tile at the specified position
+     * @param tileChar The character representation of the tile
+     * @param row Row position
+     * @param col Column position
+     * @param lastDirection Direction used to rotate Pac-Man
+     */
+    void drawTile(char tileChar, int row, int col, Direction lastDirection);
+
+    /**
+     * Draw the score, title, and high score
+     */
+    void drawUI(const ViewState& state);
+
+    /**
+     * Draw start screen
+     */
+    void drawStartScreen(const ViewState& state);
+
+    /**
+     * Draw pause menu
+     */
+    void drawPauseMenu();
+
+    /**
+     * Draw game over overlay
+     */
+    void drawGameOver(const ViewState& state);
+
+    /**
+     * Draw win screen
+     */
+    void drawWinScreen(const ViewState& state);
+
+    /**
+     * Draw lives (Pac-Man icons)
+     */
+    void drawLives(const ViewState& state);
+
+    /**
+     * Draw cherry at specified position
+     */
+    void drawCherry(int row, int col);
+
+    /**
+     * Draw a texture centered at (x, y), scaled uniformly
+     */
+    void drawCentered(const std::string& name, float x, float y, float scale);
+
+    /**
+     * Get rotation angle for Pac-Man based on direction
+     * @return Rotation angle in degrees
+     */
+    static float getPacmanRotation(Direction lastDirection);
+
+    /**
+     * Get the text scale factor for the current window width
+     */
+    float getScaleFactor() const;
+};
+
+#endif // GAME_VIEW_H
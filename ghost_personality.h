@@ -0,0 +1,175 @@
+// ghost_personality.h
+// The four classic ghost personalities as compile-time policies
+
+#ifndef GHOST_PERSONALITY_H
+#define GHOST_PERSONALITY_H
+
+#include <cstdlib>
+#include <climits>
+#include "ipac_character.h"
+#include "nav_graph.h"
+
+/**
+ * GridTarget - a cell a ghost steers toward (may lie off the board)
+ */
+struct GridTarget {
+    int row;
+    int col;
+};
+
+/**
+ * GhostTargetContext - what the targeting rules look at, filled in by
+ * Board once per ghost group and tick
+ */
+struct GhostTargetContext {
+    int pacmanRow;
+    int pacmanCol;
+    Direction pacmanHeading;   // Pacman's last move (STAY before the first)
+    int blinkyRow;             // First Blinky, or Pacman if there is none
+    int blinkyCol;
+    int size;
+    bool scatter;              // Head for the policy's corner instead
+};
+
+namespace GhostTargeting {
+
+/**
+ * Get the cell some steps ahead of Pacman in the direction he last moved
+ */
+inline GridTarget ahead(const GhostTargetContext& context, int steps) {
+    return {context.pacmanRow + steps * DirectionHelper::getY(context.pacmanHeading),
+            context.pacmanCol + steps * DirectionHelper::getX(context.pacmanHeading)};
+}
+
+} // namespace GhostTargeting
+
+/**
+ * Blinky (red) - targets Pacman's cell; scatters to the top-right corner
+ */
+struct BlinkyPolicy {
+    static const char APPEARANCE = 'A';
+
+    static GridTarget corner(int size) {
+        return {0, size - 1};
+    }
+
+    static GridTarget target(const GhostTargetContext& context, int, int) {
+        return {context.pacmanRow, context.pacmanCol};
+    }
+};
+
+/**
+ * Pinky (pink) - targets four cells ahead of Pacman, to cut him off;
+ * scatters to the top-left corner
+ */
+struct PinkyPolicy {
+    static const char APPEARANCE = 'D';
+
+    static GridTarget corner(int) {
+        return {0, 0};
+    }
+
+    static GridTarget target(const GhostTargetContext& context, int, int) {
+        return GhostTargeting::ahead(context, 4);
+    }
+};
+
+/**
+ * Inky (cyan) - takes the cell two ahead of Pacman and doubles the
+ * vector from Blinky to it, so he closes in from the side Blinky is not on;
+ * scatters to the bottom-right corner
+ */
+struct InkyPolicy {
+    static const char APPEARANCE = 'C';
+
+    static GridTarget corner(int size) {
+        return {size - 1, size - 1};
+    }
+
+    static GridTarget target(const GhostTargetContext& context, int, int) {
+        GridTarget pivot = GhostTargeting::ahead(context, 2);
+        return {2 * pivot.row - context.blinkyRow, 2 * pivot.col - context.blinkyCol};
+    }
+};
+
+/**
+ * Clyde (orange) - targets Pacman while more than eight cells away, and
+ * the bottom-left corner (where he also scatters to) once closer
+ */
+struct ClydePolicy {
+    static const char APPEARANCE = 'B';
+    static const int SHY_DISTANCE = 8;
+
+    static GridTarget corner(int size) {
+        return {size - 1, 0};
+    }
+
+    static GridTarget target(const GhostTargetContext& context, int row, int col) {
+        int dy = context.pacmanRow - row;
+        int dx = context.pacmanCol - col;
+        if (dy * dy + dx * dx > SHY_DISTANCE * SHY_DISTANCE) {
+            return {context.pacmanRow, context.pacmanCol};
+        }
+        return corner(context.size);
+    }
+};
+
+/**
+ * PersonalityGhost class - a Ghost steered by a targeting policy
+ * Moves the classic way: at every cell the ghost takes the open move
+ * (UP, LEFT, DOWN, RIGHT on ties) whose next cell is closest in a
+ * straight line to its target, never turning back unless it has no
+ * other move. Board calls steer() on the concrete type, so no virtual
+ * call is made and the policy is inlined.
+ */
+template <typename Policy>
+class PersonalityGhost : public Ghost {
+public:
+    PersonalityGhost(int row, int col) : Ghost(row, col, Policy::APPEARANCE), heading(Direction::STAY) {}
+
+    /**
+     * Pick this tick's move and remember it as the heading
+     * @param context Pacman and Blinky this tick
+     * @param graph The moves of the board
+     */
+    Direction steer(const GhostTargetContext& context, const NavGraph& graph) {
+        GridTarget target = context.scatter ? Policy::corner(context.size) : Policy::target(context, row_, col_);
+        int cell = row_ * context.size + col_;
+        Direction reverse = DirectionHelper::opposite(heading);
+
+        const Direction order[] = {Direction::UP, Direction::LEFT, Direction::DOWN, Direction::RIGHT};
+        Direction best = Direction::STAY;
+        long long bestDistance = LLONG_MAX;
+        for (Direction direction : order) {
+            if (direction == reverse || !graph.canMove(cell, direction)) {
+                continue;
+            }
+            long long dy = row_ + DirectionHelper::getY(direction) - target.row;
+            long long dx = col_ + DirectionHelper::getX(direction) - target.col;
+            if (dy * dy + dx * dx < bestDistance) {
+                bestDistance = dy * dy + dx * dx;
+                best = direction;
+            }
+        }
+        // Dead end: the only way out is back
+        if (best == Direction::STAY && reverse != Direction::STAY && graph.canMove(cell, reverse)) {
+            best = reverse;
+        }
+        if (best != Direction::STAY) {
+            heading = best;
+        }
+        return best;
+    }
+
+    Direction getHeading() const { return heading; }
+
+private:
+    Direction heading;   // Last move, which the ghost will not undo
+};
+
+using Blinky = PersonalityGhost<BlinkyPolicy>;
+using Pinky = PersonalityGhost<PinkyPolicy>;
+using Inky = PersonalityGhost<InkyPolicy>;
+using Clyde = PersonalityGhost<ClydePolicy>;
+
+#endif // GHOST_PERSONALITY_H
@@ -0,0 +1,155 @@
+// ghost_script.cpp
+
+#include "ghost_script.h"
+#include "Board.h"
+#include <algorithm>
+
+void ScriptAction::await_suspend(std::coroutine_handle<> handle) noexcept {
+    self->current = handle;
+    self->action = *this;
+}
+
+std::coroutine_handle<> GhostScript::FinalAwaiter::await_suspend(Handle handle) noexcept {
+    promise_type& promise = handle.promise();
+    if (promise.continuation) {
+        promise.self->current = promise.continuation;
+        return promise.continuation;
+    }
+    return std::noop_coroutine();
+}
+
+void GhostScript::promise_type::operator delete(void* memory, size_t bytes) {
+    char* start = static_cast<char*>(memory) - ScriptArena::ALIGNMENT;
+    (*reinterpret_cast<ScriptArena**>(start))->release(start, bytes + ScriptArena::ALIGNMENT);
+}
+
+GhostScript::GhostScript(GhostScript&& other) noexcept : handle(other.handle) {
+    other.handle = nullptr;
+}
+
+GhostScript& GhostScript::operator=(GhostScript&& other) noexcept {
+    if (this != &other) {
+        if (handle) {
+            handle.destroy();
+        }
+        handle = other.handle;
+        other.handle = nullptr;
+    }
+    return *this;
+}
+
+/**
+ * Destructor - destroys the frame (and so every behaviour it awaits)
+ */
+GhostScript::~GhostScript() {
+    if (handle) {
+        handle.destroy();
+    }
+}
+
+bool GhostScript::done() const {
+    return !handle || handle.done();
+}
+
+void GhostScript::rethrowError() const {
+    if (handle && handle.promise().error) {
+        std::rethrow_exception(handle.promise().error);
+    }
+}
+
+std::coroutine_handle<> GhostScript::await_suspend(std::coroutine_handle<> parent) noexcept {
+    handle.promise().continuation = parent;
+    handle.promise().self->current = handle;
+    return handle;
+}
+
+/**
+ * Constructor - not attached to a board until Board::setGhostScript
+ */
+ScriptSelf::ScriptSelf()
+    : board(nullptr), index(-1), arena(nullptr),
+      action{ScriptAction::WAIT, Direction::STAY, {0, 0}, 0, nullptr}, lastMoved(false) {}
+
+int ScriptSelf::row() const {
+    return board->getGhosts()[index]->getRow();
+}
+
+int ScriptSelf::col() const {
+    return board->getGhosts()[index]->getCol();
+}
+
+int ScriptSelf::pacmanRow() const {
+    return board->getPacman()->getRow();
+}
+
+int ScriptSelf::pacmanCol() const {
+    return board->getPacman()->getCol();
+}
+
+int ScriptSelf::tick() const {
+    return board->getTickCount();
+}
+
+bool ScriptSelf::at(GridTarget target) const {
+    return row() == target.row && col() == target.col;
+}
+
+bool ScriptSelf::moved() const {
+    return lastMoved;
+}
+
+ScriptAction ScriptSelf::step(Direction direction) {
+    return {ScriptAction::STEP, direction, {0, 0}, 0, this};
+}
+
+ScriptAction ScriptSelf::toward(GridTarget target) {
+    return {ScriptAction::TOWARD, Direction::STAY, target, 0, this};
+}
+
+ScriptAction ScriptSelf::chase() {
+    return {ScriptAction::CHASE, Direction::STAY, {0, 0}, 0, this};
+}
+
+ScriptAction ScriptSelf::wait(int ticks) {
+    return {ScriptAction::WAIT, Direction::STAY, {0, 0}, ticks, this};
+}
+
+// Coroutine frames pair the promise's operator new (which takes the
+// coroutine's arguments) with its usual operator delete, as the standard
+// requires; GCC 12 takes that for a mismatch
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+namespace GhostScripts {
+
+GhostScript walkTo(ScriptSelf& self, GridTarget target) {
+    while (!self.at(target)) {
+        co_await self.toward(target);
+        if (!self.moved()) {
+            co_return;
+        }
+    }
+}
+
+GhostScript chaseFor(ScriptSelf& self, int ticks) {
+    for (int i = 0; i < ticks; i++) {
+        co_await self.chase();
+    }
+}
+
+GhostScript patrol(ScriptSelf& self, std::vector<GridTarget> waypoints, int waitTicks, int chaseTicks) {
+    for (;;) {
+        for (const GridTarget& waypoint : waypoints) {
+            co_await walkTo(self, waypoint);
+        }
+        co_await self.wait(std::max(waitTicks, 1));
+        co_await chaseFor(self, chaseTicks);
+    }
+}
+
+std::vector<GridTarget> corners(int size) {
+    return {{0, 0}, {0, size - 1}, {size - 1, size - 1}, {size - 1, 0}};
+}
+
+} // namespace GhostScripts
@@ -0,0 +1,205 @@
+// ghost_script.h
+// Ghost behaviours written as C++20 coroutines
+
+#ifndef GHOST_SCRIPT_H
+#define GHOST_SCRIPT_H
+
+#include <coroutine>
+#include <exception>
+#include <vector>
+#include "Direction.h"
+#include "ghost_personality.h"
+#include "script_arena.h"
+
+class Board;
+class ScriptSelf;
+
+/**
+ * ScriptAction - what a script asked its ghost to do this tick
+ */
+struct ScriptAction {
+    enum Kind {
+        STEP,     // Move one cell in direction (if open)
+        TOWARD,   // Move one cell along a shortest path to target
+        CHASE,    // Move the way a chaser would
+        WAIT      // Stay for ticks ticks
+    };
+
+    Kind kind;
+    Direction direction;
+    GridTarget target;
+    int ticks;
+    ScriptSelf* self;
+
+    // Awaiting an action ends the script's turn; Board carries it out and
+    // resumes the script on a later tick. Waiting no ticks does not suspend.
+    bool await_ready() const noexcept { return kind == WAIT && ticks <= 0; }
+    void await_suspend(std::coroutine_handle<> handle) noexcept;
+    void await_resume() const noexcept {}
+};
+
+/**
+ * GhostScript class - a running ghost behaviour (the coroutine's return
+ * type)
+ * A behaviour is any coroutine returning GhostScript whose first parameter
+ * is the ScriptSelf of the ghost it drives; its frame is allocated from
+ * that ghost's board's ScriptArena. Inside, it awaits actions
+ * (co_await self.toward(...)) or other behaviours (co_await walkTo(self,
+ * ...)), which run until they return.
+ *
+ * Scripts start suspended; Board::setGhostScript takes ownership and the
+ * board resumes the innermost running behaviour once per tick. Destroying
+ * a GhostScript destroys its frame and every behaviour it is awaiting.
+ */
+class GhostScript {
+public:
+    struct promise_type;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    /**
+     * Resumes the awaiting behaviour when a nested one returns
+     */
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+        std::coroutine_handle<> await_suspend(Handle handle) noexcept;
+        void await_resume() const noexcept {}
+    };
+
+    struct promise_type {
+        ScriptSelf* self;
+        std::coroutine_handle<> continuation;   // Awaiting behaviour, or null for a root
+        std::exception_ptr error;
+
+        template <typename... Args>
+        promise_type(ScriptSelf& self, const Args&...) : self(&self) {}
+
+        template <typename... Args>
+        static void* operator new(size_t bytes, ScriptSelf& self, const Args&...);
+        static void operator delete(void* memory, size_t bytes);
+
+        GhostScript get_return_object() { return GhostScript(Handle::from_promise(*this)); }
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        FinalAwaiter final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() { error = std::current_exception(); }
+    };
+
+    GhostScript() = default;
+    GhostScript(GhostScript&& other) noexcept;
+    GhostScript& operator=(GhostScript&& other) noexcept;
+    ~GhostScript();
+
+    GhostScript(const GhostScript&) = delete;
+    GhostScript& operator=(const GhostScript&) = delete;
+
+    /**
+     * Check if the behaviour has returned (or was never started)
+     */
+    bool done() const;
+
+    /**
+     * Rethrow what the behaviour threw, if it threw
+     */
+    void rethrowError() const;
+
+    // Awaiting a behaviour starts it at once and continues when it returns
+    bool await_ready() const noexcept { return false; }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> parent) noexcept;
+    void await_resume() const { rethrowError(); }
+
+private:
+    friend class Board;
+
+    Handle handle;
+
+    explicit GhostScript(Handle handle) : handle(handle) {}
+};
+
+/**
+ * ScriptSelf class - a script's view of its ghost, and the actions it
+ * can await
+ * Board keeps one per scripted ghost at a fixed address for as long as
+ * the script runs.
+ */
+class ScriptSelf {
+public:
+    ScriptSelf();
+
+    int row() const;
+    int col() const;
+    int pacmanRow() const;
+    int pacmanCol() const;
+
+    /**
+     * Get the board's tick count
+     */
+    int tick() const;
+
+    /**
+     * Check if the ghost is on a cell
+     */
+    bool at(GridTarget target) const;
+
+    /**
+     * Check if the ghost moved on its last action (false when the move
+     * was blocked or the target unreachable)
+     */
+    bool moved() const;
+
+    ScriptAction step(Direction direction);
+    ScriptAction toward(GridTarget target);
+    ScriptAction chase();
+    ScriptAction wait(int ticks);
+
+private:
+    friend class Board;
+    friend struct ScriptAction;
+    friend class GhostScript;
+
+    const Board* board;
+    int index;                        // In board->getGhosts()
+    ScriptArena* arena;
+    std::coroutine_handle<> current;  // Innermost running behaviour
+    ScriptAction action;              // Last action awaited
+    bool lastMoved;
+};
+
+template <typename... Args>
+void* GhostScript::promise_type::operator new(size_t bytes, ScriptSelf& self, const Args&...) {
+    // The arena is stored in front of the frame, for operator delete
+    void* memory = self.arena->allocate(bytes + ScriptArena::ALIGNMENT);
+    *static_cast<ScriptArena**>(memory) = self.arena;
+    return static_cast<char*>(memory) + ScriptArena::ALIGNMENT;
+}
+
+/**
+ * Stock behaviours
+ */
+namespace GhostScripts {
+
+/**
+ * Walk a shortest path to a cell; returns on arrival, or at once if the
+ * cell cannot be reached
+ */
+GhostScript walkTo(ScriptSelf& self, GridTarget target);
+
+/**
+ * Chase Pacman for some ticks
+ */
+GhostScript chaseFor(ScriptSelf& self, int ticks);
+
+/**
+ * Forever: visit the waypoints in order, wait, then chase for a while
+ * @param waitTicks Ticks to wait after the last waypoint (at least 1)
+ * @param chaseTicks Ticks to chase before starting over
+ */
+GhostScript patrol(ScriptSelf& self, std::vector<GridTarget> waypoints, int waitTicks, int chaseTicks);
+
+/**
+ * Get the corners of a board, clockwise from the top left
+ */
+std::vector<GridTarget> corners(int size);
+
+} // namespace GhostScripts
+
+#endif // GHOST_SCRIPT_H
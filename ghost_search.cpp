@@ -0,0 +1,395 @@
+// ghost_search.cpp
+
+#include "ghost_search.h"
+#include "thread_pool.h"
+#include "trace.h"
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
+namespace {
+
+const double CATCH_VALUE = 1e6;
+const double CATCH_PLY_COST = 1e3;      // A catch a ply later is worth this much less
+const double DISTANCE_WEIGHT = 10.0;
+const double DOT_WEIGHT = 3.0;          // PROBABILISTIC: odds of a move onto a dot
+const int FAR = 10000;                  // Distance of unreachable cells
+const int DOT_POINTS = 10;
+const int CLOCK_INTERVAL = 256;         // Nodes between clock checks
+
+// Root and Pacman moves, in tie-breaking order
+const Direction MOVES[] = {Direction::UP, Direction::DOWN, Direction::LEFT, Direction::RIGHT, Direction::STAY};
+
+} // namespace
+
+/**
+ * Constructor - starts a helper thread for every thread asked for beyond
+ * the caller's
+ */
+GhostSearch::GhostSearch(const NavGraph& graph, const DistanceTable* table, int size, const GhostSearchOptions& options)
+    : graph(graph), table(table), size(size), options(options), round(0), busy(0), stopping(false),
+      pacmanCell(-1), ghostCells(nullptr), planFor(nullptr), visited(nullptr), timed(false), stop(false),
+      rootDepth(0), nextTask(0) {
+    unsigned threads = options.threads == 0 ? ThreadPool::defaultThreadCount() : options.threads;
+    searchers.resize(threads);
+    size_t stack = static_cast<size_t>(options.maxDepth + 1) * (options.modelGhosts + 1);
+    for (Searcher& searcher : searchers) {
+        searcher.ghosts.reserve(options.modelGhosts + 1);
+        searcher.eaten.reserve(options.maxDepth + 1);
+        searcher.undo.reserve(stack);
+    }
+    helpers.reserve(threads - 1);
+    for (unsigned worker = 1; worker < threads; worker++) {
+        helpers.emplace_back(&GhostSearch::helperLoop, this, static_cast<int>(worker));
+    }
+}
+
+/**
+ * Destructor - stops and joins the helpers
+ */
+GhostSearch::~GhostSearch() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& helper : helpers) {
+        helper.join();
+    }
+}
+
+/**
+ * Depth 1, 2, ... until maxDepth or the budget: a depth cut short only
+ * updates the ghosts whose root moves all finished
+ */
+const std::vector<Direction>& GhostSearch::plan(int pacmanCell, const std::vector<int>& ghostCells,
+                                                const std::vector<char>& visited, const std::vector<int>& planFor) {
+    PAC_TRACE_SCOPE("GhostSearch::plan");
+    Clock::time_point start = Clock::now();
+    this->pacmanCell = pacmanCell;
+    this->ghostCells = &ghostCells;
+    this->planFor = &planFor;
+    this->visited = &visited;
+    timed = options.budgetMs > 0;
+    deadline = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(options.budgetMs));
+    stop = false;
+    stats = GhostSearchStats();
+    for (Searcher& searcher : searchers) {
+        searcher.nodes = 0;
+    }
+
+    // The ghosts nearest Pacman are the ones that can matter within a few plies
+    nearest.resize(ghostCells.size());
+    for (size_t i = 0; i < nearest.size(); i++) {
+        nearest[i] = static_cast<int>(i);
+    }
+    size_t keep = std::min(nearest.size(), static_cast<size_t>(options.modelGhosts + 1));
+    std::partial_sort(nearest.begin(), nearest.begin() + keep, nearest.end(), [&](int a, int b) {
+        int da = distance(ghostCells[a], pacmanCell);
+        int db = distance(ghostCells[b], pacmanCell);
+        return da != db ? da < db : a < b;
+    });
+    nearest.resize(keep);
+
+    // Root moves, and the chase move as each ghost's answer until a depth finishes
+    tasks.clear();
+    firstTask.clear();
+    moves.clear();
+    for (size_t slot = 0; slot < planFor.size(); slot++) {
+        int cell = ghostCells[planFor[slot]];
+        firstTask.push_back(static_cast<int>(tasks.size()));
+        for (Direction move : MOVES) {
+            if (move == Direction::STAY || graph.neighbour(cell, move) >= 0) {
+                tasks.push_back({static_cast<int>(slot), move, 0.0, false});
+            }
+        }
+        int next = chaseStep(cell, pacmanCell);
+        Direction chase = Direction::STAY;
+        for (Direction move : MOVES) {
+            if (move != Direction::STAY && graph.neighbour(cell, move) == next) {
+                chase = move;
+                break;
+            }
+        }
+        moves.push_back(chase);
+    }
+    firstTask.push_back(static_cast<int>(tasks.size()));
+
+    for (int depth = 1; depth <= options.maxDepth && !stop; depth++) {
+        runDepth(depth);
+
+        bool complete = true;
+        for (size_t slot = 0; slot < planFor.size(); slot++) {
+            bool finished = true;
+            double best = -std::numeric_limits<double>::infinity();
+            Direction choice = Direction::STAY;
+            for (int t = firstTask[slot]; t < firstTask[slot + 1]; t++) {
+                finished = finished && tasks[t].finished;
+                if (tasks[t].value > best) {
+                    best = tasks[t].value;
+                    choice = tasks[t].move;
+                }
+            }
+            if (finished) {
+                moves[slot] = choice;
+            }
+            complete = complete && finished;
+        }
+        if (complete) {
+            stats.depth = depth;
+        }
+        if (timed && Clock::now() >= deadline) {
+            break;
+        }
+    }
+
+    for (const Searcher& searcher : searchers) {
+        stats.nodes += searcher.nodes;
+    }
+    stats.ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    return moves;
+}
+
+void GhostSearch::reserve(size_t ghostCount) {
+    size_t rootMoves = sizeof(MOVES) / sizeof(MOVES[0]);
+    nearest.reserve(ghostCount);
+    tasks.reserve(ghostCount * rootMoves);
+    firstTask.reserve(ghostCount + 1);
+    moves.reserve(ghostCount);
+}
+
+const GhostSearchOptions& GhostSearch::getOptions() const {
+    return options;
+}
+
+const GhostSearchStats& GhostSearch::getLastStats() const {
+    return stats;
+}
+
+size_t GhostSearch::memoryUsage() const {
+    size_t bytes = nearest.capacity() * sizeof(int) + tasks.capacity() * sizeof(RootTask)
+                 + firstTask.capacity() * sizeof(int) + moves.capacity() * sizeof(Direction)
+                 + searchers.capacity() * sizeof(Searcher) + helpers.capacity() * sizeof(std::thread);
+    for (const Searcher& searcher : searchers) {
+        bytes += (searcher.ghosts.capacity() + searcher.eaten.capacity() + searcher.undo.capacity()) * sizeof(int);
+    }
+    return bytes;
+}
+
+/**
+ * The helpers are woken by bumping round, and the caller searches
+ * alongside them; nothing is queued, so a depth allocates nothing
+ */
+void GhostSearch::runDepth(int depth) {
+    for (RootTask& task : tasks) {
+        task.finished = false;
+    }
+    rootDepth = depth;
+    nextTask = 0;
+    if (!helpers.empty()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            busy = static_cast<unsigned>(helpers.size());
+            round++;
+        }
+        wake.notify_all();
+    }
+    takeTasks(searchers[0]);
+    if (!helpers.empty()) {
+        std::unique_lock<std::mutex> lock(mutex);
+        idle.wait(lock, [this]() { return busy == 0; });
+    }
+}
+
+void GhostSearch::helperLoop(int worker) {
+    unsigned seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&]() { return stopping || round != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = round;
+        }
+        takeTasks(searchers[worker]);
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--busy == 0) {
+            idle.notify_one();
+        }
+    }
+}
+
+/**
+ * Workers take tasks off a shared counter, so uneven subtrees still
+ * share out evenly
+ */
+void GhostSearch::takeTasks(Searcher& searcher) {
+    for (size_t t = nextTask++; t < tasks.size(); t = nextTask++) {
+        runTask(searcher, tasks[t]);
+    }
+}
+
+void GhostSearch::runTask(Searcher& searcher, RootTask& task) {
+    if (stop) {
+        return;
+    }
+    int ghost = (*planFor)[task.slot];
+    searcher.pacman = pacmanCell;
+    searcher.ghosts.clear();
+    searcher.ghosts.push_back((*ghostCells)[ghost]);
+    for (int other : nearest) {
+        if (other != ghost && static_cast<int>(searcher.ghosts.size()) <= options.modelGhosts) {
+            searcher.ghosts.push_back((*ghostCells)[other]);
+        }
+    }
+    searcher.eaten.clear();
+    searcher.undo.clear();
+    searcher.points = 0;
+    searcher.aborted = false;
+
+    if (task.move != Direction::STAY) {
+        searcher.ghosts[0] = graph.neighbour(searcher.ghosts[0], task.move);
+    }
+    const double infinity = std::numeric_limits<double>::infinity();
+    double value = othersThenPacman(searcher, rootDepth, 0, -infinity, infinity);
+    if (!searcher.aborted) {
+        task.value = value;
+        task.finished = true;
+    }
+}
+
+/**
+ * The planned ghost picks its best move; a move at least beta is as good
+ * as any, since Pacman would not let the game get here
+ */
+double GhostSearch::ghostTurn(Searcher& searcher, int depth, int ply, double alpha, double beta) {
+    int from = searcher.ghosts[0];
+    double best = -std::numeric_limits<double>::infinity();
+    for (Direction move : MOVES) {
+        int to = move == Direction::STAY ? from : graph.neighbour(from, move);
+        if (to < 0) {
+            continue;
+        }
+        searcher.ghosts[0] = to;
+        best = std::max(best, othersThenPacman(searcher, depth, ply, std::max(alpha, best), beta));
+        searcher.ghosts[0] = from;
+        if (searcher.aborted || best >= beta) {
+            break;
+        }
+    }
+    return best;
+}
+
+/**
+ * The other modelled ghosts chase, then Pacman replies
+ */
+double GhostSearch::othersThenPacman(Searcher& searcher, int depth, int ply, double alpha, double beta) {
+    if (searcher.ghosts[0] == searcher.pacman) {
+        return CATCH_VALUE - ply * CATCH_PLY_COST;
+    }
+    size_t mark = searcher.undo.size();
+    bool caught = false;
+    for (size_t i = 1; i < searcher.ghosts.size(); i++) {
+        searcher.undo.push_back(searcher.ghosts[i]);
+        searcher.ghosts[i] = chaseStep(searcher.ghosts[i], searcher.pacman);
+        caught = caught || searcher.ghosts[i] == searcher.pacman;
+    }
+    double value = caught ? CATCH_VALUE - ply * CATCH_PLY_COST : pacmanTurn(searcher, depth, ply + 1, alpha, beta);
+    for (size_t i = 1; i < searcher.ghosts.size(); i++) {
+        searcher.ghosts[i] = searcher.undo[mark + i - 1];
+    }
+    searcher.undo.resize(mark);
+    return value;
+}
+
+/**
+ * ADVERSARIAL takes the lowest value, cutting off below alpha (the ghost
+ * has a better move elsewhere); PROBABILISTIC the weighted mean, which
+ * needs every child exactly
+ */
+double GhostSearch::pacmanTurn(Searcher& searcher, int depth, int ply, double alpha, double beta) {
+    if (outOfTime(searcher)) {
+        return 0.0;
+    }
+    if (depth == 0) {
+        return evaluate(searcher);
+    }
+
+    int from = searcher.pacman;
+    bool adversarial = options.model == PacmanModel::ADVERSARIAL;
+    double best = std::numeric_limits<double>::infinity();
+    double total = 0.0;
+    double weights = 0.0;
+    for (Direction move : MOVES) {
+        int to = move == Direction::STAY ? from : graph.neighbour(from, move);
+        if (to < 0) {
+            continue;
+        }
+        bool dot = hasDot(searcher, to);
+        searcher.pacman = to;
+        if (dot) {
+            searcher.eaten.push_back(to);
+            searcher.points += DOT_POINTS;
+        }
+
+        double value;
+        if (std::find(searcher.ghosts.begin(), searcher.ghosts.end(), to) != searcher.ghosts.end()) {
+            value = CATCH_VALUE - ply * CATCH_PLY_COST;
+        } else {
+            value = adversarial ? ghostTurn(searcher, depth - 1, ply, alpha, std::min(beta, best))
+                                : ghostTurn(searcher, depth - 1, ply, -std::numeric_limits<double>::infinity(),
+                                            std::numeric_limits<double>::infinity());
+        }
+
+        if (dot) {
+            searcher.eaten.pop_back();
+            searcher.points -= DOT_POINTS;
+        }
+        searcher.pacman = from;
+        if (searcher.aborted) {
+            return 0.0;
+        }
+
+        double weight = dot ? DOT_WEIGHT : 1.0;
+        best = std::min(best, value);
+        total += weight * value;
+        weights += weight;
+        if (adversarial && best <= alpha) {
+            break;
+        }
+    }
+    return adversarial ? best : total / weights;
+}
+
+double GhostSearch::evaluate(const Searcher& searcher) const {
+    return -DISTANCE_WEIGHT * distance(searcher.ghosts[0], searcher.pacman) - searcher.points;
+}
+
+int GhostSearch::distance(int from, int to) const {
+    if (table != nullptr) {
+        uint16_t steps = table->distance(from, to);
+        return steps == DistanceTable::UNREACHABLE ? FAR : steps;
+    }
+    return std::abs(from / size - to / size) + std::abs(from % size - to % size);
+}
+
+int GhostSearch::chaseStep(int cell, int target) const {
+    Direction move = graph.chaseMove(cell, graph.towardMove(cell, target),
+                                     [&](int next) { return distance(next, target); });
+    return move == Direction::STAY ? cell : graph.neighbour(cell, move);
+}
+
+bool GhostSearch::hasDot(const Searcher& searcher, int cell) const {
+    return !(*visited)[cell] && std::find(searcher.eaten.begin(), searcher.eaten.end(), cell) == searcher.eaten.end();
+}
+
+bool GhostSearch::outOfTime(Searcher& searcher) {
+    if (++searcher.nodes % CLOCK_INTERVAL == 0 && timed && Clock::now() >= deadline) {
+        stop = true;
+    }
+    if (stop) {
+        searcher.aborted = true;
+    }
+    return searcher.aborted;
+}
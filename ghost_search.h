@@ -0,0 +1,215 @@
+// ghost_search.h
+
+#ifndef GHOST_SEARCH_H
+#define GHOST_SEARCH_H
+
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+#include "Direction.h"
+#include "nav_graph.h"
+#include "distance_table.h"
+
+/**
+ * How the search expects Pacman to answer
+ */
+enum class PacmanModel {
+    ADVERSARIAL,     // The reply worst for the ghosts (expectimax becomes minimax)
+    PROBABILISTIC    // Any legal move, moves onto dots three times as likely
+};
+
+/**
+ * GhostSearchOptions - limits of one tick's search
+ */
+struct GhostSearchOptions {
+    double budgetMs = 2.0;        // Per tick; 0 leaves only maxDepth
+    int maxDepth = 6;             // Pacman replies looked ahead
+    PacmanModel model = PacmanModel::ADVERSARIAL;
+    unsigned threads = 0;         // 0 means ThreadPool::defaultThreadCount()
+    int modelGhosts = 3;          // Other ghosts (nearest Pacman) moved in the model
+};
+
+/**
+ * GhostSearchStats - what the last plan() did
+ */
+struct GhostSearchStats {
+    int depth = 0;                // Deepest depth finished for every ghost
+    long long nodes = 0;          // Pacman nodes visited, leaves included
+    double ms = 0.0;
+};
+
+/**
+ * GhostSearch class - picks ghost moves by looking a few plies ahead
+ * Each planned ghost is searched on its own: at the root it tries every
+ * open move (and staying), the nearest other ghosts then step toward
+ * Pacman by the chase rule, Pacman replies per the PacmanModel, and so on
+ * down to the depth; leaves score the ghost's distance to Pacman and the
+ * dots he ate, and a catch scores more the sooner it comes. With the
+ * ADVERSARIAL model the search is minimax and prunes with alpha-beta.
+ *
+ * Searches run on a small state (Pacman's cell, the modelled ghosts' cells
+ * and the dots eaten along the line) that each move changes and undoes in
+ * place, so no board is ever copied. The root moves of every ghost are
+ * shared out over helper threads started with the search (the caller
+ * works too, and a depth is handed to them without allocating), and
+ * depths are searched one after another
+ * until the tick's budget runs out: a ghost keeps the move of the deepest
+ * depth all its root moves finished, so more cores buy deeper searches
+ * rather than longer ticks.
+ *
+ * Distances come from the board's DistanceTable; without one they are
+ * Manhattan distances, which ignore walls.
+ */
+class GhostSearch {
+public:
+    /**
+     * Constructor
+     * @param graph The moves of the board (must outlive the search)
+     * @param table The board's distance table, or null
+     * @param size The size of the square board
+     */
+    GhostSearch(const NavGraph& graph, const DistanceTable* table, int size, const GhostSearchOptions& options);
+    ~GhostSearch();
+
+    GhostSearch(const GhostSearch&) = delete;
+    GhostSearch& operator=(const GhostSearch&) = delete;
+
+    /**
+     * Choose moves for some ghosts
+     * @param pacmanCell Pacman's cell
+     * @param ghostCells Every ghost's cell
+     * @param visited The board's visited flags
+     * @param planFor Indices in ghostCells of the ghosts to move
+     * @return One move per planFor entry (reused by the next call)
+     */
+    const std::vector<Direction>& plan(int pacmanCell, const std::vector<int>& ghostCells,
+                                       const std::vector<char>& visited, const std::vector<int>& planFor);
+
+    /**
+     * Size plan()'s buffers for a number of ghosts, so that plans for up
+     * to that many never allocate
+     */
+    void reserve(size_t ghostCount);
+
+    const GhostSearchOptions& getOptions() const;
+    const GhostSearchStats& getLastStats() const;
+
+    /**
+     * Get the heap bytes this search owns (the helpers' stacks aside)
+     */
+    size_t memoryUsage() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * One root move of one ghost
+     */
+    struct RootTask {
+        int slot;             // Index in planFor
+        Direction move;
+        double value;
+        bool finished;
+    };
+
+    /**
+     * A worker's search state, changed and undone move by move
+     * Each on its own cache line, since every node writes to it.
+     */
+    struct alignas(64) Searcher {
+        int pacman;
+        std::vector<int> ghosts;     // [0] is the ghost being planned
+        std::vector<int> eaten;      // Dots eaten along the line
+        std::vector<int> undo;       // Ghost cells before the last moves
+        int points;
+        long long nodes;
+        bool aborted;
+    };
+
+    const NavGraph& graph;
+    const DistanceTable* table;
+    int size;
+    GhostSearchOptions options;
+    GhostSearchStats stats;
+
+    // Helpers run searchers[1..]; searchers[0] is the caller's
+    std::vector<std::thread> helpers;
+    std::mutex mutex;
+    std::condition_variable wake;    // Helpers wait here for the next depth
+    std::condition_variable idle;    // The caller waits here for the helpers
+    unsigned round;                  // Bumped for every depth handed out
+    unsigned busy;                   // Helpers still on the current depth
+    bool stopping;
+
+    // Per plan() call
+    int pacmanCell;
+    const std::vector<int>* ghostCells;
+    const std::vector<int>* planFor;
+    const std::vector<char>* visited;
+    Clock::time_point deadline;
+    bool timed;
+    std::atomic<bool> stop;
+    std::vector<int> nearest;        // Ghosts nearest Pacman, for the model
+    std::vector<RootTask> tasks;
+    std::vector<int> firstTask;      // Per slot, into tasks (one past the end last)
+    std::vector<Direction> moves;
+    std::vector<Searcher> searchers;
+
+    // Per depth
+    int rootDepth;
+    std::atomic<size_t> nextTask;
+
+    /**
+     * Run every root task at one depth, on the helpers if there are any
+     */
+    void runDepth(int depth);
+
+    /**
+     * Helper thread body - runs its searcher on every depth handed out
+     */
+    void helperLoop(int worker);
+
+    /**
+     * Take root tasks off the shared counter until none are left
+     */
+    void takeTasks(Searcher& searcher);
+
+    /**
+     * Score one root move
+     */
+    void runTask(Searcher& searcher, RootTask& task);
+
+    // Node values are the planned ghost's; alpha and beta bound the values
+    // that can still change a decision above (ADVERSARIAL only)
+    double ghostTurn(Searcher& searcher, int depth, int ply, double alpha, double beta);
+    double othersThenPacman(Searcher& searcher, int depth, int ply, double alpha, double beta);
+    double pacmanTurn(Searcher& searcher, int depth, int ply, double alpha, double beta);
+    double evaluate(const Searcher& searcher) const;
+
+    /**
+     * Get the steps between two cells
+     */
+    int distance(int from, int to) const;
+
+    /**
+     * Get the cell a ghost steps to by the chase rule (NavGraph::chaseMove)
+     */
+    int chaseStep(int cell, int target) const;
+
+    /**
+     * Check if a cell still holds a dot on the searcher's line
+     */
+    bool hasDot(const Searcher& searcher, int cell) const;
+
+    /**
+     * Check the clock every so many nodes and raise stop past the deadline
+     */
+    bool outOfTime(Searcher& searcher);
+};
+
+#endif // GHOST_SEARCH_H
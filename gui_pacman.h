@@ -5,17 +5,22 @@
 
 #include <SFML/Graphics.hpp>
 #include <string>
-#include <map>
+#include <chrono>
 #include "Board.h"
 #include "Direction.h"
+#include "game_view.h"
+#include "sfml_renderer.h"
+#include "pacman_autopilot.h"
 
-// Game states
-enum class GameState {
-    START_SCREEN,
-    PLAYING,
-    PAUSED,
-    GAME_OVER,
-    YOU_WIN
+/**
+ * GuiMemory - bytes held by the GUI game, by part
+ */
+struct GuiMemory {
+    size_t object;            // The GuiPacman itself (window, renderer and view included)
+    BoardMemory board;        // The current board (all zero between games)
+    RendererMemory renderer;  // Textures and text objects
+
+    size_t total() const { return object + board.total() + renderer.total(); }
 };
 
 /**
@@ -48,10 +53,33 @@ public:
      */
     void run();
 
+    /**
+     * Get the memory held by the game
+     * @return Bytes by part
+     */
+    GuiMemory memoryUsage() const;
+
+    /**
+     * Let a PacmanAutopilot play instead of the keyboard
+     * While a game runs it moves every moveMillis; P and Escape still
+     * pause, and the other keys only work on the menus.
+     * @param options Its search limits
+     * @param moveMillis Time between its moves in milliseconds
+     */
+    void setAutopilot(const AutopilotOptions& options, int moveMillis);
+
+    /**
+     * Get the autopilot (null unless setAutopilot was called)
+     */
+    const PacmanAutopilot* getAutopilot() const;
+
+    /**
+     * Get the current board (null before the first game)
+     */
+    const Board* getBoard() const;
+
 private:
     // Constants
-    static const int TILE_SIZE = 50;
-    static const int PADDING = 10;
     static const int INITIAL_LIVES = 3;
     
     // Game components
@@ -61,10 +89,6 @@ private:
     
     // SFML components
     sf::RenderWindow window;
-    sf::Font font;
-    
-    // Textures for game elements
-    std::map<std::string, sf::Texture> textures;
     
     // Direction tracking for Pac-Man rotation
     Direction lastDirection;
@@ -82,16 +106,24 @@ private:
     int cherryRow;
     int cherryCol;
 
+    // Rendering (draws into window)
+    SfmlRenderer renderer;
+    GameView view;
+
+    // Startup timing
+    std::chrono::steady_clock::time_point startTime;
+    bool firstFrameShown;
+
+    // Autopilot (null when the keyboard plays)
+    PacmanAutopilot* autopilot;
+    int autopilotMillis;
+    std::chrono::steady_clock::time_point nextAutopilotMove;
+
     /**
      * Initialize/Reset the game
      */
     void initGame();
 
-    /**
-     * Load all image textures
-     */
-    void loadTextures();
-
     /**
      * Handle keyboard input
      * @param event The SFML event
@@ -99,47 +131,19 @@ private:
     void handleInput(const sf::Event& event);
 
     /**
-     * Render the game
+     * Make the autopilot's move
      */
-    void render();
+    void autopilotMove();
 
     /**
-     * Draw a tile at the specified position
-     * @param tileChar The character representation of the tile
-     * @param row Row position
-     * @param col Column position
+     * Check for a lost life, the cherry and a cleared board after a move
      */
-    void drawTile(char tileChar, int row, int col);
+    void afterMove();
 
     /**
-     * Draw the score, title, and lives
+     * Render the game through the GameView
      */
-    void drawUI();
-
-    /**
-     * Draw start screen
-     */
-    void drawStartScreen();
-
-    /**
-     * Draw pause menu
-     */
-    void drawPauseMenu();
-
-    /**
-     * Draw game over overlay
-     */
-    void drawGameOver();
-
-    /**
-     * Draw win screen
-     */
-    void drawWinScreen();
-
-    /**
-     * Draw lives (Pac-Man icons)
-     */
-    void drawLives();
+    void render();
 
     /**
      * Check if player has won (all dots eaten)
@@ -156,17 +160,6 @@ private:
      */
     void placeCherry();
 
-    /**
-     * Draw cherry at specified position
-     */
-    void drawCherry(int row, int col);
-
-    /**
-     * Get rotation angle for Pac-Man based on direction
-     * @return Rotation angle in degrees
-     */
-    float getPacmanRotation();
-
     /**
      * Reset Pac-Man position after losing a life
      */
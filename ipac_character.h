@@ -29,13 +29,17 @@ public:
     virtual ~PacCharacter();
 
     // Getter functions - inherited by derived classes
-    int getRow() const;
-    int getCol() const;
-    char getAppearance() const;
+    // Defined here so calls inline into the tick loop
+    int getRow() const { return row_; }
+    int getCol() const { return col_; }
+    char getAppearance() const { return appearance_; }
 
     // Setter functions - inherited by derived classes  
-    void setPosition(int row, int col);
-    void setAppearance(char appearance);
+    void setPosition(int row, int col) {
+        row_ = row;
+        col_ = col;
+    }
+    void setAppearance(char appearance) { appearance_ = appearance; }
 
     /**
      * PURE VIRTUAL FUNCTION - Makes PacCharacter an ABSTRACT class
@@ -5,23 +5,46 @@
 #include <string>
 #include <vector>
 #include "game_pacman.h"
+#include "batch_driver.h"
+#include "trace.h"
+#include "pacman_autopilot.h"
 
-#define GUI_ENABLED
+// GUI_ENABLED is defined by the Makefile when building with SFML (GUI=1)
 #ifdef GUI_ENABLED
 #include "gui_pacman.h"   
 #endif
 
 const int DEFAULT_SIZE = 10;
 const std::string DEFAULT_FILE_NAME = "Pac-Man.board";
+const int DEFAULT_TICK_MILLIS = 200;
 
 void printUsage() {
     std::cout << "Pac-Man" << std::endl;
-    std::cout << "Usage: pacman [-g] [-s size] [-i inputFile] [-o outputFile]" << std::endl;
+    std::cout << "Usage: pacman [-g] [-s size] [-i inputFile] [-o outputFile] [--plain] [--no-color]" << std::endl;
+    std::cout << "              [-r] [--tick ms] [--fps n] [--trace file] [--mem-report]" << std::endl;
+    std::cout << "              [--autopilot] [--autopilot-ms ms] [--autopilot-playouts n] [--autopilot-threads n]" << std::endl;
+    std::cout << "       pacman --batch [--max-size n]" << std::endl;
     std::cout << std::endl;
     std::cout << "  -g         -> Run in GUI mode (requires SFML)" << std::endl;
     std::cout << "  -s [size]  -> Board size (default: 10)" << std::endl;
     std::cout << "  -i [file]  -> Load game from file" << std::endl;
     std::cout << "  -o [file]  -> Save game to file" << std::endl;
+    std::cout << "  --plain    -> Reprint the whole board each move (no cursor addressing)" << std::endl;
+    std::cout << "  --no-color -> Terminal mode without colors" << std::endl;
+    std::cout << "  -r         -> Real-time terminal mode (keys act immediately, p pauses)" << std::endl;
+    std::cout << "  --tick [ms]-> Real-time and GUI autopilot: milliseconds between moves (default: 200)" << std::endl;
+    std::cout << "  --fps [n]  -> Real-time: maximum frames per second (default: 30)" << std::endl;
+    std::cout << "  --trace [file] -> Record a Chrome trace (build with make TRACE=1)" << std::endl;
+    std::cout << "  --mem-report   -> GUI: print the game's memory by part on exit" << std::endl;
+    std::cout << "  --autopilot    -> Pac-Man plays himself by Monte Carlo tree search; prints its" << std::endl;
+    std::cout << "                    throughput as JSON at the end (without -r or -g, as fast as it searches)" << std::endl;
+    std::cout << "  --autopilot-ms [ms] -> Search time per move (default: 50, 0 for playouts only)" << std::endl;
+    std::cout << "  --autopilot-playouts [n] -> Playouts per thread and move (default: no limit)" << std::endl;
+    std::cout << "  --autopilot-threads [n]  -> Search threads (default: all cores)" << std::endl;
+    std::cout << "  --batch        -> Read driver commands on stdin, answer with status lines" << std::endl;
+    std::cout << "                    (commands: new load move state board save drop binary quit;" << std::endl;
+    std::cout << "                    see batch_driver.h)" << std::endl;
+    std::cout << "  --max-size [n] -> Batch: largest board new may start (default: 1000)" << std::endl;
 }
 
 int main(int argc, char** argv) {
@@ -32,6 +55,12 @@ int main(int argc, char** argv) {
     int boardSize = DEFAULT_SIZE;
     bool useGui = false;
     bool hasInput = false;
+    bool memReport = false;
+    bool batch = false;
+    int maxBoardSize = BatchDriver::DEFAULT_MAX_BOARD_SIZE;
+    bool autopilot = false;
+    AutopilotOptions autopilotOptions;
+    int tickMillis = DEFAULT_TICK_MILLIS;
     
     // Parse arguments
     for (size_t i = 1; i < args.size(); i++) {
@@ -49,6 +78,33 @@ int main(int argc, char** argv) {
             boardSize = std::stoi(args[++i]);
             if (boardSize < 3) boardSize = DEFAULT_SIZE;
         }
+        else if (args[i] == "--trace" && i + 1 < args.size()) {
+            Trace::start(args[++i]);
+        }
+        else if (args[i] == "--mem-report") {
+            memReport = true;
+        }
+        else if (args[i] == "--batch") {
+            batch = true;
+        }
+        else if (args[i] == "--max-size" && i + 1 < args.size()) {
+            maxBoardSize = std::stoi(args[++i]);
+        }
+        else if (args[i] == "--tick" && i + 1 < args.size()) {
+            tickMillis = std::stoi(args[++i]);
+        }
+        else if (args[i] == "--autopilot") {
+            autopilot = true;
+        }
+        else if (args[i] == "--autopilot-ms" && i + 1 < args.size()) {
+            autopilotOptions.budgetMs = std::stod(args[++i]);
+        }
+        else if (args[i] == "--autopilot-playouts" && i + 1 < args.size()) {
+            autopilotOptions.maxPlayouts = std::stoi(args[++i]);
+        }
+        else if (args[i] == "--autopilot-threads" && i + 1 < args.size()) {
+            autopilotOptions.threads = static_cast<unsigned>(std::stoul(args[++i]));
+        }
         else if (args[i] == "-h" || args[i] == "--help") {
             printUsage();
             return 0;
@@ -56,6 +112,14 @@ int main(int argc, char** argv) {
     }
     
     try {
+        if (batch) {
+            // Buffered stdin lets the driver batch its answers
+            std::ios::sync_with_stdio(false);
+            BatchDriver driver(std::cin, std::cout, maxBoardSize);
+            int errors = driver.run();
+            Trace::stop();
+            return errors > 0 ? 1 : 0;
+        }
         if (useGui) {
 #ifdef GUI_ENABLED
             GuiPacman* game;
@@ -64,10 +128,33 @@ int main(int argc, char** argv) {
             } else {
                 game = new GuiPacman(boardSize, outputFile);
             }
+            if (autopilot) {
+                game->setAutopilot(autopilotOptions, tickMillis);
+            }
             game->run();
+            if (autopilot) {
+                writeAutopilotReport(std::cout, game->getAutopilot()->getOptions(),
+                                     game->getAutopilot()->getTotalStats(), game->getBoard());
+            }
+            if (memReport) {
+                GuiMemory memory = game->memoryUsage();
+                std::cout << "{\"memory\": \"gui\""
+                          << ", \"object\": " << memory.object
+                          << ", \"board\": " << memory.board.total()
+                          << ", \"grid\": " << memory.board.grid
+                          << ", \"visited\": " << memory.board.visited
+                          << ", \"characters\": " << memory.board.characters
+                          << ", \"textures\": " << memory.renderer.textures
+                          << ", \"text\": " << memory.renderer.text
+                          << ", \"total\": " << memory.total() << "}" << std::endl;
+            }
             delete game;
 #else
-            std::cerr << "GUI mode not enabled. Recompile with GUI_ENABLED defined." << std::endl;
+            (void)hasInput;   // Board options are re-read by GamePacman
+            (void)memReport;
+            (void)autopilot;   // Re-read by GamePacman too
+            (void)tickMillis;
+            std::cerr << "GUI mode not enabled. Rebuild with make GUI=1 (requires SFML)." << std::endl;
             std::cerr << "Running in terminal mode instead..." << std::endl;
             GamePacman game;
             game.play(argc, argv);
@@ -79,8 +166,10 @@ int main(int argc, char** argv) {
         }
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
+        Trace::stop();
         return -1;
     }
     
+    Trace::stop();
     return 0;
 }
\ No newline at end of file
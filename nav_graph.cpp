@@ -0,0 +1,205 @@
+// nav_graph.cpp
+
+#include "nav_graph.h"
+#include "trace.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+
+const Direction MOVES[] = {Direction::UP, Direction::DOWN, Direction::LEFT, Direction::RIGHT};
+
+uint8_t bit(Direction direction) {
+    return static_cast<uint8_t>(1u << static_cast<int>(direction));
+}
+
+int openCount(uint8_t mask) {
+    return (mask & 1) + ((mask >> 1) & 1) + ((mask >> 2) & 1) + ((mask >> 3) & 1);
+}
+
+} // namespace
+
+/**
+ * Constructor
+ */
+NavGraph::NavGraph(int size, const std::vector<char>& walls) : size(size), wallCount(0) {
+    PAC_TRACE_SCOPE("NavGraph::build");
+    size_t cells = static_cast<size_t>(size) * size;
+    masks.assign(cells, 0);
+    for (int row = 0; row < size; row++) {
+        for (int col = 0; col < size; col++) {
+            int cell = row * size + col;
+            if (walls[cell]) {
+                wallCount++;
+                continue;
+            }
+            uint8_t mask = 0;
+            if (row > 0 && !walls[cell - size]) mask |= bit(Direction::UP);
+            if (row < size - 1 && !walls[cell + size]) mask |= bit(Direction::DOWN);
+            if (col > 0 && !walls[cell - 1]) mask |= bit(Direction::LEFT);
+            if (col < size - 1 && !walls[cell + 1]) mask |= bit(Direction::RIGHT);
+            masks[cell] = mask;
+        }
+    }
+
+    if (wallCount > 0) {
+        buildJunctions(walls);
+    }
+}
+
+uint8_t NavGraph::getMask(int cell) const {
+    return masks[cell];
+}
+
+Direction NavGraph::towardMove(int cell, int target) const {
+    int dx = target % size - cell % size;
+    int dy = target / size - cell / size;
+    if (dx == 0 && dy == 0) {
+        return Direction::STAY;
+    }
+    if (dy != 0 && (dx == 0 || std::abs(dy) > std::abs(dx))) {
+        return dy > 0 ? Direction::DOWN : Direction::UP;
+    }
+    return dx > 0 ? Direction::RIGHT : Direction::LEFT;
+}
+
+int NavGraph::getWallCount() const {
+    return wallCount;
+}
+
+int NavGraph::getJunctionCount() const {
+    return static_cast<int>(junctionCells.size());
+}
+
+int NavGraph::getJunction(int cell) const {
+    return junctionOf.empty() ? -1 : junctionOf[cell];
+}
+
+int NavGraph::getJunctionCell(int junction) const {
+    return junctionCells[junction];
+}
+
+int NavGraph::edgeBegin(int junction) const {
+    return edgeStart[junction];
+}
+
+int NavGraph::edgeEnd(int junction) const {
+    return edgeStart[junction + 1];
+}
+
+const NavEdge& NavGraph::getEdge(int edge) const {
+    return edges[edge];
+}
+
+/**
+ * Edges are grouped by junction, so the source is found in edgeStart
+ */
+int NavGraph::getEdgeSource(int edge) const {
+    return static_cast<int>(std::upper_bound(edgeStart.begin(), edgeStart.end(), edge) - edgeStart.begin()) - 1;
+}
+
+void NavGraph::getEdgeCells(int edge, std::vector<int32_t>& cells) const {
+    const NavEdge& corridor = edges[edge];
+    int cell = junctionCells[getEdgeSource(edge)];
+    Direction direction = corridor.first;
+    cells.clear();
+    cells.push_back(cell);
+    for (int32_t i = 0; i < corridor.length; i++) {
+        cell = step(cell, direction);
+        cells.push_back(cell);
+        Direction back = DirectionHelper::opposite(direction);
+        for (Direction next : MOVES) {
+            if (next != back && canMove(cell, next)) {
+                direction = next;
+                break;
+            }
+        }
+    }
+}
+
+int NavGraph::getCorridor(int cell) const {
+    return corridorOf.empty() ? -1 : corridorOf[cell];
+}
+
+int NavGraph::getCorridorOffset(int cell) const {
+    return corridorOffset.empty() ? 0 : corridorOffset[cell];
+}
+
+size_t NavGraph::memoryUsage() const {
+    return masks.capacity() * sizeof(uint8_t)
+         + (junctionOf.capacity() + junctionCells.capacity() + edgeStart.capacity()
+            + corridorOf.capacity() + corridorOffset.capacity()) * sizeof(int32_t)
+         + edges.capacity() * sizeof(NavEdge);
+}
+
+size_t NavGraph::estimateMemory(int size) {
+    return static_cast<size_t>(size) * size * sizeof(uint8_t);
+}
+
+/**
+ * Walls are passed in because an open cell boxed in by walls has an empty
+ * mask too; it becomes a junction without edges
+ */
+void NavGraph::buildJunctions(const std::vector<char>& walls) {
+    size_t cells = masks.size();
+    junctionOf.assign(cells, -1);
+    corridorOf.assign(cells, -1);
+    corridorOffset.assign(cells, 0);
+
+    for (size_t cell = 0; cell < cells; cell++) {
+        if (!walls[cell] && openCount(masks[cell]) != 2) {
+            junctionOf[cell] = static_cast<int32_t>(junctionCells.size());
+            junctionCells.push_back(static_cast<int32_t>(cell));
+        }
+    }
+
+    // Corridors out of every junction; junctions added on the way (for
+    // loops) get the next numbers, so edges stay grouped by junction
+    size_t cell = 0;
+    for (size_t junction = 0; ; junction++) {
+        while (junction == junctionCells.size() && cell < cells) {
+            if (!walls[cell] && junctionOf[cell] < 0 && corridorOf[cell] < 0) {
+                junctionOf[cell] = static_cast<int32_t>(junctionCells.size());
+                junctionCells.push_back(static_cast<int32_t>(cell));
+            }
+            cell++;
+        }
+        if (junction == junctionCells.size()) {
+            break;
+        }
+        edgeStart.push_back(static_cast<int32_t>(edges.size()));
+        for (Direction direction : MOVES) {
+            if (canMove(junctionCells[junction], direction)) {
+                edges.push_back(walk(junctionCells[junction], direction));
+            }
+        }
+    }
+    edgeStart.push_back(static_cast<int32_t>(edges.size()));
+}
+
+NavEdge NavGraph::walk(int start, Direction first) {
+    int32_t edge = static_cast<int32_t>(edges.size());
+    int cell = step(start, first);
+    Direction back = DirectionHelper::opposite(first);
+    int32_t length = 1;
+    while (junctionOf[cell] < 0) {
+        if (corridorOf[cell] < 0) {
+            corridorOf[cell] = edge;
+            corridorOffset[cell] = length;
+        }
+        // A corridor cell has exactly one way on besides the way back
+        for (Direction direction : MOVES) {
+            if (direction != back && canMove(cell, direction)) {
+                cell = step(cell, direction);
+                back = DirectionHelper::opposite(direction);
+                break;
+            }
+        }
+        length++;
+    }
+    return NavEdge{junctionOf[cell], length, first};
+}
+
+int NavGraph::step(int cell, Direction direction) const {
+    return cell + DirectionHelper::getY(direction) * size + DirectionHelper::getX(direction);
+}
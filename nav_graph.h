@@ -0,0 +1,185 @@
+// nav_graph.h
+
+#ifndef NAV_GRAPH_H
+#define NAV_GRAPH_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "Direction.h"
+
+/**
+ * NavEdge - a corridor between two junctions, seen from its start
+ */
+struct NavEdge {
+    int32_t to;          // Junction reached
+    int32_t length;      // Steps along the corridor
+    Direction first;     // Move that leaves the start junction
+};
+
+/**
+ * NavGraph class - where characters can move on a board, built once
+ * Every cell gets a mask of its open neighbours (bit 1 << Direction), so
+ * a movement check is a single bit test.
+ *
+ * Boards with walls also get a junction graph: cells with other than two
+ * open neighbours are junctions, and each corridor of two-neighbour cells
+ * between them collapses into one edge (stored both ways). A corridor
+ * that loops back without meeting a junction gets one of its cells as a
+ * junction. Boards without walls have no corridors to collapse - every
+ * inner cell is a junction - so they keep only the masks.
+ */
+class NavGraph {
+public:
+    /**
+     * Constructor - builds the masks and, if there are walls, the junction graph
+     * @param size The size of the square board
+     * @param walls One flag per cell (row * size + col), nonzero for walls
+     */
+    NavGraph(int size, const std::vector<char>& walls);
+
+    /**
+     * Check if a move out of a cell stays on the board and off walls
+     */
+    bool canMove(int cell, Direction direction) const {
+        return (masks[cell] >> static_cast<int>(direction)) & 1;
+    }
+
+    /**
+     * Get the open-neighbour mask of a cell (bit 1 << Direction)
+     */
+    uint8_t getMask(int cell) const;
+
+    /**
+     * Get the cell one move away, or -1 if the move is blocked (or STAY)
+     */
+    int neighbour(int cell, Direction direction) const {
+        return canMove(cell, direction) ? step(cell, direction) : -1;
+    }
+
+    /**
+     * Get the move a chaser ('G') prefers toward a target, as
+     * Ghost::decideMove: along the axis with the greater distance,
+     * horizontally on a tie
+     */
+    Direction towardMove(int cell, int target) const;
+
+    /**
+     * Get the move a ghost chasing by distance makes: the preferred move,
+     * then UP, DOWN, LEFT and RIGHT, taking a move only if it gets
+     * strictly closer. Board, GhostSearch and PacmanAutopilot all chase
+     * by this rule.
+     * @param distance Callable giving a cell's steps to the target
+     * @return The move, or STAY if none gets closer
+     */
+    template <typename Distance>
+    Direction chaseMove(int cell, Direction preferred, Distance&& distance) const {
+        const Direction order[] = {preferred, Direction::UP, Direction::DOWN, Direction::LEFT, Direction::RIGHT};
+        auto best = distance(cell);
+        Direction choice = Direction::STAY;
+        for (Direction direction : order) {
+            int next = neighbour(cell, direction);
+            if (next < 0) {
+                continue;
+            }
+            auto steps = distance(next);
+            if (steps < best) {
+                best = steps;
+                choice = direction;
+            }
+        }
+        return choice;
+    }
+
+    /**
+     * Get the number of wall cells
+     */
+    int getWallCount() const;
+
+    /**
+     * Get the number of junctions (0 for boards without walls)
+     */
+    int getJunctionCount() const;
+
+    /**
+     * Get the junction on a cell
+     * @return Junction number, or -1 for corridor and wall cells
+     */
+    int getJunction(int cell) const;
+
+    /**
+     * Get the cell of a junction
+     */
+    int getJunctionCell(int junction) const;
+
+    /**
+     * Get the edges leaving a junction, as indices for getEdge
+     */
+    int edgeBegin(int junction) const;
+    int edgeEnd(int junction) const;
+    const NavEdge& getEdge(int edge) const;
+
+    /**
+     * Get the junction an edge leaves from
+     */
+    int getEdgeSource(int edge) const;
+
+    /**
+     * Get the cells along an edge
+     * @param cells Filled with the start junction's cell (offset 0), the
+     *        corridor cells and the end junction's cell (offset length)
+     */
+    void getEdgeCells(int edge, std::vector<int32_t>& cells) const;
+
+    /**
+     * Get the corridor a cell lies on
+     * @return An edge through the cell, or -1 for junction and wall cells
+     */
+    int getCorridor(int cell) const;
+
+    /**
+     * Get the steps from the start junction of getCorridor(cell) to the cell
+     */
+    int getCorridorOffset(int cell) const;
+
+    /**
+     * Get the heap bytes this graph owns
+     */
+    size_t memoryUsage() const;
+
+    /**
+     * Predict memoryUsage() for a board without walls
+     */
+    static size_t estimateMemory(int size);
+
+private:
+    int size;
+    int wallCount;
+    std::vector<uint8_t> masks;
+
+    // Junction graph (empty without walls)
+    std::vector<int32_t> junctionOf;        // Per cell: junction number or -1
+    std::vector<int32_t> junctionCells;     // Per junction: its cell
+    std::vector<int32_t> edgeStart;         // Per junction + 1: first edge (CSR)
+    std::vector<NavEdge> edges;
+    std::vector<int32_t> corridorOf;        // Per cell: edge through it or -1
+    std::vector<int32_t> corridorOffset;    // Per cell: steps from that edge's start
+
+    /**
+     * Find the junctions, then walk every corridor leaving them
+     */
+    void buildJunctions(const std::vector<char>& walls);
+
+    /**
+     * Follow a corridor from a junction to the next junction
+     * @return The edge (its number is edges.size() once added)
+     */
+    NavEdge walk(int start, Direction first);
+
+    /**
+     * Get the cell one move away (the move must be open)
+     */
+    int step(int cell, Direction direction) const;
+};
+
+#endif // NAV_GRAPH_H
@@ -0,0 +1,187 @@
+// observation_encoder.cpp
+
+#include "observation_encoder.h"
+#include "trace.h"
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__SSE2__) && !defined(PACMAN_NO_SIMD)
+#include <emmintrin.h>
+#define PACMAN_SSE2 1
+#endif
+
+namespace {
+
+const char WALL = '#';
+
+} // namespace
+
+/**
+ * Constructor
+ */
+ObservationEncoder::ObservationEncoder(int size, int ghostCount, Format format)
+    : size(size), ghostCount(ghostCount), format(format),
+      pacmanCell(-1), cherryCell(-1), ghostCells(ghostCount > 0 ? ghostCount : 0, -1) {
+    if (size < 1 || ghostCount < 0) {
+        throw std::runtime_error("Invalid observation size");
+    }
+    cells = static_cast<size_t>(size) * size;
+    planeBytes = format == Format::UINT8 ? cells : (cells + 63) / 64 * 8;
+}
+
+int ObservationEncoder::getPlaneCount() const {
+    return FIRST_GHOST + ghostCount;
+}
+
+size_t ObservationEncoder::getPlaneBytes() const {
+    return planeBytes;
+}
+
+size_t ObservationEncoder::getBufferSize() const {
+    return planeBytes * getPlaneCount();
+}
+
+void ObservationEncoder::encode(const Board& board, uint8_t* out, int cherryRow, int cherryCol) {
+    PAC_TRACE_SCOPE("ObservationEncoder::encode");
+    checkBoard(board);
+    encodeCells(board, out);
+
+    // Character planes: cleared, then one cell each
+    std::memset(out + PACMAN * planeBytes, 0, (getPlaneCount() - PACMAN) * planeBytes);
+    const Pacman* pacman = board.getPacman();
+    pacmanCell = pacman->getRow() * size + pacman->getCol();
+    writeCell(out + PACMAN * planeBytes, pacmanCell, true);
+
+    cherryCell = cherryIndex(cherryRow, cherryCol);
+    if (cherryCell >= 0) {
+        writeCell(out + CHERRY * planeBytes, cherryCell, true);
+    }
+
+    const std::vector<Ghost*>& ghosts = board.getGhosts();
+    for (int g = 0; g < ghostCount; g++) {
+        ghostCells[g] = ghosts[g]->getRow() * size + ghosts[g]->getCol();
+        writeCell(out + (FIRST_GHOST + g) * planeBytes, ghostCells[g], true);
+    }
+}
+
+/**
+ * Only Pacman's new cell can change its visited flag, and it is always in
+ * the changed cells; characters are moved by clearing the cell they were
+ * last written on.
+ */
+void ObservationEncoder::update(const Board& board, uint8_t* out, int cherryRow, int cherryCol) {
+    PAC_TRACE_SCOPE("ObservationEncoder::update");
+    checkBoard(board);
+    for (int cell : board.getChangedCells()) {
+        encodeCell(board, out, cell);
+    }
+
+    const Pacman* pacman = board.getPacman();
+    int cell = pacman->getRow() * size + pacman->getCol();
+    if (cell != pacmanCell) {
+        writeCell(out + PACMAN * planeBytes, pacmanCell, false);
+        writeCell(out + PACMAN * planeBytes, cell, true);
+        pacmanCell = cell;
+    }
+
+    cell = cherryIndex(cherryRow, cherryCol);
+    if (cell != cherryCell) {
+        if (cherryCell >= 0) {
+            writeCell(out + CHERRY * planeBytes, cherryCell, false);
+        }
+        if (cell >= 0) {
+            writeCell(out + CHERRY * planeBytes, cell, true);
+        }
+        cherryCell = cell;
+    }
+
+    const std::vector<Ghost*>& ghosts = board.getGhosts();
+    for (int g = 0; g < ghostCount; g++) {
+        cell = ghosts[g]->getRow() * size + ghosts[g]->getCol();
+        if (cell != ghostCells[g]) {
+            uint8_t* plane = out + (FIRST_GHOST + g) * planeBytes;
+            writeCell(plane, ghostCells[g], false);
+            writeCell(plane, cell, true);
+            ghostCells[g] = cell;
+        }
+    }
+}
+
+void ObservationEncoder::checkBoard(const Board& board) const {
+    if (board.getGridSize() != size || static_cast<int>(board.getGhosts().size()) != ghostCount) {
+        throw std::runtime_error("Board does not match the observation encoder");
+    }
+}
+
+int ObservationEncoder::cherryIndex(int cherryRow, int cherryCol) const {
+    if (cherryRow < 0 || cherryRow >= size || cherryCol < 0 || cherryCol >= size) {
+        return -1;
+    }
+    return cherryRow * size + cherryCol;
+}
+
+void ObservationEncoder::writeCell(uint8_t* plane, int cell, bool on) const {
+    if (format == Format::UINT8) {
+        plane[cell] = on ? 1 : 0;
+        return;
+    }
+    uint8_t bit = static_cast<uint8_t>(1u << (cell & 7));
+    if (on) {
+        plane[cell >> 3] |= bit;
+    } else {
+        plane[cell >> 3] &= static_cast<uint8_t>(~bit);
+    }
+}
+
+/**
+ * 16 cells at a time with SSE2: the visited flags are already 0/1 bytes,
+ * walls come from comparing the grid with '#', and for bit planes
+ * movemask packs 16 comparisons into two bytes (x86 is little-endian, so
+ * the low byte holds the first eight cells)
+ */
+void ObservationEncoder::encodeCells(const Board& board, uint8_t* out) const {
+    size_t cell = 0;
+    if (format == Format::BITS) {
+        std::memset(out + WALLS * planeBytes, 0, 3 * planeBytes);
+    }
+
+#ifdef PACMAN_SSE2
+    const char* visited = board.getVisited().data();
+    const char* grid = board.getGrid().data();
+    uint8_t* walls = out + WALLS * planeBytes;
+    uint8_t* dots = out + DOTS * planeBytes;
+    uint8_t* seen = out + VISITED * planeBytes;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ones = _mm_set1_epi8(1);
+    const __m128i wall = _mm_set1_epi8(WALL);
+    for (; cell + 16 <= cells; cell += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(visited + cell));
+        __m128i w = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(grid + cell)), wall);
+        __m128i d = _mm_andnot_si128(w, _mm_cmpeq_epi8(v, zero));
+        if (format == Format::UINT8) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(walls + cell), _mm_and_si128(w, ones));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dots + cell), _mm_and_si128(d, ones));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(seen + cell), _mm_and_si128(v, ones));
+        } else {
+            uint16_t wallBits = static_cast<uint16_t>(_mm_movemask_epi8(w));
+            uint16_t dotBits = static_cast<uint16_t>(_mm_movemask_epi8(d));
+            uint16_t seenBits = static_cast<uint16_t>(~_mm_movemask_epi8(_mm_cmpeq_epi8(v, zero)));
+            std::memcpy(walls + cell / 8, &wallBits, 2);
+            std::memcpy(dots + cell / 8, &dotBits, 2);
+            std::memcpy(seen + cell / 8, &seenBits, 2);
+        }
+    }
+#endif
+
+    for (; cell < cells; cell++) {
+        encodeCell(board, out, static_cast<int>(cell));
+    }
+}
+
+void ObservationEncoder::encodeCell(const Board& board, uint8_t* out, int cell) const {
+    bool isWall = board.getGrid()[cell] == WALL;
+    bool isVisited = board.getVisited()[cell] != 0;
+    writeCell(out + WALLS * planeBytes, cell, isWall);
+    writeCell(out + DOTS * planeBytes, cell, !isWall && !isVisited);
+    writeCell(out + VISITED * planeBytes, cell, isVisited);
+}
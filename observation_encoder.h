@@ -0,0 +1,122 @@
+// observation_encoder.h
+
+#ifndef OBSERVATION_ENCODER_H
+#define OBSERVATION_ENCODER_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "Board.h"
+
+/**
+ * ObservationEncoder class - writes a Board as feature planes for learned policies
+ * Every plane covers the whole board (cell = row * size + col) and is
+ * written straight into a caller-owned buffer, plane after plane:
+ *   WALLS, DOTS, VISITED, PACMAN, CHERRY, then one plane per ghost
+ * in getGhosts() order.
+ *
+ * UINT8 planes hold one byte (0/1) per cell. BITS planes pack eight cells
+ * per byte, lowest bit first, padded to a multiple of 8 bytes.
+ *
+ * encode() writes every plane; update() then rewrites only what the last
+ * Board::move changed, so the buffer must not be touched in between.
+ */
+class ObservationEncoder {
+public:
+    enum class Format {
+        UINT8,
+        BITS
+    };
+
+    // Plane numbers; ghost g is plane FIRST_GHOST + g
+    static const int WALLS = 0;
+    static const int DOTS = 1;
+    static const int VISITED = 2;
+    static const int PACMAN = 3;
+    static const int CHERRY = 4;
+    static const int FIRST_GHOST = 5;
+
+    /**
+     * Constructor
+     * @param size The size of the boards to encode
+     * @param ghostCount Ghosts on those boards
+     * @param format Byte or bit planes
+     */
+    ObservationEncoder(int size, int ghostCount, Format format);
+
+    /**
+     * Get the number of planes (FIRST_GHOST + ghost count)
+     */
+    int getPlaneCount() const;
+
+    /**
+     * Get the bytes of one plane
+     */
+    size_t getPlaneBytes() const;
+
+    /**
+     * Get the bytes the caller's buffer needs (planes * plane bytes)
+     */
+    size_t getBufferSize() const;
+
+    /**
+     * Write every plane
+     * @param board The board to encode
+     * @param out Buffer of getBufferSize() bytes
+     * @param cherryRow Row of the cherry, or -1 if there is none
+     * @param cherryCol Column of the cherry, or -1 if there is none
+     * @throws std::runtime_error if the board size or ghost count differs
+     */
+    void encode(const Board& board, uint8_t* out, int cherryRow = -1, int cherryCol = -1);
+
+    /**
+     * Rewrite the planes for the cells changed by the last board.move()
+     * The buffer must hold this encoder's last encode() or update() of the
+     * same board, one move earlier.
+     * @param board The board to encode
+     * @param out The buffer written before
+     * @param cherryRow Row of the cherry, or -1 if there is none
+     * @param cherryCol Column of the cherry, or -1 if there is none
+     * @throws std::runtime_error if the board size or ghost count differs
+     */
+    void update(const Board& board, uint8_t* out, int cherryRow = -1, int cherryCol = -1);
+
+private:
+    int size;
+    int ghostCount;
+    Format format;
+    size_t cells;
+    size_t planeBytes;
+
+    // Character cells last written, so update() can clear them
+    int pacmanCell;
+    int cherryCell;
+    std::vector<int> ghostCells;
+
+    /**
+     * Throw if the board does not match this encoder
+     */
+    void checkBoard(const Board& board) const;
+
+    /**
+     * Get the cell of a cherry position (-1 if off the board)
+     */
+    int cherryIndex(int cherryRow, int cherryCol) const;
+
+    /**
+     * Set or clear one cell of a plane
+     */
+    void writeCell(uint8_t* plane, int cell, bool on) const;
+
+    /**
+     * Write the WALLS, DOTS and VISITED planes for every cell
+     */
+    void encodeCells(const Board& board, uint8_t* out) const;
+
+    /**
+     * Write the WALLS, DOTS and VISITED planes for one cell
+     */
+    void encodeCell(const Board& board, uint8_t* out, int cell) const;
+};
+
+#endif // OBSERVATION_ENCODER_H
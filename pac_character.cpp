@@ -28,41 +28,7 @@ PacCharacter::~PacCharacter() {
     // Base class destructor
 }
 
-/**
- * Getter for row position
- */
-int PacCharacter::getRow() const {
-    return row_;
-}
-
-/**
- * Getter for column position  
- */
-int PacCharacter::getCol() const {
-    return col_;
-}
-
-/**
- * Getter for character appearance
- */
-char PacCharacter::getAppearance() const {
-    return appearance_;
-}
-
-/**
- * Setter for position
- */
-void PacCharacter::setPosition(int row, int col) {
-    row_ = row;
-    col_ = col;
-}
-
-/**
- * Setter for appearance
- */
-void PacCharacter::setAppearance(char appearance) {
-    appearance_ = appearance;
-}
+// Getters and setters are defined inline in ipac_character.h
 
 
 // ============================================================================
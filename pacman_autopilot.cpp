@@ -0,0 +1,415 @@
+// pacman_autopilot.cpp
+
+#include "pacman_autopilot.h"
+#include "Board.h"
+#include "thread_pool.h"
+#include "trace.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace {
+
+const int FAR = 10000;                  // Distance of unreachable cells
+const int CLOCK_INTERVAL = 16;          // Playouts between clock checks
+const int MIN_NODES = 8;                // A root and its children
+const double CAUGHT_WEIGHT = 0.4;       // Best score of a line that ends caught
+const double NEAR_WEIGHT = 0.05;        // Share of a line's score for ending near dots
+
+// Playout move weights
+const int PLAIN_WEIGHT = 4;
+const int DOT_WEIGHT = 12;
+const int REVERSE_WEIGHT = 1;
+
+// Tree moves, in tie-breaking order
+const Direction MOVES[] = {Direction::UP, Direction::DOWN, Direction::LEFT, Direction::RIGHT, Direction::STAY};
+
+uint64_t nextRandom(uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+} // namespace
+
+PacmanAutopilot::PacmanAutopilot(const AutopilotOptions& options)
+    : options(options), pool(nullptr), graph(nullptr), table(nullptr), size(0),
+      rootPacman(0), dotsLeft(0), stop(false) {
+    if (options.budgetMs <= 0 && options.maxPlayouts <= 0) {
+        throw std::runtime_error("Autopilot needs a time budget or a playout limit");
+    }
+    this->options.maxNodes = std::max(options.maxNodes, MIN_NODES);
+    this->options.playoutDepth = std::max(options.playoutDepth, 0);
+    unsigned threads = options.threads == 0 ? ThreadPool::defaultThreadCount() : options.threads;
+    if (threads > 1) {
+        pool = new ThreadPool(threads);
+    }
+    this->options.threads = threads;
+    workers.resize(threads);
+    for (Worker& worker : workers) {
+        worker.nodes.reserve(this->options.maxNodes);
+        worker.eaten.reserve(64);
+    }
+}
+
+/**
+ * Destructor - joins the pool's threads
+ */
+PacmanAutopilot::~PacmanAutopilot() {
+    delete pool;
+}
+
+/**
+ * Every worker searches its own tree; their root visits are summed
+ */
+Direction PacmanAutopilot::chooseMove(const Board& board) {
+    PAC_TRACE_SCOPE("PacmanAutopilot::chooseMove");
+    Clock::time_point start = Clock::now();
+    deadline = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(options.budgetMs));
+    stop = false;
+
+    // The clone every playout starts from
+    graph = &board.getNavGraph();
+    table = board.getDistanceTable();
+    size = board.getGridSize();
+    rootPacman = board.getPacman()->getRow() * size + board.getPacman()->getCol();
+    const std::vector<Ghost*>& ghosts = board.getGhosts();
+    rootGhosts.clear();
+    for (size_t i = 0; i < ghosts.size(); i++) {
+        if (!board.isGhostFrightened(static_cast<int>(i))) {
+            rootGhosts.push_back(ghosts[i]->getRow() * size + ghosts[i]->getCol());
+        }
+    }
+    const std::vector<char>& visited = board.getVisited();
+    const std::vector<char>& grid = board.getGrid();
+    rootDots.resize(grid.size());
+    dotsLeft = 0;
+    for (size_t cell = 0; cell < grid.size(); cell++) {
+        rootDots[cell] = !visited[cell] && grid[cell] != '#';
+        dotsLeft += rootDots[cell];
+    }
+    measureDots();
+
+    if (pool == nullptr) {
+        search(workers[0], 0);
+    } else {
+        pool->parallelFor(static_cast<int>(workers.size()), [&](int index) {
+            search(workers[index], index);
+        });
+    }
+
+    // Most playouts wins; ties go to the better mean, then to MOVES order
+    Direction choice = Direction::STAY;
+    long long bestVisits = -1;
+    double bestTotal = 0.0;
+    const Node& root = workers[0].nodes[0];
+    for (int child = 0; child < root.childCount; child++) {
+        long long visits = 0;
+        double total = 0.0;
+        for (const Worker& worker : workers) {
+            const Node& node = worker.nodes[worker.nodes[0].firstChild + child];
+            visits += node.visits;
+            total += node.total;
+        }
+        if (visits > bestVisits || (visits == bestVisits && total > bestTotal)) {
+            bestVisits = visits;
+            bestTotal = total;
+            choice = workers[0].nodes[root.firstChild + child].move;
+        }
+    }
+
+    lastStats = AutopilotStats();
+    lastStats.moves = 1;
+    for (const Worker& worker : workers) {
+        lastStats.playouts += worker.playouts;
+        lastStats.nodes += worker.simulated;
+    }
+    lastStats.ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    totalStats.moves++;
+    totalStats.playouts += lastStats.playouts;
+    totalStats.nodes += lastStats.nodes;
+    totalStats.ms += lastStats.ms;
+    return choice;
+}
+
+const AutopilotOptions& PacmanAutopilot::getOptions() const {
+    return options;
+}
+
+const AutopilotStats& PacmanAutopilot::getLastStats() const {
+    return lastStats;
+}
+
+const AutopilotStats& PacmanAutopilot::getTotalStats() const {
+    return totalStats;
+}
+
+size_t PacmanAutopilot::memoryUsage() const {
+    size_t bytes = workers.capacity() * sizeof(Worker) + rootDots.capacity()
+                 + (rootGhosts.capacity() + dotDistance.capacity() + frontier.capacity()) * sizeof(int);
+    for (const Worker& worker : workers) {
+        bytes += worker.nodes.capacity() * sizeof(Node) + worker.dots.capacity()
+               + (worker.line.capacity() + worker.ghosts.capacity() + worker.eaten.capacity()) * sizeof(int);
+    }
+    return bytes;
+}
+
+void PacmanAutopilot::measureDots() {
+    dotDistance.assign(rootDots.size(), FAR);
+    frontier.clear();
+    for (size_t cell = 0; cell < rootDots.size(); cell++) {
+        if (rootDots[cell]) {
+            dotDistance[cell] = 0;
+            frontier.push_back(static_cast<int>(cell));
+        }
+    }
+    for (size_t head = 0; head < frontier.size(); head++) {
+        int cell = frontier[head];
+        for (Direction move : MOVES) {
+            int next = move == Direction::STAY ? -1 : graph->neighbour(cell, move);
+            if (next >= 0 && dotDistance[next] == FAR) {
+                dotDistance[next] = dotDistance[cell] + 1;
+                frontier.push_back(next);
+            }
+        }
+    }
+}
+
+/**
+ * The root is expanded up front so every tree has the same root moves
+ */
+void PacmanAutopilot::search(Worker& worker, int index) {
+    worker.nodes.clear();
+    worker.nodes.push_back({-1, 0, Direction::STAY, 0, 0.0});
+    worker.dots = rootDots;
+    worker.rng = (options.seed + 1) * 0x9E3779B97F4A7C15ull + static_cast<uint64_t>(index) * 0xBF58476D1CE4E5B9ull;
+    worker.rng = worker.rng == 0 ? 1 : worker.rng;
+    worker.playouts = 0;
+    worker.simulated = 0;
+    expand(worker, 0);
+
+    bool timed = options.budgetMs > 0;
+    while (!stop && (options.maxPlayouts <= 0 || worker.playouts < options.maxPlayouts)) {
+        iterate(worker);
+        if (timed && worker.playouts % CLOCK_INTERVAL == 0 && Clock::now() >= deadline) {
+            stop = true;
+        }
+    }
+}
+
+/**
+ * A leaf is expanded on its second visit, so lines tried once stay cheap
+ */
+void PacmanAutopilot::iterate(Worker& worker) {
+    worker.pacman = rootPacman;
+    worker.ghosts.assign(rootGhosts.begin(), rootGhosts.end());
+    worker.line.clear();
+    worker.line.push_back(0);
+
+    int node = 0;
+    int ticks = 0;
+    bool alive = true;
+    while (alive && worker.nodes[node].firstChild >= 0) {
+        node = select(worker, node);
+        worker.line.push_back(node);
+        alive = advance(worker, worker.nodes[node].move);
+        ticks++;
+    }
+    if (alive && worker.nodes[node].visits > 0 && expand(worker, node)) {
+        const Node& leaf = worker.nodes[node];
+        node = leaf.firstChild + static_cast<int>(nextRandom(worker.rng) % leaf.childCount);
+        worker.line.push_back(node);
+        alive = advance(worker, worker.nodes[node].move);
+        ticks++;
+    }
+
+    Direction last = worker.nodes[node].move;
+    for (int i = 0; alive && i < options.playoutDepth && static_cast<int>(worker.eaten.size()) < dotsLeft; i++) {
+        last = playoutMove(worker, last);
+        alive = advance(worker, last);
+        ticks++;
+    }
+
+    // Caught lines score below 0.5 by how long Pacman lasted, so a lost
+    // position still runs; the rest score 0.5 and up by the dots eaten,
+    // and a little for ending near dots, so lines far from any still head
+    // somewhere
+    double result;
+    if (alive) {
+        int reachable = std::min(std::max(ticks, 1), std::max(dotsLeft, 1));
+        double eaten = std::min(1.0, static_cast<double>(worker.eaten.size()) / reachable);
+        result = 0.5 + (0.5 - NEAR_WEIGHT) * eaten + NEAR_WEIGHT / (1 + dotDistance[worker.pacman]);
+    } else {
+        int horizon = static_cast<int>(worker.line.size()) + options.playoutDepth;
+        result = CAUGHT_WEIGHT * (ticks - 1) / horizon;
+    }
+    for (int visited : worker.line) {
+        worker.nodes[visited].visits++;
+        worker.nodes[visited].total += result;
+    }
+    for (int cell : worker.eaten) {
+        worker.dots[cell] = 1;
+    }
+    worker.eaten.clear();
+    worker.playouts++;
+}
+
+/**
+ * Children are the open moves from the node's cell, which is where the
+ * clone's Pacman stands when the node is reached
+ */
+bool PacmanAutopilot::expand(Worker& worker, int node) {
+    int first = static_cast<int>(worker.nodes.size());
+    int count = 0;
+    for (Direction move : MOVES) {
+        if (move == Direction::STAY || graph->neighbour(worker.pacman, move) >= 0) {
+            count++;
+        }
+    }
+    if (first + count > options.maxNodes) {
+        return false;
+    }
+    for (Direction move : MOVES) {
+        if (move == Direction::STAY || graph->neighbour(worker.pacman, move) >= 0) {
+            worker.nodes.push_back({-1, 0, move, 0, 0.0});
+        }
+    }
+    worker.nodes[node].firstChild = first;
+    worker.nodes[node].childCount = count;
+    return true;
+}
+
+/**
+ * Unvisited children first, then UCT
+ */
+int PacmanAutopilot::select(const Worker& worker, int node) const {
+    const Node& parent = worker.nodes[node];
+    double logVisits = std::log(static_cast<double>(std::max(parent.visits, 1)));
+    int best = parent.firstChild;
+    double bestScore = -1.0;
+    for (int child = parent.firstChild; child < parent.firstChild + parent.childCount; child++) {
+        const Node& candidate = worker.nodes[child];
+        if (candidate.visits == 0) {
+            return child;
+        }
+        double score = candidate.total / candidate.visits
+                     + options.exploration * std::sqrt(logVisits / candidate.visits);
+        if (score > bestScore) {
+            bestScore = score;
+            best = child;
+        }
+    }
+    return best;
+}
+
+/**
+ * As Board::move: Pacman steps (eating), then each ghost steps; walking
+ * into a ghost or a ghost walking onto him ends the line
+ */
+bool PacmanAutopilot::advance(Worker& worker, Direction move) {
+    if (move != Direction::STAY) {
+        int to = graph->neighbour(worker.pacman, move);
+        worker.pacman = to >= 0 ? to : worker.pacman;
+    }
+    if (worker.dots[worker.pacman]) {
+        worker.dots[worker.pacman] = 0;
+        worker.eaten.push_back(worker.pacman);
+    }
+    worker.simulated++;
+    for (int ghost : worker.ghosts) {
+        if (ghost == worker.pacman) {
+            return false;
+        }
+    }
+    for (int& ghost : worker.ghosts) {
+        ghost = chaseStep(ghost, worker.pacman);
+        if (ghost == worker.pacman) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Moves next to a ghost are taken only when every move is
+ */
+Direction PacmanAutopilot::playoutMove(Worker& worker, Direction last) {
+    Direction candidates[4];
+    int weights[4];
+    int count = 0;
+    int total = 0;
+    bool anySafe = false;
+    for (Direction move : MOVES) {
+        int to = move == Direction::STAY ? -1 : graph->neighbour(worker.pacman, move);
+        if (to < 0) {
+            continue;
+        }
+        bool safe = true;
+        for (int ghost : worker.ghosts) {
+            if (distance(ghost, to) <= 1) {
+                safe = false;
+                break;
+            }
+        }
+        bool toward = worker.dots[to] || dotDistance[to] < dotDistance[worker.pacman];
+        int weight = toward ? DOT_WEIGHT : PLAIN_WEIGHT;
+        if (move == DirectionHelper::opposite(last)) {
+            weight = REVERSE_WEIGHT * weight / PLAIN_WEIGHT;
+        }
+        if (safe && !anySafe) {
+            // The first safe move drops the unsafe ones seen so far
+            anySafe = true;
+            count = 0;
+            total = 0;
+        }
+        if (safe || !anySafe) {
+            candidates[count] = move;
+            weights[count] = weight;
+            total += weight;
+            count++;
+        }
+    }
+    if (count == 0) {
+        return Direction::STAY;
+    }
+    int pick = static_cast<int>(nextRandom(worker.rng) % static_cast<uint64_t>(total));
+    for (int i = 0; i < count; i++) {
+        pick -= weights[i];
+        if (pick < 0) {
+            return candidates[i];
+        }
+    }
+    return candidates[count - 1];
+}
+
+int PacmanAutopilot::distance(int from, int to) const {
+    if (table != nullptr) {
+        uint16_t steps = table->distance(from, to);
+        return steps == DistanceTable::UNREACHABLE ? FAR : steps;
+    }
+    return std::abs(from / size - to / size) + std::abs(from % size - to % size);
+}
+
+int PacmanAutopilot::chaseStep(int cell, int target) const {
+    Direction move = graph->chaseMove(cell, graph->towardMove(cell, target),
+                                      [&](int next) { return distance(next, target); });
+    return move == Direction::STAY ? cell : graph->neighbour(cell, move);
+}
+
+void writeAutopilotReport(std::ostream& out, const AutopilotOptions& options, const AutopilotStats& total,
+                          const Board* board) {
+    out << "{\"autopilot\": \"mcts\""
+        << ", \"threads\": " << options.threads
+        << ", \"budget_ms\": " << options.budgetMs
+        << ", \"moves\": " << total.moves;
+    if (board != nullptr) {
+        out << ", \"score\": " << board->getScore()
+            << ", \"caught\": " << (board->getIsGameOver() ? "true" : "false")
+            << ", \"dots_left\": " << board->getDotsRemaining();
+    }
+    out << ", \"playouts_per_move\": " << (total.moves > 0 ? static_cast<double>(total.playouts) / total.moves : 0.0)
+        << ", \"ms_per_move\": " << (total.moves > 0 ? total.ms / total.moves : 0.0)
+        << ", \"nodes_per_sec\": " << total.nodesPerSecond() << "}" << std::endl;
+}
@@ -0,0 +1,214 @@
+// pacman_autopilot.h
+// Pacman played by Monte Carlo tree search
+
+#ifndef PACMAN_AUTOPILOT_H
+#define PACMAN_AUTOPILOT_H
+
+#include <vector>
+#include <ostream>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include "Direction.h"
+#include "nav_graph.h"
+#include "distance_table.h"
+
+class Board;
+class ThreadPool;
+
+/**
+ * AutopilotOptions - limits of one move's search
+ */
+struct AutopilotOptions {
+    double budgetMs = 50.0;       // Per move; 0 leaves only maxPlayouts
+    int maxPlayouts = 0;          // Per worker and move; 0 means no limit
+    unsigned threads = 0;         // 0 means ThreadPool::defaultThreadCount()
+    int playoutDepth = 20;        // Ticks simulated below the tree
+    int maxNodes = 1 << 16;       // Tree nodes per worker
+    double exploration = 1.4;     // UCT exploration constant
+    uint64_t seed = 1;
+};
+
+/**
+ * AutopilotStats - what one or more chooseMove calls did
+ */
+struct AutopilotStats {
+    int moves = 0;
+    long long playouts = 0;
+    long long nodes = 0;          // Ticks simulated, in the trees and below them
+    double ms = 0.0;
+
+    /**
+     * Get the nodes simulated per second of search
+     */
+    double nodesPerSecond() const { return ms > 0 ? nodes * 1000.0 / ms : 0.0; }
+};
+
+/**
+ * PacmanAutopilot class - chooses Pacman's moves with Monte Carlo tree
+ * search
+ * Every worker grows its own tree of Pacman's moves from the current
+ * position (root parallelism): it walks down by UCT, adds the children of
+ * the leaf it reaches, plays on with dot-hungry random moves for
+ * playoutDepth ticks and backs up the result. A line that ends caught
+ * scores below 0.5, more the longer Pacman lasted; the others score 0.5
+ * and up by the dots eaten and how near the next dots they end. The move
+ * taken is the root move with the most playouts over all trees.
+ *
+ * Lines are simulated on a lightweight clone of the board - Pacman's
+ * cell, the ghosts' cells and the dots left - that each worker resets
+ * after every playout, never on a Board. In the clone every ghost chases
+ * by the shortest path (along the board's DistanceTable, or by Manhattan
+ * distance without one), whatever its personality, script or difficulty;
+ * frightened ghosts are left out.
+ *
+ * With a playout limit and no time budget the moves depend only on the
+ * options, not on the machine.
+ */
+class PacmanAutopilot {
+public:
+    /**
+     * Constructor - starts the pool when more than one thread is asked for
+     * Throws std::runtime_error when neither a budget nor a playout limit
+     * is set.
+     */
+    explicit PacmanAutopilot(const AutopilotOptions& options = AutopilotOptions());
+    ~PacmanAutopilot();
+
+    PacmanAutopilot(const PacmanAutopilot&) = delete;
+    PacmanAutopilot& operator=(const PacmanAutopilot&) = delete;
+
+    /**
+     * Choose Pacman's next move
+     * @param board The game (only read)
+     * @return A move Pacman can make (STAY when he cannot move)
+     */
+    Direction chooseMove(const Board& board);
+
+    /**
+     * Get the options in use (threads resolved to the actual count)
+     */
+    const AutopilotOptions& getOptions() const;
+
+    /**
+     * Get the stats of the last chooseMove
+     */
+    const AutopilotStats& getLastStats() const;
+
+    /**
+     * Get the stats of every chooseMove so far
+     */
+    const AutopilotStats& getTotalStats() const;
+
+    /**
+     * Get the heap bytes this autopilot owns (the pool's threads aside)
+     */
+    size_t memoryUsage() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * A tree node: the position after its move; children are contiguous
+     */
+    struct Node {
+        int firstChild;       // -1 until expanded
+        int childCount;
+        Direction move;
+        int visits;
+        double total;         // Sum of the results backed up through the node
+    };
+
+    /**
+     * A worker's tree and board clone
+     * Each on its own cache line, since every playout writes to it.
+     */
+    struct alignas(64) Worker {
+        std::vector<Node> nodes;      // [0] is the root
+        std::vector<int> line;        // Nodes walked this playout
+        int pacman;
+        std::vector<int> ghosts;
+        std::vector<char> dots;       // 1 where a dot is left
+        std::vector<int> eaten;       // Dots eaten this playout, to put back
+        uint64_t rng;
+        long long playouts;
+        long long simulated;          // Ticks simulated
+    };
+
+    AutopilotOptions options;
+    ThreadPool* pool;                 // Null with one thread
+    std::vector<Worker> workers;
+    AutopilotStats lastStats;
+    AutopilotStats totalStats;
+
+    // Per chooseMove call
+    const NavGraph* graph;
+    const DistanceTable* table;
+    int size;
+    int rootPacman;
+    std::vector<int> rootGhosts;
+    std::vector<char> rootDots;
+    int dotsLeft;
+    std::vector<int> dotDistance;     // Steps from each cell to the nearest root dot
+    std::vector<int> frontier;
+    Clock::time_point deadline;
+    std::atomic<bool> stop;
+
+    /**
+     * Fill dotDistance with a breadth-first search from every dot at once
+     */
+    void measureDots();
+
+    /**
+     * Grow one worker's tree until the budget or the playout limit
+     */
+    void search(Worker& worker, int index);
+
+    /**
+     * One selection, expansion, playout and backup
+     */
+    void iterate(Worker& worker);
+
+    /**
+     * Add a leaf's children; false when the tree is full
+     */
+    bool expand(Worker& worker, int node);
+
+    /**
+     * Pick the child with the best UCT score
+     */
+    int select(const Worker& worker, int node) const;
+
+    /**
+     * Move the clone's Pacman and then its ghosts one tick
+     * @return false if a ghost catches Pacman
+     */
+    bool advance(Worker& worker, Direction move);
+
+    /**
+     * Pick a playout move: toward dots more often, away from ghosts and
+     * seldom back the way Pacman came
+     */
+    Direction playoutMove(Worker& worker, Direction last);
+
+    /**
+     * Get the steps between two cells
+     */
+    int distance(int from, int to) const;
+
+    /**
+     * Get the cell a ghost steps to by the chase rule (NavGraph::chaseMove)
+     */
+    int chaseStep(int cell, int target) const;
+};
+
+/**
+ * Write an autopilot's options and totals as one JSON line
+ * @param board The game it played, for the score and outcome, or null to
+ *        leave them out
+ */
+void writeAutopilotReport(std::ostream& out, const AutopilotOptions& options, const AutopilotStats& total,
+                          const Board* board);
+
+#endif // PACMAN_AUTOPILOT_H
@@ -0,0 +1,293 @@
+// pathfinder.cpp
+
+#include "pathfinder.h"
+#include "trace.h"
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
+namespace {
+
+const Direction MOVES[] = {Direction::UP, Direction::DOWN, Direction::LEFT, Direction::RIGHT};
+
+/**
+ * Heap order for std::push_heap: the smallest f (then largest g) on top
+ */
+template <typename Entry>
+bool worse(const Entry& a, const Entry& b) {
+    return a.f != b.f ? a.f > b.f : a.g < b.g;
+}
+
+} // namespace
+
+/**
+ * Constructor
+ */
+Pathfinder::Pathfinder(const NavGraph& graph, int size, int ghostCount)
+    : graph(graph), size(size), epoch(0), searches(0), expanded(0), repairs(0) {
+    size_t cells = static_cast<size_t>(size) * size;
+    stamps.assign(cells, 0);
+    gScores.assign(cells, 0);
+    parents.assign(cells, -1);
+    paths.assign(ghostCount > 0 ? ghostCount : 0, CachedPath{{}, 0, 0});
+}
+
+Direction Pathfinder::nextMove(int ghost, int from, int target) {
+    if (from == target) {
+        return Direction::STAY;
+    }
+    CachedPath& path = paths[ghost];
+    size_t end = path.cells.size();
+    bool usable = path.head < end && moveBetween(from, path.cells[path.head]) != Direction::STAY;
+
+    if (!usable) {
+        if (!replan(path, from, target)) {
+            return Direction::STAY;
+        }
+    } else if (path.cells[end - 1] != target) {
+        size_t on = std::find(path.cells.begin() + path.head, path.cells.end() - 1, target) - path.cells.begin();
+        if (on < end - 1) {
+            // Target moved onto the path (stepping back along it, say)
+            path.cells.resize(on + 1);
+            repairs++;
+        } else if (path.appended < REPAIR_LIMIT && moveBetween(path.cells[end - 1], target) != Direction::STAY) {
+            // Target stepped off the end; a path no longer than the
+            // Manhattan distance is still a shortest one
+            path.cells.push_back(target);
+            path.appended++;
+            if (path.cells.size() - path.head == heuristic(from, target)) {
+                path.appended = 0;
+            }
+            repairs++;
+        } else if (!replan(path, from, target)) {
+            return Direction::STAY;
+        }
+    }
+
+    return moveBetween(from, path.cells[path.head++]);
+}
+
+bool Pathfinder::replan(CachedPath& path, int from, int target) {
+    path.head = 0;
+    path.appended = 0;
+    return findPath(from, target, path.cells);
+}
+
+bool Pathfinder::findPath(int from, int to, std::vector<int32_t>& path) {
+    PAC_TRACE_SCOPE("Pathfinder::findPath");
+    searches++;
+    path.clear();
+    if (from == to) {
+        return true;
+    }
+    if (++epoch == 0) {
+        std::fill(stamps.begin(), stamps.end(), 0);
+        epoch = 1;
+    }
+    open.clear();
+    return graph.getJunctionCount() > 0 ? findJunctionPath(from, to, path) : findCellPath(from, to, path);
+}
+
+/**
+ * The Manhattan heuristic is consistent on a 4-connected grid, so a cell
+ * is final the first time it leaves the open set; stale duplicate entries
+ * (larger g) are skipped instead of being removed from the heap
+ */
+bool Pathfinder::findCellPath(int from, int to, std::vector<int32_t>& path) {
+    stamps[from] = epoch;
+    gScores[from] = 0;
+    parents[from] = -1;
+    open.push_back(OpenEntry{heuristic(from, to), 0, from});
+
+    bool found = false;
+    while (!open.empty()) {
+        std::pop_heap(open.begin(), open.end(), worse<OpenEntry>);
+        OpenEntry entry = open.back();
+        open.pop_back();
+        if (entry.g != gScores[entry.cell]) {
+            continue;
+        }
+        expanded++;
+        if (entry.cell == to) {
+            found = true;
+            break;
+        }
+
+        uint32_t g = entry.g + 1;
+        for (Direction direction : MOVES) {
+            if (!graph.canMove(entry.cell, direction)) {
+                continue;
+            }
+            int next = entry.cell + DirectionHelper::getY(direction) * size + DirectionHelper::getX(direction);
+            if (stamps[next] == epoch && gScores[next] <= g) {
+                continue;
+            }
+            stamps[next] = epoch;
+            gScores[next] = g;
+            parents[next] = entry.cell;
+            open.push_back(OpenEntry{g + heuristic(next, to), g, next});
+            std::push_heap(open.begin(), open.end(), worse<OpenEntry>);
+        }
+    }
+    if (!found) {
+        return false;
+    }
+
+    for (int cell = to; cell != from; cell = parents[cell]) {
+        path.push_back(cell);
+    }
+    std::reverse(path.begin(), path.end());
+    return true;
+}
+
+/**
+ * The start's corridor leads to a junction at each end, costing the steps
+ * to it; the goal's corridor is entered from whichever end is cheaper, or
+ * followed straight when start and goal share it. Edges are no shorter
+ * than the Manhattan distance they cover, so the heuristic stays
+ * consistent and the search stops once no open junction can beat the best
+ * path found.
+ */
+bool Pathfinder::findJunctionPath(int from, int to, std::vector<int32_t>& path) {
+    const uint32_t NONE = std::numeric_limits<uint32_t>::max();
+    int goalJunction = graph.getJunction(to);
+    int goalEdge = graph.getCorridor(to);
+    uint32_t goalOffset = static_cast<uint32_t>(graph.getCorridorOffset(to));
+    uint32_t goalLength = goalEdge >= 0 ? static_cast<uint32_t>(graph.getEdge(goalEdge).length) : 0;
+    int goalSource = goalEdge >= 0 ? graph.getEdgeSource(goalEdge) : -1;
+    int goalTarget = goalEdge >= 0 ? graph.getEdge(goalEdge).to : -1;
+
+    int startEdge = graph.getCorridor(from);
+    uint32_t startOffset = static_cast<uint32_t>(graph.getCorridorOffset(from));
+    uint32_t best = NONE;
+    int bestVia = -1;                 // Junction the best path leaves from; -1 for straight along the corridor
+    if (startEdge < 0) {
+        reach(graph.getJunction(from), 0, -1, to);
+    } else {
+        uint32_t length = static_cast<uint32_t>(graph.getEdge(startEdge).length);
+        reach(graph.getEdgeSource(startEdge), startOffset, -1, to);
+        reach(graph.getEdge(startEdge).to, length - startOffset, -1, to);
+        if (startEdge == goalEdge) {
+            best = startOffset > goalOffset ? startOffset - goalOffset : goalOffset - startOffset;
+        }
+    }
+
+    while (!open.empty()) {
+        std::pop_heap(open.begin(), open.end(), worse<OpenEntry>);
+        OpenEntry entry = open.back();
+        open.pop_back();
+        if (entry.g != gScores[entry.cell]) {
+            continue;
+        }
+        if (entry.f >= best) {
+            break;
+        }
+        expanded++;
+        int junction = entry.cell;
+        if (junction == goalJunction) {
+            best = entry.g;
+            bestVia = junction;
+            continue;
+        }
+        if (junction == goalSource && entry.g + goalOffset < best) {
+            best = entry.g + goalOffset;
+            bestVia = junction;
+        }
+        if (junction == goalTarget && entry.g + goalLength - goalOffset < best) {
+            best = entry.g + goalLength - goalOffset;
+            bestVia = junction;
+        }
+        for (int edge = graph.edgeBegin(junction); edge < graph.edgeEnd(junction); edge++) {
+            const NavEdge& next = graph.getEdge(edge);
+            reach(next.to, entry.g + static_cast<uint32_t>(next.length), edge, to);
+        }
+    }
+    if (best == NONE) {
+        return false;
+    }
+    if (bestVia < 0) {
+        appendCorridor(startEdge, static_cast<int>(startOffset), static_cast<int>(goalOffset), path);
+        return true;
+    }
+
+    // Walk the edges back to the start junction, then lay the cells out
+    // forward: out of the start's corridor, along the edges, into the goal's
+    route.clear();
+    int first = bestVia;
+    while (parents[first] >= 0) {
+        route.push_back(parents[first]);
+        first = graph.getEdgeSource(parents[first]);
+    }
+    if (startEdge >= 0) {
+        bool back = first == graph.getEdgeSource(startEdge) && gScores[first] == startOffset;
+        appendCorridor(startEdge, static_cast<int>(startOffset),
+                       back ? 0 : graph.getEdge(startEdge).length, path);
+    }
+    for (size_t i = route.size(); i-- > 0;) {
+        appendCorridor(route[i], 0, graph.getEdge(route[i]).length, path);
+    }
+    if (goalEdge >= 0) {
+        bool fromSource = bestVia == goalSource && gScores[bestVia] + goalOffset == best;
+        appendCorridor(goalEdge, fromSource ? 0 : static_cast<int>(goalLength), static_cast<int>(goalOffset), path);
+    }
+    return true;
+}
+
+void Pathfinder::reach(int junction, uint32_t g, int32_t parent, int to) {
+    if (stamps[junction] == epoch && gScores[junction] <= g) {
+        return;
+    }
+    stamps[junction] = epoch;
+    gScores[junction] = g;
+    parents[junction] = parent;
+    open.push_back(OpenEntry{g + heuristic(graph.getJunctionCell(junction), to), g, junction});
+    std::push_heap(open.begin(), open.end(), worse<OpenEntry>);
+}
+
+void Pathfinder::appendCorridor(int edge, int from, int to, std::vector<int32_t>& path) {
+    graph.getEdgeCells(edge, corridor);
+    if (from < to) {
+        path.insert(path.end(), corridor.begin() + from + 1, corridor.begin() + to + 1);
+    } else {
+        for (int offset = from - 1; offset >= to; offset--) {
+            path.push_back(corridor[offset]);
+        }
+    }
+}
+
+long long Pathfinder::getSearches() const {
+    return searches;
+}
+
+long long Pathfinder::getExpanded() const {
+    return expanded;
+}
+
+long long Pathfinder::getRepairs() const {
+    return repairs;
+}
+
+size_t Pathfinder::memoryUsage() const {
+    size_t bytes = stamps.capacity() * sizeof(uint32_t) + gScores.capacity() * sizeof(uint32_t)
+                 + parents.capacity() * sizeof(int32_t) + open.capacity() * sizeof(OpenEntry)
+                 + (route.capacity() + corridor.capacity()) * sizeof(int32_t)
+                 + paths.capacity() * sizeof(CachedPath);
+    for (const CachedPath& path : paths) {
+        bytes += path.cells.capacity() * sizeof(int32_t);
+    }
+    return bytes;
+}
+
+uint32_t Pathfinder::heuristic(int cell, int goal) const {
+    return static_cast<uint32_t>(std::abs(cell / size - goal / size) + std::abs(cell % size - goal % size));
+}
+
+Direction Pathfinder::moveBetween(int from, int to) const {
+    for (Direction direction : MOVES) {
+        if (graph.canMove(from, direction) &&
+            from + DirectionHelper::getY(direction) * size + DirectionHelper::getX(direction) == to) {
+            return direction;
+        }
+    }
+    return Direction::STAY;
+}
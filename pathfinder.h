@@ -0,0 +1,151 @@
+// pathfinder.h
+
+#ifndef PATHFINDER_H
+#define PATHFINDER_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "nav_graph.h"
+#include "Direction.h"
+
+/**
+ * Pathfinder class - A* paths for ghosts, cached from tick to tick
+ * Searches the board's NavGraph with a Manhattan heuristic and a binary
+ * heap. On boards with walls the search runs over the junction graph:
+ * it leaves the start's corridor at either end, follows whole corridors
+ * as single edges and enters the goal's corridor from either end, so its
+ * cost follows the number of junctions rather than the cells. Boards
+ * without walls have no junction graph and are searched cell by cell.
+ * The search arrays are allocated once and reused, and each ghost keeps
+ * the path it is walking:
+ *   - target moved onto the path: the path is cut short there
+ *   - target moved one step off the end: the step is appended; each
+ *     append can leave the path up to two steps longer than the shortest,
+ *     so after REPAIR_LIMIT appends (not counting ones that leave it as
+ *     short as the Manhattan distance) the path is planned again
+ *   - anything else (a jump, a ghost off its path): planned again
+ * So a ghost chasing a moving Pacman searches once every few ticks
+ * instead of every tick, and its path's cost follows its length, not the
+ * board's area.
+ */
+class Pathfinder {
+public:
+    // Appended steps before a path is planned again from scratch
+    static const int REPAIR_LIMIT = 4;
+
+    /**
+     * Constructor
+     * @param graph The moves of the board (must outlive the pathfinder)
+     * @param size The size of the square board
+     * @param ghostCount Number of ghosts keeping a path
+     */
+    Pathfinder(const NavGraph& graph, int size, int ghostCount);
+
+    /**
+     * Get a ghost's next move toward a target, following its cached path
+     * @param ghost The ghost's index on the board
+     * @param from The ghost's cell
+     * @param target The cell to reach
+     * @return The move, or STAY if the target cannot be reached
+     */
+    Direction nextMove(int ghost, int from, int target);
+
+    /**
+     * Find a shortest path with A*
+     * @param from Start cell
+     * @param to Goal cell
+     * @param path Filled with the cells after from, ending with to
+     * @return false if to cannot be reached
+     */
+    bool findPath(int from, int to, std::vector<int32_t>& path);
+
+    /**
+     * Counters since construction
+     */
+    long long getSearches() const;     // A* runs
+    long long getExpanded() const;     // Cells or junctions taken off the open set
+    long long getRepairs() const;      // Paths cut or extended without a search
+
+    /**
+     * Get the heap bytes this pathfinder owns
+     */
+    size_t memoryUsage() const;
+
+private:
+    /**
+     * One path being walked: cells[head] is the next cell, back() the target
+     */
+    struct CachedPath {
+        std::vector<int32_t> cells;
+        size_t head;
+        int appended;
+    };
+
+    /**
+     * Open-set entry; ties on f go to the entry nearer the goal
+     */
+    struct OpenEntry {
+        uint32_t f;
+        uint32_t g;
+        int32_t cell;
+    };
+
+    const NavGraph& graph;
+    int size;
+
+    // Search arrays, by cell or by junction: g and parent (a cell, or the
+    // edge arrived by) are valid when stamp == epoch
+    std::vector<uint32_t> stamps;
+    std::vector<uint32_t> gScores;
+    std::vector<int32_t> parents;
+    uint32_t epoch;
+    std::vector<OpenEntry> open;
+    std::vector<int32_t> route;      // Edges of a junction path, goal first
+    std::vector<int32_t> corridor;   // Cells of one edge
+
+    std::vector<CachedPath> paths;
+
+    long long searches;
+    long long expanded;
+    long long repairs;
+
+    /**
+     * A* over cells, for boards without a junction graph
+     */
+    bool findCellPath(int from, int to, std::vector<int32_t>& path);
+
+    /**
+     * A* over junctions, for boards with walls
+     */
+    bool findJunctionPath(int from, int to, std::vector<int32_t>& path);
+
+    /**
+     * Put a junction on the open set if g improves on what it has
+     * @param parent The edge arrived by, or -1 for a start junction
+     */
+    void reach(int junction, uint32_t g, int32_t parent, int to);
+
+    /**
+     * Append the cells of an edge after offset from, up to offset to
+     * (either way along it)
+     */
+    void appendCorridor(int edge, int from, int to, std::vector<int32_t>& path);
+
+    /**
+     * Plan a ghost's path again
+     */
+    bool replan(CachedPath& path, int from, int target);
+
+    /**
+     * Manhattan distance between two cells
+     */
+    uint32_t heuristic(int cell, int goal) const;
+
+    /**
+     * Get the move between two neighbouring cells (STAY if they are not)
+     */
+    Direction moveBetween(int from, int to) const;
+};
+
+#endif // PATHFINDER_H
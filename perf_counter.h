@@ -0,0 +1,42 @@
+// perf_counter.h
+
+#ifndef PERF_COUNTER_H
+#define PERF_COUNTER_H
+
+#include <cstdint>
+
+/**
+ * InstructionCounter class - user-space instructions retired by the calling thread
+ * Uses a perf_event_open hardware counter on Linux. Where the counter is
+ * not available (other systems, VMs without a PMU, perf_event_paranoid
+ * too strict) isAvailable() is false and stop() returns 0.
+ */
+class InstructionCounter {
+public:
+    InstructionCounter();
+    ~InstructionCounter();
+
+    InstructionCounter(const InstructionCounter&) = delete;
+    InstructionCounter& operator=(const InstructionCounter&) = delete;
+
+    /**
+     * Check if the hardware counter could be opened
+     */
+    bool isAvailable() const;
+
+    /**
+     * Zero the counter and start counting
+     */
+    void start();
+
+    /**
+     * Stop counting
+     * @return Instructions counted since start()
+     */
+    uint64_t stop();
+
+private:
+    int fd;   // perf event file descriptor, -1 if unavailable
+};
+
+#endif // PERF_COUNTER_H
@@ -0,0 +1,468 @@
+// regress_main.cpp
+// Regression harness: replays scripted games headlessly through Board and
+// checks the outcome against golden values stored in each script.
+//
+// Script format (one directive per line, '#' starts a comment):
+//   board <file>      Start from a saved board (path relative to the script)
+//   size <n>          ...or from a new n x n board
+//   ghosts <n>        Ghost count for a new board (default 4)
+//   nav <name>        Ghost navigation: field (default) or astar
+//   behaviour <name>  Ghost script for every ghost: patrol (the corners,
+//                     then wait 5 and chase 10 ticks)
+//   hard <depth> <model>  Chasers search ahead to a fixed depth, with no
+//                     time budget; model is adversarial or probabilistic
+//   moves <keys>      Pac-Man moves: w/a/s/d, '.' to stay; may repeat
+//   expect score <n> ticks <n> hash <hex>
+//
+// A game stops at the end of its moves or when Pac-Man is caught. The hash
+// is FNV-1a over Board::writeString, so any change to the final board,
+// score or game-over state shows up as drift.
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include "../Board.h"
+#include "../perf_counter.h"
+
+namespace {
+
+/**
+ * One scripted game and its golden values
+ */
+struct Script {
+    std::string path;
+    std::string name;
+    std::string boardFile;    // Empty for a new board
+    int size = 0;
+    int ghosts = 4;
+    GhostNav nav = GhostNav::DISTANCE_FIELD;
+    bool patrol = false;
+    int hardDepth = 0;        // 0 for normal ghosts
+    PacmanModel model = PacmanModel::ADVERSARIAL;
+    std::vector<Direction> moves;
+    bool hasExpect = false;
+    int expectScore = 0;
+    int expectTicks = 0;
+    uint64_t expectHash = 0;
+};
+
+/**
+ * Outcome and cost of replaying a script
+ */
+struct Outcome {
+    int score = 0;
+    int ticks = 0;
+    uint64_t hash = 0;
+    double nsPerTick = 0;
+    double instructionsPerTick = -1;   // -1 when the counter is unavailable
+};
+
+/**
+ * Performance baseline for one script
+ */
+struct Baseline {
+    double nsPerTick;
+    double instructionsPerTick;
+};
+
+uint64_t fnv1a(const std::string& text) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char ch : text) {
+        hash ^= ch;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+std::string hexHash(uint64_t hash) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%016llx", static_cast<unsigned long long>(hash));
+    return text;
+}
+
+/**
+ * Directory part of a path, with trailing slash (empty for none)
+ */
+std::string directoryOf(const std::string& path) {
+    size_t slash = path.find_last_of('/');
+    return slash == std::string::npos ? "" : path.substr(0, slash + 1);
+}
+
+/**
+ * Parse a script file
+ * @throws std::runtime_error on unreadable files or bad directives
+ */
+Script loadScript(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("cannot open " + path);
+    }
+
+    Script script;
+    script.path = path;
+    size_t slash = path.find_last_of('/');
+    script.name = path.substr(slash == std::string::npos ? 0 : slash + 1);
+    if (script.name.size() > 7 && script.name.compare(script.name.size() - 7, 7, ".script") == 0) {
+        script.name.resize(script.name.size() - 7);
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        std::istringstream in(line);
+        std::string directive;
+        if (!(in >> directive) || directive[0] == '#') {
+            continue;
+        }
+        if (directive == "board") {
+            in >> script.boardFile;
+            script.boardFile = directoryOf(path) + script.boardFile;
+        }
+        else if (directive == "size") {
+            in >> script.size;
+        }
+        else if (directive == "ghosts") {
+            in >> script.ghosts;
+        }
+        else if (directive == "nav") {
+            std::string name;
+            in >> name;
+            if (name == "field") {
+                script.nav = GhostNav::DISTANCE_FIELD;
+            } else if (name == "astar") {
+                script.nav = GhostNav::ASTAR;
+            } else {
+                throw std::runtime_error(path + ":" + std::to_string(lineNumber) + ": unknown nav " + name);
+            }
+        }
+        else if (directive == "behaviour") {
+            std::string name;
+            in >> name;
+            if (name != "patrol") {
+                throw std::runtime_error(path + ":" + std::to_string(lineNumber) + ": unknown behaviour " + name);
+            }
+            script.patrol = true;
+        }
+        else if (directive == "hard") {
+            std::string name;
+            in >> script.hardDepth >> name;
+            if (script.hardDepth < 1 || (name != "adversarial" && name != "probabilistic")) {
+                throw std::runtime_error(path + ":" + std::to_string(lineNumber) + ": bad hard directive");
+            }
+            script.model = name == "adversarial" ? PacmanModel::ADVERSARIAL : PacmanModel::PROBABILISTIC;
+        }
+        else if (directive == "moves") {
+            std::string keys;
+            in >> keys;
+            for (char key : keys) {
+                switch (key) {
+                    case 'w': script.moves.push_back(Direction::UP); break;
+                    case 's': script.moves.push_back(Direction::DOWN); break;
+                    case 'a': script.moves.push_back(Direction::LEFT); break;
+                    case 'd': script.moves.push_back(Direction::RIGHT); break;
+                    case '.': script.moves.push_back(Direction::STAY); break;
+                    default:
+                        throw std::runtime_error(path + ":" + std::to_string(lineNumber) + ": bad move '" + key + "'");
+                }
+            }
+        }
+        else if (directive == "expect") {
+            std::string key, hash;
+            while (in >> key) {
+                if (key == "score") in >> script.expectScore;
+                else if (key == "ticks") in >> script.expectTicks;
+                else if (key == "hash") {
+                    in >> hash;
+                    script.expectHash = std::stoull(hash, nullptr, 16);
+                }
+            }
+            script.hasExpect = true;
+        }
+        else {
+            throw std::runtime_error(path + ":" + std::to_string(lineNumber) + ": unknown directive " + directive);
+        }
+    }
+
+    if (script.boardFile.empty() && script.size < 3) {
+        throw std::runtime_error(path + ": needs a board file or a size of at least 3");
+    }
+    return script;
+}
+
+/**
+ * Replace (or add) the expect line of a script with new golden values
+ */
+bool writeExpect(const Script& script, const Outcome& outcome) {
+    std::ifstream in(script.path);
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream words(line);
+        std::string directive;
+        if (words >> directive && directive == "expect") {
+            continue;
+        }
+        lines.push_back(line);
+    }
+    in.close();
+
+    std::ofstream out(script.path);
+    for (const std::string& kept : lines) {
+        out << kept << "\n";
+    }
+    out << "expect score " << outcome.score << " ticks " << outcome.ticks
+        << " hash " << hexHash(outcome.hash) << "\n";
+    return out.good();
+}
+
+/**
+ * Replay a script once
+ * @param counter Instruction counter wrapped around the tick loop
+ * @param instructions Set to the instructions counted
+ * @return Nanoseconds spent in the tick loop
+ */
+double replay(const Script& script, Outcome& outcome, InstructionCounter& counter, uint64_t& instructions) {
+    Board* board = script.boardFile.empty() ? new Board(script.size, script.ghosts) : new Board(script.boardFile);
+    board->setGhostNav(script.nav);
+    if (script.hardDepth > 0) {
+        GhostSearchOptions options;
+        options.budgetMs = 0;
+        options.maxDepth = script.hardDepth;
+        options.model = script.model;
+        board->setGhostDifficulty(GhostDifficulty::HARD, options);
+    }
+    if (script.patrol) {
+        std::vector<GridTarget> corners = GhostScripts::corners(board->getGridSize());
+        for (size_t i = 0; i < board->getGhosts().size(); i++) {
+            board->setGhostScript(static_cast<int>(i), GhostScripts::patrol, corners, 5, 10);
+        }
+    }
+
+    int ticks = 0;
+    auto start = std::chrono::steady_clock::now();
+    counter.start();
+    for (Direction move : script.moves) {
+        if (board->getIsGameOver()) {
+            break;
+        }
+        board->move(move);
+        ticks++;
+    }
+    instructions = counter.stop();
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    std::string text;
+    board->writeString(text);
+    outcome.score = board->getScore();
+    outcome.ticks = ticks;
+    outcome.hash = fnv1a(text);
+    delete board;
+    return ns;
+}
+
+/**
+ * Load a baseline file written by --save-baseline
+ */
+std::map<std::string, Baseline> loadBaseline(const std::string& path) {
+    std::map<std::string, Baseline> baseline;
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("cannot open baseline " + path);
+    }
+    std::string name;
+    Baseline entry;
+    while (file >> name >> entry.nsPerTick >> entry.instructionsPerTick) {
+        baseline[name] = entry;
+    }
+    return baseline;
+}
+
+void printUsage() {
+    std::cout << "Usage: pacman-regress [--update] [--repeat n] [--baseline file]" << std::endl;
+    std::cout << "                      [--save-baseline file] [--threshold pct] script..." << std::endl;
+    std::cout << std::endl;
+    std::cout << "  --update               -> Rewrite the expect lines with the current outcome" << std::endl;
+    std::cout << "  --repeat [n]           -> Replays per script; the fastest counts (default: 20)" << std::endl;
+    std::cout << "  --baseline [file]      -> Flag scripts slower than this baseline" << std::endl;
+    std::cout << "  --save-baseline [file] -> Write this run's costs as a new baseline" << std::endl;
+    std::cout << "  --threshold [pct]      -> Allowed slowdown in percent (default: 10)" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Slowdowns compare instructions per tick when both runs have them" << std::endl;
+    std::cout << "(perf_event_open), otherwise wall time per tick." << std::endl;
+    std::cout << "Exit status: 0 ok, 1 behaviour drift, 3 slowdown only." << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<std::string> args(argv, argv + argc);
+
+    bool update = false;
+    int repeat = 20;
+    double thresholdPct = 10;
+    std::string baselineFile = "";
+    std::string saveBaselineFile = "";
+    std::vector<std::string> scriptFiles;
+
+    for (size_t i = 1; i < args.size(); i++) {
+        if (args[i] == "--update") {
+            update = true;
+        }
+        else if (args[i] == "--repeat" && i + 1 < args.size()) {
+            repeat = std::max(1, std::stoi(args[++i]));
+        }
+        else if (args[i] == "--baseline" && i + 1 < args.size()) {
+            baselineFile = args[++i];
+        }
+        else if (args[i] == "--save-baseline" && i + 1 < args.size()) {
+            saveBaselineFile = args[++i];
+        }
+        else if (args[i] == "--threshold" && i + 1 < args.size()) {
+            thresholdPct = std::stod(args[++i]);
+        }
+        else if (args[i] == "-h" || args[i] == "--help" || args[i][0] == '-') {
+            printUsage();
+            return args[i] == "-h" || args[i] == "--help" ? 0 : 1;
+        }
+        else {
+            scriptFiles.push_back(args[i]);
+        }
+    }
+    if (scriptFiles.empty()) {
+        printUsage();
+        return 1;
+    }
+
+    int drift = 0, slow = 0;
+    try {
+        std::map<std::string, Baseline> baseline;
+        if (!baselineFile.empty()) {
+            baseline = loadBaseline(baselineFile);
+        }
+        std::ofstream saveBaseline;
+        if (!saveBaselineFile.empty()) {
+            saveBaseline.open(saveBaselineFile);
+            if (!saveBaseline.is_open()) {
+                throw std::runtime_error("cannot write baseline " + saveBaselineFile);
+            }
+        }
+
+        InstructionCounter counter;
+        std::cout << "{\"harness\": \"regress\", \"instruction_counter\": "
+                  << (counter.isAvailable() ? "true" : "false")
+                  << ", \"repeat\": " << repeat << ", \"results\": [";
+
+        for (size_t s = 0; s < scriptFiles.size(); s++) {
+            Script script = loadScript(scriptFiles[s]);
+
+            // Keep the fastest replay; every replay must end the same way
+            Outcome outcome;
+            double bestNs = 0;
+            uint64_t bestInstructions = 0;
+            for (int r = 0; r < repeat; r++) {
+                Outcome run;
+                uint64_t instructions = 0;
+                double ns = replay(script, run, counter, instructions);
+                if (r > 0 && (run.hash != outcome.hash || run.ticks != outcome.ticks)) {
+                    throw std::runtime_error(script.name + ": replays are not deterministic");
+                }
+                if (r == 0 || ns < bestNs) {
+                    bestNs = ns;
+                    bestInstructions = instructions;
+                }
+                outcome.score = run.score;
+                outcome.ticks = run.ticks;
+                outcome.hash = run.hash;
+            }
+            int ticks = std::max(1, outcome.ticks);
+            outcome.nsPerTick = bestNs / ticks;
+            if (counter.isAvailable()) {
+                outcome.instructionsPerTick = static_cast<double>(bestInstructions) / ticks;
+            }
+
+            // Behaviour
+            std::string status = "ok";
+            if (update) {
+                if (!writeExpect(script, outcome)) {
+                    throw std::runtime_error("cannot update " + script.path);
+                }
+                status = "updated";
+            }
+            else if (!script.hasExpect) {
+                status = "no-golden";
+                std::cerr << script.name << ": no expect line (run with --update)" << std::endl;
+                drift++;
+            }
+            else if (outcome.score != script.expectScore || outcome.ticks != script.expectTicks ||
+                     outcome.hash != script.expectHash) {
+                status = "drift";
+                std::cerr << script.name << ": DRIFT - expected score " << script.expectScore
+                          << " ticks " << script.expectTicks << " hash " << hexHash(script.expectHash)
+                          << ", got score " << outcome.score << " ticks " << outcome.ticks
+                          << " hash " << hexHash(outcome.hash) << std::endl;
+                drift++;
+            }
+
+            // Performance
+            double slowdownPct = 0;
+            auto base = baseline.find(script.name);
+            if (base != baseline.end()) {
+                bool useInstructions = outcome.instructionsPerTick >= 0 && base->second.instructionsPerTick > 0;
+                double now = useInstructions ? outcome.instructionsPerTick : outcome.nsPerTick;
+                double before = useInstructions ? base->second.instructionsPerTick : base->second.nsPerTick;
+                slowdownPct = before > 0 ? (now / before - 1) * 100 : 0;
+                if (slowdownPct > thresholdPct) {
+                    std::cerr << script.name << ": SLOWER by " << slowdownPct << "% ("
+                              << (useInstructions ? "instructions" : "ns") << " per tick " << before
+                              << " -> " << now << ")" << std::endl;
+                    if (status == "ok") {
+                        status = "slow";
+                    }
+                    slow++;
+                }
+            }
+            if (saveBaseline.is_open()) {
+                saveBaseline << script.name << " " << outcome.nsPerTick << " " << outcome.instructionsPerTick << "\n";
+            }
+
+            std::cout << (s == 0 ? "\n" : ",\n")
+                      << "  {\"script\": \"" << script.name << "\""
+                      << ", \"status\": \"" << status << "\""
+                      << ", \"score\": " << outcome.score
+                      << ", \"ticks\": " << outcome.ticks
+                      << ", \"hash\": \"" << hexHash(outcome.hash) << "\""
+                      << ", \"ns_per_tick\": " << outcome.nsPerTick
+                      << ", \"instructions_per_tick\": ";
+            if (outcome.instructionsPerTick >= 0) {
+                std::cout << outcome.instructionsPerTick;
+            } else {
+                std::cout << "null";
+            }
+            if (base != baseline.end()) {
+                std::cout << ", \"slowdown_pct\": " << slowdownPct;
+            }
+            std::cout << "}";
+        }
+        std::cout << "\n]}" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return -1;
+    }
+
+    if (drift > 0) {
+        std::cerr << drift << " script(s) drifted from their golden values" << std::endl;
+        return 1;
+    }
+    if (slow > 0) {
+        std::cerr << slow << " script(s) slower than the baseline" << std::endl;
+        return 3;
+    }
+    return 0;
+}
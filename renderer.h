@@ -0,0 +1,152 @@
+// renderer.h
+
+#ifndef RENDERER_H
+#define RENDERER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include "thread_pool.h"
+
+/**
+ * RenderColor - backend independent RGBA color
+ */
+struct RenderColor {
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+    uint8_t a;
+
+    constexpr RenderColor(uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha = 255)
+        : r(red), g(green), b(blue), a(alpha) {}
+};
+
+/**
+ * Text alignment for Renderer::drawText
+ *   LEFT   - (x, y) is the top-left corner of the text
+ *   CENTER - (x, y) is the center of the text bounds
+ */
+enum class TextAlign {
+    LEFT,
+    CENTER
+};
+
+/**
+ * TextureData - encoded image bytes in memory and the name to register them under
+ */
+struct TextureData {
+    std::string name;
+    const unsigned char* data;
+    size_t size;
+};
+
+/**
+ * RendererMemory - bytes held by a renderer, by part
+ */
+struct RendererMemory {
+    size_t textures;   // Texture pixels (RGBA) and their names
+    size_t text;       // Cached text objects and their strings
+    size_t surface;    // Drawing surface pixels held in CPU memory
+
+    size_t total() const { return textures + text + surface; }
+};
+
+/**
+ * BASE CLASS: Renderer
+ * Abstract drawing surface used by GameView to draw the tile layer,
+ * sprites and HUD. Backends:
+ *   - SfmlRenderer:        draws into an sf::RenderWindow
+ *   - FramebufferRenderer: draws into CPU memory (headless)
+ */
+class Renderer {
+public:
+    virtual ~Renderer() {}
+
+    /**
+     * Load a set of textures from encoded images in memory
+     * Decoding runs on the pool; anything that must happen on the
+     * rendering thread (GPU upload) happens on the calling thread.
+     * @param images The encoded images to load
+     * @param pool Worker threads used for decoding
+     * @return For each image, true if it was loaded
+     */
+    virtual std::vector<bool> loadTextures(const std::vector<TextureData>& images, ThreadPool& pool) = 0;
+
+    /**
+     * Load the font used by drawText from memory
+     * @param data Font file bytes (must stay valid while the renderer is used)
+     * @param size Number of bytes
+     * @return true if the font was loaded
+     */
+    virtual bool loadFont(const unsigned char* data, size_t size) = 0;
+
+    /**
+     * Check if a texture with the given name was loaded
+     */
+    virtual bool hasTexture(const std::string& name) const = 0;
+
+    /**
+     * Get the pixel size of a loaded texture
+     * @return false if no texture with that name was loaded
+     */
+    virtual bool getTextureSize(const std::string& name, unsigned& width, unsigned& height) const = 0;
+
+    /**
+     * Get the size of the drawing surface in pixels
+     */
+    virtual unsigned getWidth() const = 0;
+    virtual unsigned getHeight() const = 0;
+
+    /**
+     * Start a new frame by filling the surface with a color
+     */
+    virtual void clear(RenderColor color) = 0;
+
+    /**
+     * Draw a texture stretched to the given rectangle
+     * @param name The texture name
+     * @param x Left edge
+     * @param y Top edge
+     * @param width Drawn width
+     * @param height Drawn height
+     * @param rotation Rotation in degrees around the rectangle center
+     */
+    virtual void drawTexture(const std::string& name, float x, float y,
+                             float width, float height, float rotation) = 0;
+
+    /**
+     * Draw a filled rectangle
+     */
+    virtual void drawRect(float x, float y, float width, float height, RenderColor color) = 0;
+
+    /**
+     * Draw a filled circle whose bounding box starts at (x, y)
+     */
+    virtual void drawCircle(float x, float y, float radius, RenderColor color) = 0;
+
+    /**
+     * Draw a line of text
+     * @param text The text to draw
+     * @param size Character size in pixels
+     * @param color Fill color
+     * @param x Horizontal position (see TextAlign)
+     * @param y Vertical position (see TextAlign)
+     * @param align How (x, y) relates to the text bounds
+     * @param bold Draw in bold style
+     */
+    virtual void drawText(std::string_view text, unsigned size, RenderColor color,
+                          float x, float y, TextAlign align, bool bold) = 0;
+
+    /**
+     * Finish the current frame
+     */
+    virtual void display() = 0;
+
+    /**
+     * Get the memory held for textures, text and the surface
+     */
+    virtual RendererMemory memoryUsage() const = 0;
+};
+
+#endif // RENDERER_H
@@ -0,0 +1,80 @@
+// script_arena.cpp
+
+#include "script_arena.h"
+#include <new>
+
+namespace {
+
+const size_t LARGE_BYTES = ScriptArena::BLOCK_BYTES / 4;
+
+size_t sizeClass(size_t bytes) {
+    return (bytes + ScriptArena::ALIGNMENT - 1) / ScriptArena::ALIGNMENT;
+}
+
+} // namespace
+
+const size_t ScriptArena::BLOCK_BYTES;
+const size_t ScriptArena::ALIGNMENT;
+
+/**
+ * Constructor - allocates nothing until the first frame
+ */
+ScriptArena::ScriptArena()
+    : cursor(nullptr), blockEnd(nullptr), liveBytes(0), largeBytes(0) {}
+
+/**
+ * Destructor - frees every block (all frames must have been released)
+ */
+ScriptArena::~ScriptArena() {
+    for (char* block : blocks) {
+        ::operator delete(block, std::align_val_t(ALIGNMENT));
+    }
+}
+
+void* ScriptArena::allocate(size_t bytes) {
+    size_t size = sizeClass(bytes);
+    liveBytes += size * ALIGNMENT;
+    if (bytes > LARGE_BYTES) {
+        largeBytes += size * ALIGNMENT;
+        return ::operator new(size * ALIGNMENT, std::align_val_t(ALIGNMENT));
+    }
+
+    if (freeLists.empty()) {
+        freeLists.assign(sizeClass(LARGE_BYTES) + 1, nullptr);
+    }
+    void*& head = freeLists[size];
+    if (head != nullptr) {
+        void* memory = head;
+        head = *static_cast<void**>(memory);
+        return memory;
+    }
+    if (cursor == nullptr || static_cast<size_t>(blockEnd - cursor) < size * ALIGNMENT) {
+        blocks.push_back(static_cast<char*>(::operator new(BLOCK_BYTES, std::align_val_t(ALIGNMENT))));
+        cursor = blocks.back();
+        blockEnd = cursor + BLOCK_BYTES;
+    }
+    void* memory = cursor;
+    cursor += size * ALIGNMENT;
+    return memory;
+}
+
+void ScriptArena::release(void* memory, size_t bytes) {
+    size_t size = sizeClass(bytes);
+    liveBytes -= size * ALIGNMENT;
+    if (bytes > LARGE_BYTES) {
+        largeBytes -= size * ALIGNMENT;
+        ::operator delete(memory, std::align_val_t(ALIGNMENT));
+        return;
+    }
+    *static_cast<void**>(memory) = freeLists[size];
+    freeLists[size] = memory;
+}
+
+size_t ScriptArena::getLiveBytes() const {
+    return liveBytes;
+}
+
+size_t ScriptArena::memoryUsage() const {
+    return blocks.size() * BLOCK_BYTES + blocks.capacity() * sizeof(char*)
+         + freeLists.capacity() * sizeof(void*) + largeBytes;
+}
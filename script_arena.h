@@ -0,0 +1,60 @@
+// script_arena.h
+
+#ifndef SCRIPT_ARENA_H
+#define SCRIPT_ARENA_H
+
+#include <vector>
+#include <cstddef>
+
+/**
+ * ScriptArena class - memory for the coroutine frames of one board's
+ * ghost scripts
+ * Frames are carved from 64 KB blocks and, when freed, kept on a free
+ * list for their size (rounded up to 16 bytes). A script's frames all have
+ * sizes fixed at compile time, so a board running thousands of copies of
+ * a few behaviours reuses the same handful of lists and never returns to
+ * the heap after warming up. Frames larger than a quarter block go to the
+ * heap directly. Blocks are released when the arena is destroyed.
+ */
+class ScriptArena {
+public:
+    static const size_t BLOCK_BYTES = 64 * 1024;
+    static const size_t ALIGNMENT = 16;
+
+    ScriptArena();
+    ~ScriptArena();
+
+    ScriptArena(const ScriptArena&) = delete;
+    ScriptArena& operator=(const ScriptArena&) = delete;
+
+    /**
+     * Get memory for a frame, aligned to ALIGNMENT
+     */
+    void* allocate(size_t bytes);
+
+    /**
+     * Give back memory from allocate()
+     * @param bytes The size it was allocated with
+     */
+    void release(void* memory, size_t bytes);
+
+    /**
+     * Get the bytes of frames currently allocated
+     */
+    size_t getLiveBytes() const;
+
+    /**
+     * Get the heap bytes this arena owns
+     */
+    size_t memoryUsage() const;
+
+private:
+    std::vector<char*> blocks;
+    char* cursor;                   // Next free byte of the last block
+    char* blockEnd;
+    std::vector<void*> freeLists;   // Per size class: freed frames, linked through their first word
+    size_t liveBytes;
+    size_t largeBytes;              // Live frames that went to the heap
+};
+
+#endif // SCRIPT_ARENA_H
@@ -0,0 +1,119 @@
+// server_main.cpp
+// Game server entry point: hosts many concurrent games over a local socket
+// (see game_protocol.h for the wire format and bench/server_load.cpp for a
+// load-generating client).
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <csignal>
+#include <sys/resource.h>
+#include "game_server.h"
+#include "trace.h"
+
+namespace {
+
+GameServer* runningServer = nullptr;
+
+void onSignal(int) {
+    if (runningServer != nullptr) {
+        runningServer->stop();
+    }
+}
+
+/**
+ * Raise the open file limit to the hard limit so thousands of clients fit
+ * @return The new soft limit
+ */
+rlim_t raiseFileLimit() {
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) != 0) {
+        return 0;
+    }
+    if (limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+        getrlimit(RLIMIT_NOFILE, &limit);
+    }
+    return limit.rlim_cur;
+}
+
+void printUsage() {
+    std::cout << "Usage: pacman-server [--unix path | --port n] [-w workers] [--max-size n]" << std::endl;
+    std::cout << "                     [--trace file]" << std::endl;
+    std::cout << std::endl;
+    std::cout << "  --unix [path]   -> Listen on a Unix socket (default: pacman.sock)" << std::endl;
+    std::cout << "  --port [n]      -> Listen on a TCP port on 127.0.0.1 instead" << std::endl;
+    std::cout << "  -w [workers]    -> Worker threads (default: hardware threads)" << std::endl;
+    std::cout << "  --max-size [n]  -> Largest board a client may start (default: 100)" << std::endl;
+    std::cout << "  --trace [file]  -> Record a Chrome trace (build with make TRACE=1)" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Ctrl-C stops the server and prints its totals." << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<std::string> args(argv, argv + argc);
+
+    std::string unixPath = "pacman.sock";
+    int port = 0;
+    unsigned workers = 0;
+    int maxSize = 100;
+
+    for (size_t i = 1; i < args.size(); i++) {
+        if (args[i] == "--unix" && i + 1 < args.size()) {
+            unixPath = args[++i];
+        }
+        else if (args[i] == "--port" && i + 1 < args.size()) {
+            port = std::stoi(args[++i]);
+        }
+        else if (args[i] == "-w" && i + 1 < args.size()) {
+            workers = static_cast<unsigned>(std::stoul(args[++i]));
+        }
+        else if (args[i] == "--max-size" && i + 1 < args.size()) {
+            maxSize = std::stoi(args[++i]);
+        }
+        else if (args[i] == "--trace" && i + 1 < args.size()) {
+            Trace::start(args[++i]);
+        }
+        else {
+            printUsage();
+            return args[i] == "-h" || args[i] == "--help" ? 0 : 1;
+        }
+    }
+
+    try {
+        rlim_t fileLimit = raiseFileLimit();
+        GameServer server(workers, maxSize);
+        if (port > 0) {
+            server.listenTcp(port);
+            std::cerr << "Listening on 127.0.0.1:" << port;
+        } else {
+            server.listenUnix(unixPath);
+            std::cerr << "Listening on " << unixPath;
+        }
+        std::cerr << " (file limit " << fileLimit << ")" << std::endl;
+
+        runningServer = &server;
+        std::signal(SIGINT, onSignal);
+        std::signal(SIGTERM, onSignal);
+        std::signal(SIGPIPE, SIG_IGN);
+        server.run();
+        runningServer = nullptr;
+
+        ServerStats stats = server.getStats();
+        std::cout << "{\"server\": \"pacman\""
+                  << ", \"sessions\": " << stats.sessions
+                  << ", \"frames\": " << stats.frames
+                  << ", \"moves\": " << stats.moves << "}" << std::endl;
+    } catch (const std::exception& e) {
+        runningServer = nullptr;
+        std::cerr << "Error: " << e.what() << std::endl;
+        Trace::stop();
+        return -1;
+    }
+
+    Trace::stop();
+    return 0;
+}
@@ -0,0 +1,211 @@
+// sfml_renderer.cpp
+
+#include "sfml_renderer.h"
+#include <mutex>
+
+/**
+ * Constructor
+ */
+SfmlRenderer::SfmlRenderer(sf::RenderWindow& window) : window(window), textIndex(0) {}
+
+/**
+ * Destructor
+ */
+SfmlRenderer::~SfmlRenderer() {}
+
+/**
+ * Decode images on the pool, then upload each one once on this thread
+ * (the thread that owns the OpenGL context)
+ */
+std::vector<bool> SfmlRenderer::loadTextures(const std::vector<TextureData>& images, ThreadPool& pool) {
+    std::vector<sf::Image> decodedImages(images.size());
+    std::vector<char> decoded(images.size(), 0);
+
+    pool.parallelFor(static_cast<int>(images.size()), [&](int i) {
+        decoded[i] = decodedImages[i].loadFromMemory(images[i].data, images[i].size);
+    });
+
+    std::vector<bool> loaded(images.size(), false);
+    for (size_t i = 0; i < images.size(); i++) {
+        if (!decoded[i]) continue;
+
+        // Construct the texture in place - no copy into the map
+        sf::Texture& texture = textures[images[i].name];
+        loaded[i] = texture.loadFromImage(decodedImages[i]);
+        if (!loaded[i]) {
+            textures.erase(images[i].name);
+        }
+    }
+    return loaded;
+}
+
+/**
+ * Load the font used for text
+ * Fonts are cached by address for the whole process, so every renderer
+ * (and every new game window) reuses the first parsed copy.
+ */
+bool SfmlRenderer::loadFont(const unsigned char* data, size_t size) {
+    static std::mutex cacheMutex;
+    static std::map<const unsigned char*, std::shared_ptr<const sf::Font>> cache;
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto it = cache.find(data);
+    if (it == cache.end()) {
+        // sf::Font reads glyphs lazily from this memory, so it must stay valid
+        auto loaded = std::make_shared<sf::Font>();
+        if (!loaded->loadFromMemory(data, size)) {
+            return false;
+        }
+        it = cache.emplace(data, loaded).first;
+    }
+    font = it->second;
+    textCache.clear();   // Cached labels point at the previous font
+    return true;
+}
+
+bool SfmlRenderer::hasTexture(const std::string& name) const {
+    return textures.count(name) > 0;
+}
+
+bool SfmlRenderer::getTextureSize(const std::string& name, unsigned& width, unsigned& height) const {
+    auto it = textures.find(name);
+    if (it == textures.end()) {
+        return false;
+    }
+    sf::Vector2u size = it->second.getSize();
+    width = size.x;
+    height = size.y;
+    return true;
+}
+
+unsigned SfmlRenderer::getWidth() const {
+    return window.getSize().x;
+}
+
+unsigned SfmlRenderer::getHeight() const {
+    return window.getSize().y;
+}
+
+/**
+ * Start a frame
+ */
+void SfmlRenderer::clear(RenderColor color) {
+    textIndex = 0;
+
+    // Update view to match current window size (fixes resize issues)
+    sf::View view(sf::FloatRect(0, 0, window.getSize().x, window.getSize().y));
+    window.setView(view);
+
+    window.clear(toSfColor(color));
+}
+
+/**
+ * Draw a texture scaled to the given rectangle
+ */
+void SfmlRenderer::drawTexture(const std::string& name, float x, float y,
+                               float width, float height, float rotation) {
+    auto it = textures.find(name);
+    if (it == textures.end()) {
+        return;
+    }
+
+    sf::Sprite sprite;
+    sprite.setTexture(it->second);
+    sf::Vector2u textureSize = it->second.getSize();
+    sprite.setScale(width / textureSize.x, height / textureSize.y);
+
+    if (rotation != 0) {
+        sprite.setOrigin(textureSize.x / 2.0f, textureSize.y / 2.0f);
+        sprite.setPosition(x + width / 2.0f, y + height / 2.0f);
+        sprite.setRotation(rotation);
+    } else {
+        sprite.setPosition(x, y);
+    }
+
+    window.draw(sprite);
+}
+
+/**
+ * Draw a filled rectangle
+ */
+void SfmlRenderer::drawRect(float x, float y, float width, float height, RenderColor color) {
+    sf::RectangleShape rect(sf::Vector2f(width, height));
+    rect.setPosition(x, y);
+    rect.setFillColor(toSfColor(color));
+    window.draw(rect);
+}
+
+/**
+ * Draw a filled circle
+ */
+void SfmlRenderer::drawCircle(float x, float y, float radius, RenderColor color) {
+    sf::CircleShape circle(radius);
+    circle.setPosition(x, y);
+    circle.setFillColor(toSfColor(color));
+    window.draw(circle);
+}
+
+/**
+ * Draw a line of text
+ */
+void SfmlRenderer::drawText(std::string_view text, unsigned size, RenderColor color,
+                            float x, float y, TextAlign align, bool bold) {
+    if (!font) return;
+
+    if (textIndex == textCache.size()) {
+        textCache.push_back(CachedText{std::string(), 0, false, TextAlign::LEFT, sf::Text()});
+        textCache.back().label.setFont(*font);
+    }
+    CachedText& cached = textCache[textIndex++];
+
+    // Rebuild only when this slot shows something different from last frame
+    if (cached.text != text || cached.size != size || cached.bold != bold || cached.align != align) {
+        cached.text.assign(text.data(), text.size());
+        cached.size = size;
+        cached.bold = bold;
+        cached.align = align;
+        cached.label.setString(cached.text);
+        cached.label.setCharacterSize(size);
+        cached.label.setStyle(bold ? sf::Text::Bold : sf::Text::Regular);
+        if (align == TextAlign::CENTER) {
+            sf::FloatRect bounds = cached.label.getLocalBounds();
+            cached.label.setOrigin(bounds.width / 2, bounds.height / 2);
+        } else {
+            cached.label.setOrigin(0, 0);
+        }
+    }
+
+    cached.label.setFillColor(toSfColor(color));
+    cached.label.setPosition(x, y);
+    window.draw(cached.label);
+}
+
+/**
+ * Present the frame
+ */
+void SfmlRenderer::display() {
+    window.display();
+}
+
+/**
+ * Texture bytes are the RGBA pixels uploaded to the GPU; each cached
+ * label also holds its UTF-32 string and one quad (6 vertices) per glyph
+ */
+RendererMemory SfmlRenderer::memoryUsage() const {
+    RendererMemory memory{0, 0, 0};
+    for (const auto& entry : textures) {
+        sf::Vector2u size = entry.second.getSize();
+        memory.textures += sizeof(entry) + entry.first.capacity()
+                         + static_cast<size_t>(size.x) * size.y * 4;
+    }
+    memory.text = textCache.capacity() * sizeof(CachedText);
+    for (const CachedText& cached : textCache) {
+        memory.text += cached.text.capacity()
+                     + cached.text.size() * (sizeof(sf::Uint32) + 6 * sizeof(sf::Vertex));
+    }
+    return memory;
+}
+
+sf::Color SfmlRenderer::toSfColor(RenderColor color) {
+    return sf::Color(color.r, color.g, color.b, color.a);
+}
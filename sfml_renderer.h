@@ -0,0 +1,71 @@
+// sfml_renderer.h
+
+#ifndef SFML_RENDERER_H
+#define SFML_RENDERER_H
+
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <map>
+#include <memory>
+#include <vector>
+#include "renderer.h"
+
+/**
+ * SfmlRenderer class - Renderer backend that draws into an SFML window
+ */
+class SfmlRenderer : public Renderer {
+public:
+    /**
+     * Constructor
+     * @param window The window to draw into (must outlive the renderer)
+     */
+    SfmlRenderer(sf::RenderWindow& window);
+
+    ~SfmlRenderer();
+
+    std::vector<bool> loadTextures(const std::vector<TextureData>& images, ThreadPool& pool) override;
+    bool loadFont(const unsigned char* data, size_t size) override;
+    bool hasTexture(const std::string& name) const override;
+    bool getTextureSize(const std::string& name, unsigned& width, unsigned& height) const override;
+    unsigned getWidth() const override;
+    unsigned getHeight() const override;
+    void clear(RenderColor color) override;
+    void drawTexture(const std::string& name, float x, float y,
+                     float width, float height, float rotation) override;
+    void drawRect(float x, float y, float width, float height, RenderColor color) override;
+    void drawCircle(float x, float y, float radius, RenderColor color) override;
+    void drawText(std::string_view text, unsigned size, RenderColor color,
+                  float x, float y, TextAlign align, bool bold) override;
+    void display() override;
+    RendererMemory memoryUsage() const override;
+
+private:
+    sf::RenderWindow& window;
+    std::shared_ptr<const sf::Font> font;   // Shared with other renderers through the font cache
+
+    // Textures for game elements
+    std::map<std::string, sf::Texture> textures;
+
+    /**
+     * CachedText - an sf::Text kept between frames with the settings it was built from
+     */
+    struct CachedText {
+        std::string text;
+        unsigned size;
+        bool bold;
+        TextAlign align;
+        sf::Text label;
+    };
+
+    // Text objects by the order they are drawn in a frame; a screen draws
+    // the same strings every frame, so steady-state frames reuse them as-is
+    std::vector<CachedText> textCache;
+    size_t textIndex;
+
+    /**
+     * Convert a RenderColor to an SFML color
+     */
+    static sf::Color toSfColor(RenderColor color);
+};
+
+#endif // SFML_RENDERER_H
@@ -0,0 +1,511 @@
+// sim_main.cpp
+// Headless simulation entry point: plays games with a scripted Pac-Man
+// policy and reports the results. Links only the core library, so it
+// builds and runs on machines without a display or graphics libraries.
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <fstream>
+#include <sys/resource.h>
+#include <unistd.h>
+#include "Board.h"
+#include "pacman_autopilot.h"
+#include "trace.h"
+#include "alloc_counter.h"
+
+namespace {
+
+const Direction MOVES[] = {Direction::UP, Direction::DOWN, Direction::LEFT, Direction::RIGHT};
+
+// Largest board side whose cell indices (row * size + col) fit in an int
+const int MAX_BOARD_SIZE = 46340;
+
+/**
+ * Pac-Man policies the simulator can play
+ */
+enum class Policy {
+    RANDOM,   // Any move that stays on the board
+    GREEDY,   // Prefer uneaten neighbours, avoid ghosts, else random
+    MCTS      // Ask a PacmanAutopilot
+};
+
+/**
+ * Totals over all simulated games
+ */
+struct SimStats {
+    int games = 0;
+    int wins = 0;        // Board cleared
+    int losses = 0;      // Caught by a ghost
+    int timeouts = 0;    // Hit the tick limit
+    long long ticks = 0;
+    long long totalScore = 0;
+    uint64_t tickAllocations = 0;   // Heap allocations inside the tick loops
+    long long pathSearches = 0;     // A* runs (--nav astar)
+    long long pathExpanded = 0;     // Cells those runs expanded
+    int tables = 0;                 // Boards loaded with a distance table
+    int cachedTables = 0;           // ... read from their cache file
+    double tableMs = 0.0;           // Building or reading those tables
+    long long searchDepths = 0;     // Sum over ticks of the depth searched (--hard-ghosts)
+    long long searchNodes = 0;
+    double searchMs = 0.0;
+};
+
+/**
+ * Check if a character is a ghost
+ */
+bool isGhostChar(char ch) {
+    return ch == 'G' || (ch >= 'A' && ch <= 'D');
+}
+
+/**
+ * Pick Pac-Man's next move
+ */
+Direction chooseMove(Board& board, Policy policy, PacmanAutopilot* autopilot, std::mt19937& rng) {
+    if (policy == Policy::MCTS) {
+        return autopilot->chooseMove(board);
+    }
+    Direction options[4];
+    int count = 0;
+    for (Direction dir : MOVES) {
+        if (board.canMove(dir)) {
+            options[count++] = dir;
+        }
+    }
+    if (count == 0) {
+        return Direction::STAY;
+    }
+
+    if (policy == Policy::GREEDY) {
+        Direction safeDots[4];
+        Direction safe[4];
+        int dotCount = 0, safeCount = 0;
+        int row = board.getPacman()->getRow();
+        int col = board.getPacman()->getCol();
+        for (int i = 0; i < count; i++) {
+            char target = board.getGridChar(row + DirectionHelper::getY(options[i]),
+                                            col + DirectionHelper::getX(options[i]));
+            if (isGhostChar(target)) {
+                continue;
+            }
+            safe[safeCount++] = options[i];
+            if (target == '*' || target == 'o') {
+                safeDots[dotCount++] = options[i];
+            }
+        }
+        if (dotCount > 0) {
+            return safeDots[std::uniform_int_distribution<int>(0, dotCount - 1)(rng)];
+        }
+        if (safeCount > 0) {
+            return safe[std::uniform_int_distribution<int>(0, safeCount - 1)(rng)];
+        }
+    }
+    return options[std::uniform_int_distribution<int>(0, count - 1)(rng)];
+}
+
+/**
+ * Get the resident set size of this process in bytes
+ * Reads /proc/self/statm where it exists, otherwise the peak RSS.
+ */
+size_t residentBytes() {
+    std::ifstream statm("/proc/self/statm");
+    size_t pages = 0, residentPages = 0;
+    if (statm >> pages >> residentPages) {
+        return residentPages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    }
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return static_cast<size_t>(usage.ru_maxrss);           // bytes
+#else
+    return static_cast<size_t>(usage.ru_maxrss) * 1024;    // kilobytes
+#endif
+}
+
+/**
+ * Get the memory available for new boards in bytes (0 if unknown)
+ */
+size_t availableBytes() {
+    std::ifstream meminfo("/proc/meminfo");
+    std::string key;
+    size_t value;
+    std::string unit;
+    while (meminfo >> key >> value >> unit) {
+        if (key == "MemAvailable:") {
+            return value * 1024;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Build boards from 10x10 up to the largest size that fits in limitBytes,
+ * doubling the side each step, and print their memory as one JSON document
+ */
+void memoryReport(int ghostCount, size_t limitBytes) {
+    // Largest side whose predicted footprint fits the limit
+    int low = 3, high = MAX_BOARD_SIZE;
+    while (low < high) {
+        int mid = low + (high - low + 1) / 2;
+        if (Board::estimateMemory(mid, ghostCount).total() <= limitBytes) {
+            low = mid;
+        } else {
+            high = mid - 1;
+        }
+    }
+    int maxSize = low;
+
+    std::vector<int> sizes;
+    for (int size = 10; size < maxSize; size *= 2) {
+        sizes.push_back(size);
+    }
+    sizes.push_back(maxSize);
+
+    std::cout << "{\"memory\": \"board\", \"ghosts\": " << ghostCount
+              << ", \"limit_bytes\": " << limitBytes
+              << ", \"max_size\": " << maxSize
+              << ", \"results\": [";
+    for (size_t i = 0; i < sizes.size(); i++) {
+        int size = sizes[i];
+        std::cerr << "size " << size << "..." << std::endl;
+        size_t rssBefore = residentBytes();
+        Board* board = new Board(size, ghostCount);
+        size_t rssAfter = residentBytes();
+        BoardMemory memory = board->memoryUsage();
+        double cells = static_cast<double>(size) * size;
+
+        std::cout << (i == 0 ? "\n" : ",\n")
+                  << "  {\"size\": " << size
+                  << ", \"bytes\": " << memory.total()
+                  << ", \"predicted_bytes\": " << Board::estimateMemory(size, ghostCount).total()
+                  << ", \"grid\": " << memory.grid
+                  << ", \"visited\": " << memory.visited
+                  << ", \"characters\": " << memory.characters
+                  << ", \"tracking\": " << memory.tracking
+                  << ", \"navigation\": " << memory.navigation
+                  << ", \"bytes_per_cell\": " << memory.total() / cells
+                  << ", \"rss_bytes\": " << rssAfter
+                  << ", \"rss_delta_bytes\": " << (rssAfter > rssBefore ? rssAfter - rssBefore : 0)
+                  << "}";
+        delete board;
+    }
+    std::cout << "\n]}" << std::endl;
+}
+
+void printUsage() {
+    std::cout << "Usage: pacman-sim [-s size] [-i inputFile] [--ghosts n] [-n games]" << std::endl;
+    std::cout << "                  [-t maxTicks] [--seed n] [--policy random|greedy|mcts] [--nav field|astar]" << std::endl;
+    std::cout << "                  [--mcts-ms ms] [--mcts-playouts n] [--mcts-threads n]" << std::endl;
+    std::cout << "                  [--classic-ghosts] [--patrol-ghosts]" << std::endl;
+    std::cout << "                  [--hard-ghosts] [--search-ms ms] [--search-depth n]" << std::endl;
+    std::cout << "                  [--search-threads n] [--pacman-model adversarial|probabilistic]" << std::endl;
+    std::cout << "                  [-o outputFile] [--apsp-budget mb] [--apsp-cache]" << std::endl;
+    std::cout << "                  [--trace file] [--mem-report] [--mem-limit mb]" << std::endl;
+    std::cout << std::endl;
+    std::cout << "  -s [size]       -> Board size (default: 10)" << std::endl;
+    std::cout << "  -i [file]       -> Start every game from a saved board" << std::endl;
+    std::cout << "  --ghosts [n]    -> Number of ghosts on new boards (default: 4)" << std::endl;
+    std::cout << "  -n [games]      -> Number of games to play (default: 100)" << std::endl;
+    std::cout << "  -t [ticks]      -> Tick limit per game (default: 10000)" << std::endl;
+    std::cout << "  --seed [n]      -> Random seed (default: 1)" << std::endl;
+    std::cout << "  --policy [name] -> Pac-Man policy (default: greedy)" << std::endl;
+    std::cout << "  --mcts-ms [ms]  -> mcts: search time per move (default: 50, 0 for playouts only)" << std::endl;
+    std::cout << "  --mcts-playouts [n] -> mcts: playouts per thread and move (default: no limit)" << std::endl;
+    std::cout << "  --mcts-threads [n] -> mcts: search threads (default: all cores)" << std::endl;
+    std::cout << "  --nav [name]    -> Ghost navigation: field or astar (default: field)" << std::endl;
+    std::cout << "  --classic-ghosts-> New boards get Blinky, Pinky, Inky and Clyde in the corners" << std::endl;
+    std::cout << "  --patrol-ghosts -> Script every ghost to patrol the corners, wait 5 and chase 10 ticks" << std::endl;
+    std::cout << "  --hard-ghosts   -> Chasers search ahead for their moves" << std::endl;
+    std::cout << "  --search-ms [ms]-> Search time per tick (default: 2, 0 for depth only)" << std::endl;
+    std::cout << "  --search-depth [n] -> Deepest search, in Pac-Man replies (default: 6)" << std::endl;
+    std::cout << "  --search-threads [n] -> Search threads (default: all cores)" << std::endl;
+    std::cout << "  --pacman-model [name] -> How the search expects Pac-Man to reply (default: adversarial)" << std::endl;
+    std::cout << "  -o [file]       -> Save the final board of the last game" << std::endl;
+    std::cout << "  --apsp-budget [mb] -> Memory for a loaded board's distance table (default: 32, 0 for none)" << std::endl;
+    std::cout << "  --apsp-cache    -> Keep distance tables next to the board file (file.apsp)" << std::endl;
+    std::cout << "  --trace [file]  -> Record a Chrome trace (build with make TRACE=1)" << std::endl;
+    std::cout << "  --mem-report    -> Print board memory for sizes 10 up to the largest that fits" << std::endl;
+    std::cout << "  --mem-limit [mb]-> Memory a report board may use (default: half of MemAvailable)" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<std::string> args(argv, argv + argc);
+
+    int boardSize = 10;
+    int ghostCount = 4;
+    int games = 100;
+    int maxTicks = 10000;
+    unsigned seed = 1;
+    std::string policyName = "greedy";
+    std::string navName = "field";
+    std::string inputFile = "";
+    std::string outputFile = "";
+    bool memReport = false;
+    bool classicGhosts = false;
+    bool patrolGhosts = false;
+    bool hardGhosts = false;
+    GhostSearchOptions searchOptions;
+    std::string modelName = "adversarial";
+    AutopilotOptions autopilotOptions;
+    size_t memLimitMb = 0;
+
+    for (size_t i = 1; i < args.size(); i++) {
+        if (args[i] == "-s" && i + 1 < args.size()) {
+            boardSize = std::stoi(args[++i]);
+        }
+        else if (args[i] == "-i" && i + 1 < args.size()) {
+            inputFile = args[++i];
+        }
+        else if (args[i] == "--ghosts" && i + 1 < args.size()) {
+            ghostCount = std::stoi(args[++i]);
+        }
+        else if (args[i] == "-n" && i + 1 < args.size()) {
+            games = std::stoi(args[++i]);
+        }
+        else if (args[i] == "-t" && i + 1 < args.size()) {
+            maxTicks = std::stoi(args[++i]);
+        }
+        else if (args[i] == "--seed" && i + 1 < args.size()) {
+            seed = static_cast<unsigned>(std::stoul(args[++i]));
+        }
+        else if (args[i] == "--nav" && i + 1 < args.size()) {
+            navName = args[++i];
+        }
+        else if (args[i] == "--classic-ghosts") {
+            classicGhosts = true;
+        }
+        else if (args[i] == "--patrol-ghosts") {
+            patrolGhosts = true;
+        }
+        else if (args[i] == "--hard-ghosts") {
+            hardGhosts = true;
+        }
+        else if (args[i] == "--search-ms" && i + 1 < args.size()) {
+            searchOptions.budgetMs = std::stod(args[++i]);
+        }
+        else if (args[i] == "--search-depth" && i + 1 < args.size()) {
+            searchOptions.maxDepth = std::stoi(args[++i]);
+        }
+        else if (args[i] == "--search-threads" && i + 1 < args.size()) {
+            searchOptions.threads = static_cast<unsigned>(std::stoul(args[++i]));
+        }
+        else if (args[i] == "--pacman-model" && i + 1 < args.size()) {
+            modelName = args[++i];
+        }
+        else if (args[i] == "--policy" && i + 1 < args.size()) {
+            policyName = args[++i];
+        }
+        else if (args[i] == "--mcts-ms" && i + 1 < args.size()) {
+            autopilotOptions.budgetMs = std::stod(args[++i]);
+        }
+        else if (args[i] == "--mcts-playouts" && i + 1 < args.size()) {
+            autopilotOptions.maxPlayouts = std::stoi(args[++i]);
+        }
+        else if (args[i] == "--mcts-threads" && i + 1 < args.size()) {
+            autopilotOptions.threads = static_cast<unsigned>(std::stoul(args[++i]));
+        }
+        else if (args[i] == "-o" && i + 1 < args.size()) {
+            outputFile = args[++i];
+        }
+        else if (args[i] == "--apsp-budget" && i + 1 < args.size()) {
+            Board::setDistanceTableBudget(std::stoul(args[++i]) * 1024 * 1024);
+        }
+        else if (args[i] == "--apsp-cache") {
+            Board::setDistanceTableCache(true);
+        }
+        else if (args[i] == "--trace" && i + 1 < args.size()) {
+            Trace::start(args[++i]);
+        }
+        else if (args[i] == "--mem-report") {
+            memReport = true;
+        }
+        else if (args[i] == "--mem-limit" && i + 1 < args.size()) {
+            memLimitMb = std::stoul(args[++i]);
+        }
+        else {
+            printUsage();
+            return args[i] == "-h" || args[i] == "--help" ? 0 : 1;
+        }
+    }
+
+    Policy policy;
+    if (policyName == "random") {
+        policy = Policy::RANDOM;
+    } else if (policyName == "greedy") {
+        policy = Policy::GREEDY;
+    } else if (policyName == "mcts") {
+        policy = Policy::MCTS;
+    } else {
+        std::cerr << "Error: unknown policy " << policyName << std::endl;
+        return 1;
+    }
+    GhostNav nav;
+    if (navName == "field") {
+        nav = GhostNav::DISTANCE_FIELD;
+    } else if (navName == "astar") {
+        nav = GhostNav::ASTAR;
+    } else {
+        std::cerr << "Error: unknown ghost navigation " << navName << std::endl;
+        return 1;
+    }
+    if (modelName == "adversarial") {
+        searchOptions.model = PacmanModel::ADVERSARIAL;
+    } else if (modelName == "probabilistic") {
+        searchOptions.model = PacmanModel::PROBABILISTIC;
+    } else {
+        std::cerr << "Error: unknown Pac-Man model " << modelName << std::endl;
+        return 1;
+    }
+    if (inputFile.empty() && boardSize < 3) {
+        std::cerr << "Error: board size must be at least 3" << std::endl;
+        return 1;
+    }
+
+    if (memReport) {
+        size_t limitBytes = memLimitMb * 1024 * 1024;
+        if (limitBytes == 0) {
+            limitBytes = availableBytes() / 2;
+        }
+        if (limitBytes == 0) {
+            limitBytes = 1024ULL * 1024 * 1024;
+            std::cerr << "Warning: available memory unknown, limiting boards to 1024 MB" << std::endl;
+        }
+        try {
+            memoryReport(ghostCount, limitBytes);
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            return -1;
+        }
+        return 0;
+    }
+
+    std::mt19937 rng(seed);
+    SimStats stats;
+    PacmanAutopilot* autopilot = nullptr;
+
+    try {
+        if (policy == Policy::MCTS) {
+            autopilotOptions.seed = seed;
+            autopilot = new PacmanAutopilot(autopilotOptions);
+        }
+        auto start = std::chrono::steady_clock::now();
+        for (int g = 0; g < games; g++) {
+            Board* board = inputFile.empty() ? new Board(boardSize, ghostCount, classicGhosts) : new Board(inputFile);
+            board->setGhostNav(nav);
+            if (hardGhosts) {
+                board->setGhostDifficulty(GhostDifficulty::HARD, searchOptions);
+            }
+            if (patrolGhosts) {
+                std::vector<GridTarget> corners = GhostScripts::corners(board->getGridSize());
+                for (size_t i = 0; i < board->getGhosts().size(); i++) {
+                    board->setGhostScript(static_cast<int>(i), GhostScripts::patrol, corners, 5, 10);
+                }
+            }
+            if (board->getDistanceTable() != nullptr) {
+                stats.tables++;
+                stats.cachedTables += board->getDistanceTable()->isFromCache();
+                stats.tableMs += board->getDistanceTable()->getBuildMs();
+            }
+            int ticks = 0;
+            AllocScope allocs;
+            while (!board->getIsGameOver() && board->getDotsRemaining() > 0 && ticks < maxTicks) {
+                board->move(chooseMove(*board, policy, autopilot, rng));
+                ticks++;
+                if (board->getGhostSearch() != nullptr) {
+                    const GhostSearchStats& search = board->getGhostSearch()->getLastStats();
+                    stats.searchDepths += search.depth;
+                    stats.searchNodes += search.nodes;
+                    stats.searchMs += search.ms;
+                }
+            }
+            stats.tickAllocations += allocs.allocations();
+
+            stats.games++;
+            stats.ticks += ticks;
+            if (board->getPathfinder() != nullptr) {
+                stats.pathSearches += board->getPathfinder()->getSearches();
+                stats.pathExpanded += board->getPathfinder()->getExpanded();
+            }
+            stats.totalScore += board->getScore();
+            if (board->getIsGameOver()) {
+                stats.losses++;
+            } else if (board->getDotsRemaining() == 0) {
+                stats.wins++;
+            } else {
+                stats.timeouts++;
+            }
+
+            if (g == games - 1) {
+                boardSize = board->getGridSize();
+                ghostCount = static_cast<int>(board->getGhosts().size());
+                if (!outputFile.empty()) {
+                    board->saveBoard(outputFile);
+                }
+            }
+            delete board;
+        }
+        double totalMs = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+
+        std::cout << "{\"sim\": \"pacman\", \"policy\": \"" << policyName << "\""
+                  << ", \"nav\": \"" << navName << "\""
+                  << ", \"size\": " << boardSize
+                  << ", \"ghosts\": " << ghostCount
+                  << ", \"seed\": " << seed
+                  << ", \"games\": " << stats.games
+                  << ", \"wins\": " << stats.wins
+                  << ", \"losses\": " << stats.losses
+                  << ", \"timeouts\": " << stats.timeouts
+                  << ", \"ticks\": " << stats.ticks
+                  << ", \"avg_score\": " << (stats.games > 0 ? static_cast<double>(stats.totalScore) / stats.games : 0.0)
+                  << ", \"total_ms\": " << totalMs
+                  << ", \"ticks_per_sec\": " << (totalMs > 0 ? stats.ticks * 1000.0 / totalMs : 0.0);
+        if (nav == GhostNav::ASTAR) {
+            std::cout << ", \"path_searches\": " << stats.pathSearches
+                      << ", \"expanded_per_tick\": "
+                      << (stats.ticks > 0 ? static_cast<double>(stats.pathExpanded) / stats.ticks : 0.0);
+        }
+        if (classicGhosts && inputFile.empty()) {
+            std::cout << ", \"classic_ghosts\": true";
+        }
+        if (patrolGhosts) {
+            std::cout << ", \"patrol_ghosts\": true";
+        }
+        if (hardGhosts && stats.ticks > 0) {
+            std::cout << ", \"pacman_model\": \"" << modelName << "\""
+                      << ", \"search_depth\": " << static_cast<double>(stats.searchDepths) / stats.ticks
+                      << ", \"search_nodes_per_tick\": " << static_cast<double>(stats.searchNodes) / stats.ticks
+                      << ", \"search_ms_per_tick\": " << stats.searchMs / stats.ticks;
+        }
+        if (autopilot != nullptr) {
+            const AutopilotStats& mcts = autopilot->getTotalStats();
+            std::cout << ", \"mcts_playouts_per_move\": "
+                      << (mcts.moves > 0 ? static_cast<double>(mcts.playouts) / mcts.moves : 0.0)
+                      << ", \"mcts_ms_per_move\": " << (mcts.moves > 0 ? mcts.ms / mcts.moves : 0.0)
+                      << ", \"mcts_nodes_per_sec\": " << mcts.nodesPerSecond();
+        }
+        if (stats.tables > 0) {
+            std::cout << ", \"apsp_tables\": " << stats.tables
+                      << ", \"apsp_cached\": " << stats.cachedTables
+                      << ", \"apsp_build_ms\": " << stats.tableMs / stats.tables;
+        }
+        if (AllocCounter::isActive()) {
+            std::cout << ", \"allocs_per_tick\": "
+                      << (stats.ticks > 0 ? static_cast<double>(stats.tickAllocations) / stats.ticks : 0.0);
+        }
+        std::cout << "}" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        delete autopilot;
+        Trace::stop();
+        return -1;
+    }
+
+    delete autopilot;
+    Trace::stop();
+    return 0;
+}
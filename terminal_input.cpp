@@ -0,0 +1,102 @@
+// terminal_input.cpp
+
+#include "terminal_input.h"
+#include <unistd.h>
+#include <poll.h>
+
+/**
+ * Constructor
+ */
+TerminalInput::TerminalInput(int fd) : fd(fd), raw(false), saved(), length(0), pos(0) {
+    if (!isatty(fd) || tcgetattr(fd, &saved) != 0) {
+        return;
+    }
+
+    struct termios settings = saved;
+    settings.c_lflag &= ~(ICANON | ECHO | ISIG | IEXTEN);
+    settings.c_iflag &= ~(IXON | ICRNL);
+    settings.c_cc[VMIN] = 0;
+    settings.c_cc[VTIME] = 0;
+    raw = tcsetattr(fd, TCSAFLUSH, &settings) == 0;
+}
+
+/**
+ * Destructor
+ */
+TerminalInput::~TerminalInput() {
+    if (raw) {
+        tcsetattr(fd, TCSAFLUSH, &saved);
+    }
+}
+
+bool TerminalInput::isRaw() const {
+    return raw;
+}
+
+/**
+ * Wait for input with poll
+ */
+bool TerminalInput::waitForInput(int timeoutMillis) {
+    if (pos < length) {
+        return true;
+    }
+    struct pollfd pfd = {fd, POLLIN, 0};
+    int result = poll(&pfd, 1, timeoutMillis < 0 ? 0 : timeoutMillis);
+    return result > 0 && (pfd.revents & POLLIN) != 0;
+}
+
+/**
+ * Read pending bytes (VMIN = 0, so read never blocks)
+ */
+bool TerminalInput::fill() {
+    if (pos < length) {
+        return true;
+    }
+    pos = 0;
+    length = 0;
+    ssize_t count = read(fd, buffer, sizeof(buffer));
+    if (count > 0) {
+        length = static_cast<int>(count);
+    }
+    return length > 0;
+}
+
+/**
+ * Decode the next key
+ */
+Key TerminalInput::readKey() {
+    if (!fill()) {
+        return Key::NONE;
+    }
+
+    unsigned char ch = buffer[pos++];
+    switch (ch) {
+        case 'w': case 'W': return Key::UP;
+        case 's': case 'S': return Key::DOWN;
+        case 'a': case 'A': return Key::LEFT;
+        case 'd': case 'D': return Key::RIGHT;
+        case 'p': case 'P': case ' ': return Key::PAUSE;
+        case 'q': case 'Q': case 3: return Key::QUIT;   // 3 = Ctrl-C (ISIG is off)
+        case 27: return readEscape();
+        default: return Key::OTHER;
+    }
+}
+
+/**
+ * Arrow keys arrive as ESC [ A..D (or ESC O A..D in application mode)
+ */
+Key TerminalInput::readEscape() {
+    // The rest of the sequence normally arrives in the same read
+    if (pos + 1 >= length || (buffer[pos] != '[' && buffer[pos] != 'O')) {
+        return Key::OTHER;
+    }
+    unsigned char code = buffer[pos + 1];
+    pos += 2;
+    switch (code) {
+        case 'A': return Key::UP;
+        case 'B': return Key::DOWN;
+        case 'C': return Key::RIGHT;
+        case 'D': return Key::LEFT;
+        default: return Key::OTHER;
+    }
+}
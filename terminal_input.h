@@ -0,0 +1,85 @@
+// terminal_input.h
+
+#ifndef TERMINAL_INPUT_H
+#define TERMINAL_INPUT_H
+
+#include <termios.h>
+
+/**
+ * Keys the real-time terminal mode reacts to
+ */
+enum class Key {
+    NONE,    // No key pending
+    UP,
+    DOWN,
+    LEFT,
+    RIGHT,
+    PAUSE,
+    QUIT,
+    OTHER
+};
+
+/**
+ * TerminalInput class - raw, non-blocking keyboard input
+ * Switches the terminal to raw mode (no line buffering, no echo) for the
+ * lifetime of the object and restores the previous settings on
+ * destruction. Output processing is left on, so "\n" still starts a new line.
+ *
+ * Keys: w/a/s/d or arrow keys move, p pauses, q / Ctrl-C quits.
+ */
+class TerminalInput {
+public:
+    /**
+     * Constructor - enters raw mode if fd is a terminal
+     * @param fd File descriptor to read from
+     */
+    TerminalInput(int fd);
+
+    /**
+     * Destructor - restores the saved terminal settings
+     */
+    ~TerminalInput();
+
+    TerminalInput(const TerminalInput&) = delete;
+    TerminalInput& operator=(const TerminalInput&) = delete;
+
+    /**
+     * Check if raw mode is active
+     * @return false if fd is not a terminal or could not be configured
+     */
+    bool isRaw() const;
+
+    /**
+     * Wait until a key is available or the timeout expires
+     * @param timeoutMillis Maximum time to wait (0 returns immediately)
+     * @return true if input is available
+     */
+    bool waitForInput(int timeoutMillis);
+
+    /**
+     * Read one key without blocking
+     * @return The key, or Key::NONE if nothing is pending
+     */
+    Key readKey();
+
+private:
+    int fd;
+    bool raw;
+    struct termios saved;
+    unsigned char buffer[64];   // Bytes read but not yet decoded
+    int length;
+    int pos;
+
+    /**
+     * Refill the buffer with whatever bytes are pending
+     * @return true if at least one byte is buffered
+     */
+    bool fill();
+
+    /**
+     * Decode an escape sequence after ESC (arrow keys)
+     */
+    Key readEscape();
+};
+
+#endif // TERMINAL_INPUT_H
@@ -0,0 +1,172 @@
+// terminal_renderer.cpp
+
+#include "terminal_renderer.h"
+
+namespace {
+const char* const CLEAR_SCREEN = "\x1b[H\x1b[2J";
+const char* const CLEAR_LINE_END = "\x1b[K";
+const char* const CLEAR_BELOW = "\x1b[J";
+const char* const RESET = "\x1b[0m";
+}
+
+/**
+ * Constructor
+ */
+TerminalRenderer::TerminalRenderer(std::ostream& out, bool useColor)
+    : out(out), useColor(useColor), fullRedraw(true), lastTick(-1), lastSize(-1), lastScore(-1) {}
+
+/**
+ * Draw a frame and park the cursor in the status area
+ */
+void TerminalRenderer::draw(const Board& board) {
+    int size = board.getGridSize();
+    int tick = board.getTickCount();
+    frame.clear();
+
+    if (fullRedraw || size != lastSize) {
+        appendFull(board);
+    }
+    else {
+        if (tick == lastTick + 1) {
+            // The changed-cell list covers exactly one tick
+            for (int cell : board.getChangedCells()) {
+                int row = cell / size;
+                int col = cell % size;
+                char ch = board.getGridChar(row, col);
+                shown[cell] = ch;
+                appendCursor(row + 2, col * 3 + 3);
+                appendCell(ch);
+            }
+        }
+        else if (tick != lastTick) {
+            appendDiff(board);
+        }
+        if (board.getScore() != lastScore) {
+            appendCursor(1, 1);
+            appendScore(board.getScore());
+        }
+    }
+
+    appendCursor(size + 2, 1);
+    frame += CLEAR_BELOW;
+
+    out.write(frame.data(), static_cast<std::streamsize>(frame.size()));
+    out.flush();
+
+    fullRedraw = false;
+    lastTick = tick;
+    lastSize = size;
+    lastScore = board.getScore();
+}
+
+void TerminalRenderer::invalidate() {
+    fullRedraw = true;
+}
+
+/**
+ * Clear the screen and draw every row
+ */
+void TerminalRenderer::appendFull(const Board& board) {
+    int size = board.getGridSize();
+
+    // Worst case per cell: cursor-free "  " + color code + char + reset
+    size_t needed = static_cast<size_t>(size) * size * 16 + static_cast<size_t>(size) * 16 + 64;
+    if (frame.capacity() < needed) {
+        frame.reserve(needed);
+    }
+
+    shown.assign(static_cast<size_t>(size) * size, ' ');
+
+    frame += CLEAR_SCREEN;
+    appendScore(board.getScore());
+    for (int row = 0; row < size; row++) {
+        appendCursor(row + 2, 1);
+        for (int col = 0; col < size; col++) {
+            char ch = board.getGridChar(row, col);
+            shown[row * size + col] = ch;
+            frame += "  ";
+            appendCell(ch);
+        }
+    }
+}
+
+/**
+ * Compare the board with the screen copy and redraw what differs
+ */
+void TerminalRenderer::appendDiff(const Board& board) {
+    int size = board.getGridSize();
+    const std::vector<char>& grid = board.getGrid();
+    for (int row = 0; row < size; row++) {
+        for (int col = 0; col < size; col++) {
+            char ch = grid[row * size + col];
+            char& onScreen = shown[row * size + col];
+            if (ch != onScreen) {
+                onScreen = ch;
+                appendCursor(row + 2, col * 3 + 3);
+                appendCell(ch);
+            }
+        }
+    }
+}
+
+void TerminalRenderer::appendCell(char ch) {
+    const char* color = useColor ? colorFor(ch) : nullptr;
+    if (color != nullptr) {
+        frame += color;
+        frame += ch;
+        frame += RESET;
+    } else {
+        frame += ch;
+    }
+}
+
+void TerminalRenderer::appendScore(int score) {
+    frame += "Score: ";
+    appendInt(score);
+    frame += CLEAR_LINE_END;
+}
+
+void TerminalRenderer::appendCursor(int row, int col) {
+    frame += "\x1b[";
+    appendInt(row);
+    frame += ';';
+    appendInt(col);
+    frame += 'H';
+}
+
+void TerminalRenderer::appendInt(int value) {
+    char digits[12];
+    int count = 0;
+    unsigned magnitude = value < 0 ? 0u - static_cast<unsigned>(value) : static_cast<unsigned>(value);
+    do {
+        digits[count++] = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+
+    if (value < 0) {
+        frame += '-';
+    }
+    while (count > 0) {
+        frame += digits[--count];
+    }
+}
+
+/**
+ * Colors follow the GUI sprites
+ */
+const char* TerminalRenderer::colorFor(char ch) {
+    switch (ch) {
+        case 'P': return "\x1b[1;33m";   // Pac-Man - bold yellow
+        case 'X': return "\x1b[1;31m";   // Caught Pac-Man - bold red
+        case 'G':
+        case 'A': return "\x1b[31m";     // Blinky - red
+        case 'B': return "\x1b[33m";     // Clyde - orange/yellow
+        case 'C': return "\x1b[36m";     // Inky - cyan
+        case 'D': return "\x1b[35m";     // Pinky - magenta
+        case 'V': return "\x1b[1;34m";   // Frightened ghost - bold blue
+        case '*': return "\x1b[37m";     // Dot - white
+        case 'o': return "\x1b[1;37m";   // Power pellet - bold white
+        case '#': return "\x1b[34m";     // Wall - blue
+        default:  return nullptr;
+    }
+}
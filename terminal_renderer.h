@@ -0,0 +1,92 @@
+// terminal_renderer.h
+
+#ifndef TERMINAL_RENDERER_H
+#define TERMINAL_RENDERER_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Board.h"
+
+/**
+ * TerminalRenderer class - draws a Board on an ANSI terminal
+ * The first frame draws the whole board; after that only the cells the
+ * board reports as changed in the last tick are redrawn, using cursor
+ * addressing. If several ticks passed between frames (capped frame
+ * rate), the board is compared against a copy of what is on screen.
+ * Each frame is built in one preallocated buffer and written with a
+ * single call, which keeps play usable over slow links.
+ *
+ * Layout (1-based terminal rows):
+ *   1            Score line
+ *   2 .. size+1  Board rows, each cell as two spaces and the cell character
+ *   size+2 ..    Status area (cleared every frame, free for prompts)
+ */
+class TerminalRenderer {
+public:
+    /**
+     * Constructor
+     * @param out Stream connected to the terminal
+     * @param useColor Color characters with ANSI SGR codes
+     */
+    TerminalRenderer(std::ostream& out, bool useColor);
+
+    /**
+     * Draw the board, redrawing only what changed since the last frame,
+     * then park the cursor at the start of the (cleared) status area
+     * @param board The board to draw
+     */
+    void draw(const Board& board);
+
+    /**
+     * Force the next draw to redraw the whole screen
+     */
+    void invalidate();
+
+private:
+    std::ostream& out;
+    bool useColor;
+    std::string frame;      // Reused output buffer
+    std::vector<char> shown; // Cell characters currently on screen
+    bool fullRedraw;
+    int lastTick;
+    int lastSize;
+    int lastScore;
+
+    /**
+     * Append the whole board, clearing the screen first
+     */
+    void appendFull(const Board& board);
+
+    /**
+     * Append the cells that differ from what is on screen
+     */
+    void appendDiff(const Board& board);
+
+    /**
+     * Append one cell (color code, character, reset)
+     */
+    void appendCell(char ch);
+
+    /**
+     * Append the score line at the current cursor position
+     */
+    void appendScore(int score);
+
+    /**
+     * Append a cursor move to a 1-based terminal position
+     */
+    void appendCursor(int row, int col);
+
+    /**
+     * Append a non-negative or negative integer without allocating
+     */
+    void appendInt(int value);
+
+    /**
+     * Get the ANSI color code for a cell character (nullptr for none)
+     */
+    static const char* colorFor(char ch);
+};
+
+#endif // TERMINAL_RENDERER_H
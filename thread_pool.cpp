@@ -0,0 +1,90 @@
+// thread_pool.cpp
+
+#include "thread_pool.h"
+
+/**
+ * Constructor - starts the workers
+ */
+ThreadPool::ThreadPool(unsigned threadCount) : stopping(false) {
+    if (threadCount == 0) {
+        threadCount = defaultThreadCount();
+    }
+    workers.reserve(threadCount);
+    for (unsigned i = 0; i < threadCount; i++) {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+/**
+ * Destructor - drains the queue and joins the workers
+ */
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    available.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+/**
+ * Run body over [0, count) and wait for completion
+ */
+void ThreadPool::parallelFor(int count, const std::function<void(int)>& body) {
+    std::vector<std::future<void>> pending;
+    pending.reserve(count);
+    for (int i = 0; i < count; i++) {
+        pending.push_back(submit([&body, i]() { body(i); }));
+    }
+
+    // Wait for every task before rethrowing, since they reference body
+    std::exception_ptr error;
+    for (std::future<void>& task : pending) {
+        try {
+            task.get();
+        } catch (...) {
+            if (!error) error = std::current_exception();
+        }
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+unsigned ThreadPool::size() const {
+    return static_cast<unsigned>(workers.size());
+}
+
+unsigned ThreadPool::defaultThreadCount() {
+    unsigned count = std::thread::hardware_concurrency();
+    return count == 0 ? 1 : count;
+}
+
+void ThreadPool::enqueue(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(std::move(task));
+    }
+    available.notify_one();
+}
+
+/**
+ * Worker thread body - runs tasks until the pool is stopped and drained
+ */
+void ThreadPool::workerLoop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            available.wait(lock, [this]() { return stopping || !tasks.empty(); });
+            if (tasks.empty()) {
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+}
@@ -0,0 +1,82 @@
+// thread_pool.h
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <functional>
+#include <memory>
+
+/**
+ * ThreadPool class - fixed set of worker threads running queued tasks
+ */
+class ThreadPool {
+public:
+    /**
+     * Constructor - starts the worker threads
+     * @param threadCount Number of workers (0 means defaultThreadCount())
+     */
+    explicit ThreadPool(unsigned threadCount = 0);
+
+    /**
+     * Destructor - finishes queued tasks and joins the workers
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * Queue a task
+     * @param task Callable taking no arguments
+     * @return Future holding the task's result (or exception)
+     */
+    template <class F>
+    auto submit(F task) -> std::future<decltype(task())> {
+        using Result = decltype(task());
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(std::move(task));
+        std::future<Result> result = packaged->get_future();
+        enqueue([packaged]() { (*packaged)(); });
+        return result;
+    }
+
+    /**
+     * Run body(0) .. body(count - 1) on the workers and wait for all of them
+     * Rethrows the first exception thrown by any call.
+     */
+    void parallelFor(int count, const std::function<void(int)>& body);
+
+    /**
+     * Get the number of worker threads
+     */
+    unsigned size() const;
+
+    /**
+     * Get the number of hardware threads (at least 1)
+     */
+    static unsigned defaultThreadCount();
+
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable available;
+    bool stopping;
+
+    /**
+     * Add a task to the queue and wake one worker
+     */
+    void enqueue(std::function<void()> task);
+
+    /**
+     * Worker thread body
+     */
+    void workerLoop();
+};
+
+#endif // THREAD_POOL_H
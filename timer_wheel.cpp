@@ -0,0 +1,144 @@
+// timer_wheel.cpp
+
+#include "timer_wheel.h"
+#include <algorithm>
+
+namespace {
+
+const uint64_t SLOT_MASK = TimerWheel::SLOTS - 1;
+
+} // namespace
+
+const uint32_t TimerWheel::MAX_DELAY;
+
+/**
+ * Constructor
+ */
+TimerWheel::TimerWheel() : freeList(-1), now(0), pending(0) {}
+
+int TimerWheel::schedule(uint32_t delay, uint32_t event) {
+    if (heads.empty()) {
+        heads.assign(static_cast<size_t>(LEVELS) * SLOTS, -1);
+    }
+    delay = std::min(std::max(delay, 1u), MAX_DELAY);
+
+    int id;
+    if (freeList >= 0) {
+        id = freeList;
+        freeList = timers[id].next;
+    } else {
+        id = static_cast<int>(timers.size());
+        timers.push_back(Timer());
+    }
+    timers[id].due = now + delay;
+    timers[id].event = event;
+    insert(id);
+    pending++;
+    return id;
+}
+
+void TimerWheel::reserve(size_t count) {
+    if (heads.empty()) {
+        heads.assign(static_cast<size_t>(LEVELS) * SLOTS, -1);
+    }
+    timers.reserve(count);
+    expired.reserve(count);
+}
+
+void TimerWheel::cancel(int id) {
+    if (id < 0 || id >= static_cast<int>(timers.size()) || timers[id].slot < 0) {
+        return;
+    }
+    unlink(id);
+    timers[id].slot = -1;
+    timers[id].next = freeList;
+    freeList = id;
+    pending--;
+}
+
+/**
+ * When level 0 wraps, the higher levels that wrap with it are cascaded
+ * top-down, so every timer due in the next 256 ticks is on level 0
+ * before the due slot is emptied
+ */
+const std::vector<uint32_t>& TimerWheel::advance() {
+    now++;
+    expired.clear();
+    if (pending == 0) {
+        return expired;
+    }
+
+    if ((now & SLOT_MASK) == 0) {
+        int top = 1;
+        while (top < LEVELS - 1 && ((now >> (SLOT_BITS * top)) & SLOT_MASK) == 0) {
+            top++;
+        }
+        for (int level = top; level >= 1; level--) {
+            cascade(level, static_cast<int>((now >> (SLOT_BITS * level)) & SLOT_MASK));
+        }
+    }
+
+    int32_t& head = heads[now & SLOT_MASK];
+    while (head >= 0) {
+        int id = head;
+        expired.push_back(timers[id].event);
+        cancel(id);
+    }
+    return expired;
+}
+
+uint64_t TimerWheel::getTime() const {
+    return now;
+}
+
+size_t TimerWheel::getPending() const {
+    return pending;
+}
+
+size_t TimerWheel::memoryUsage() const {
+    return timers.capacity() * sizeof(Timer) + heads.capacity() * sizeof(int32_t)
+         + expired.capacity() * sizeof(uint32_t);
+}
+
+/**
+ * The level is the lowest one whose span from now's slot boundary covers
+ * the due time: due and now agree on every bit above it
+ */
+void TimerWheel::insert(int id) {
+    Timer& timer = timers[id];
+    int level = 0;
+    while (level < LEVELS - 1 && (timer.due >> (SLOT_BITS * (level + 1))) != (now >> (SLOT_BITS * (level + 1)))) {
+        level++;
+    }
+    int slot = level * SLOTS + static_cast<int>((timer.due >> (SLOT_BITS * level)) & SLOT_MASK);
+
+    timer.slot = slot;
+    timer.prev = -1;
+    timer.next = heads[slot];
+    if (heads[slot] >= 0) {
+        timers[heads[slot]].prev = id;
+    }
+    heads[slot] = id;
+}
+
+void TimerWheel::unlink(int id) {
+    Timer& timer = timers[id];
+    if (timer.prev >= 0) {
+        timers[timer.prev].next = timer.next;
+    } else {
+        heads[timer.slot] = timer.next;
+    }
+    if (timer.next >= 0) {
+        timers[timer.next].prev = timer.prev;
+    }
+}
+
+void TimerWheel::cascade(int level, int slot) {
+    int32_t id = heads[level * SLOTS + slot];
+    heads[level * SLOTS + slot] = -1;
+    while (id >= 0) {
+        int32_t next = timers[id].next;
+        insert(id);
+        id = next;
+    }
+}
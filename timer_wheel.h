@@ -0,0 +1,108 @@
+// timer_wheel.h
+
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * TimerWheel class - hierarchical timing wheel counting in ticks
+ * Four levels of 256 slots: level 0 holds timers due within the current
+ * 256 ticks, level 1 those within the current 65536, and so on. A timer
+ * sits in one slot's list until time reaches it; when level 0 wraps, the
+ * next level-1 slot is spread back over level 0 (and likewise up the
+ * levels), so each timer is moved at most three times.
+ *
+ * schedule, cancel and the expiry of one timer are O(1); advancing a tick
+ * touches only the due slot, however many timers are pending. Timers live
+ * in a pool reused through a free list, and the slot lists are allocated
+ * on the first schedule, so an idle wheel costs nothing.
+ */
+class TimerWheel {
+public:
+    static const int SLOT_BITS = 8;
+    static const int SLOTS = 1 << SLOT_BITS;
+    static const int LEVELS = 4;
+
+    // Longest delay: a quarter of the top level's span keeps a timer out
+    // of the top slot that is still being swept
+    static const uint32_t MAX_DELAY = 1u << (SLOT_BITS * LEVELS - 2);
+
+    TimerWheel();
+
+    /**
+     * Start a timer
+     * @param delay Ticks from now, 1 to MAX_DELAY (clamped)
+     * @param event Returned by advance() when the timer expires
+     * @return Timer id, valid until it expires or is cancelled
+     */
+    int schedule(uint32_t delay, uint32_t event);
+
+    /**
+     * Make room for a number of pending timers, so scheduling up to that
+     * many does not allocate
+     */
+    void reserve(size_t count);
+
+    /**
+     * Stop a pending timer
+     * @param id A timer from schedule() that has not expired
+     */
+    void cancel(int id);
+
+    /**
+     * Move time on one tick
+     * @return Events of the timers due now (reused by the next call)
+     */
+    const std::vector<uint32_t>& advance();
+
+    /**
+     * Get the ticks advanced since construction
+     */
+    uint64_t getTime() const;
+
+    /**
+     * Get the number of pending timers
+     */
+    size_t getPending() const;
+
+    /**
+     * Get the heap bytes this wheel owns
+     */
+    size_t memoryUsage() const;
+
+private:
+    struct Timer {
+        uint64_t due;
+        uint32_t event;
+        int32_t slot;    // Index into heads, or -1 when free
+        int32_t prev;
+        int32_t next;    // Also links the free list
+    };
+
+    std::vector<Timer> timers;
+    std::vector<int32_t> heads;      // LEVELS * SLOTS list heads (-1 if empty)
+    std::vector<uint32_t> expired;
+    int32_t freeList;
+    uint64_t now;
+    size_t pending;
+
+    /**
+     * Put a timer in the slot its due time falls in, seen from now
+     */
+    void insert(int id);
+
+    /**
+     * Take a timer out of its slot's list
+     */
+    void unlink(int id);
+
+    /**
+     * Re-insert every timer of one slot (they land on lower levels)
+     */
+    void cascade(int level, int slot);
+};
+
+#endif // TIMER_WHEEL_H
@@ -0,0 +1,93 @@
+// embed_assets.cpp
+// Build tool: packs asset files into a generated source pair that is
+// linked into the game, so assets are loaded from memory at startup.
+//
+// Usage: embed_assets <output-base> <file>...
+//   Writes <output-base>.h (constexpr index) and <output-base>.cpp (blob).
+//   Each asset is indexed by the path exactly as given on the command line.
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <iterator>
+#include <cctype>
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "Usage: embed_assets <output-base> <file>..." << std::endl;
+        return 1;
+    }
+
+    std::string base = argv[1];
+    std::string fileBase = base.substr(base.find_last_of('/') + 1);
+    std::string headerName = fileBase + ".h";
+    std::string guardName = fileBase;
+    for (char& ch : guardName) {
+        ch = static_cast<char>(ch == '.' ? '_' : toupper(static_cast<unsigned char>(ch)));
+    }
+
+    std::vector<std::string> names;
+    std::vector<size_t> offsets;
+    std::vector<size_t> sizes;
+    std::vector<unsigned char> blob;
+
+    for (int a = 2; a < argc; a++) {
+        std::ifstream file(argv[a], std::ios::binary);
+        if (!file.is_open()) {
+            std::cerr << "embed_assets: cannot open " << argv[a] << std::endl;
+            return 1;
+        }
+        std::vector<unsigned char> data((std::istreambuf_iterator<char>(file)),
+                                        std::istreambuf_iterator<char>());
+        names.push_back(argv[a]);
+        offsets.push_back(blob.size());
+        sizes.push_back(data.size());
+        blob.insert(blob.end(), data.begin(), data.end());
+        // Keep every asset 16-byte aligned inside the blob
+        while (blob.size() % 16 != 0) {
+            blob.push_back(0);
+        }
+    }
+
+    std::ofstream header(base + ".h");
+    header << "// " << headerName << "\n"
+           << "// Generated by tools/embed_assets - do not edit\n\n"
+           << "#ifndef " << guardName << "_H\n"
+           << "#define " << guardName << "_H\n\n"
+           << "#include <cstddef>\n\n"
+           << "/**\n * AssetEntry - location of one embedded file inside ASSET_BLOB\n */\n"
+           << "struct AssetEntry {\n"
+           << "    const char* name;\n"
+           << "    std::size_t offset;\n"
+           << "    std::size_t size;\n"
+           << "};\n\n"
+           << "constexpr AssetEntry ASSET_INDEX[] = {\n";
+    for (size_t i = 0; i < names.size(); i++) {
+        header << "    {\"" << names[i] << "\", " << offsets[i] << ", " << sizes[i] << "},\n";
+    }
+    header << "};\n\n"
+           << "constexpr int ASSET_COUNT = " << names.size() << ";\n"
+           << "constexpr std::size_t ASSET_BLOB_SIZE = " << blob.size() << ";\n\n"
+           << "extern const unsigned char ASSET_BLOB[ASSET_BLOB_SIZE];\n\n"
+           << "#endif // " << guardName << "_H\n";
+
+    std::ofstream source(base + ".cpp");
+    source << "// " << fileBase << ".cpp\n"
+           << "// Generated by tools/embed_assets - do not edit\n\n"
+           << "#include \"" << headerName << "\"\n\n"
+           << "alignas(16) const unsigned char ASSET_BLOB[ASSET_BLOB_SIZE] = {\n";
+    for (size_t i = 0; i < blob.size(); i++) {
+        source << static_cast<int>(blob[i]) << ",";
+        if (i % 32 == 31) {
+            source << "\n";
+        }
+    }
+    source << "\n};\n";
+
+    if (!header.good() || !source.good()) {
+        std::cerr << "embed_assets: failed to write " << base << ".h/.cpp" << std::endl;
+        return 1;
+    }
+    return 0;
+}
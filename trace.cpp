@@ -0,0 +1,168 @@
+// trace.cpp
+
+#include "trace.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <vector>
+#include <unistd.h>
+
+std::atomic<bool> Trace::enabled(false);
+
+namespace {
+
+/**
+ * One recorded scope
+ */
+struct TraceEvent {
+    const char* name;
+    uint64_t startNs;
+    uint64_t endNs;
+};
+
+/**
+ * Ring buffer owned by one thread; only that thread writes to it
+ */
+struct ThreadBuffer {
+    int tid;
+    std::vector<TraceEvent> events;
+    std::atomic<uint64_t> count{0};   // Events ever recorded
+};
+
+std::mutex registryMutex;
+std::vector<ThreadBuffer*> buffers;   // Kept until exit so late events stay valid
+std::string traceFile;
+uint64_t originNs = 0;
+
+thread_local ThreadBuffer* localBuffer = nullptr;
+
+/**
+ * Get the calling thread's buffer, registering it on first use
+ */
+ThreadBuffer* threadBuffer() {
+    if (localBuffer == nullptr) {
+        ThreadBuffer* buffer = new ThreadBuffer();
+        buffer->events.resize(Trace::RING_CAPACITY);
+        std::lock_guard<std::mutex> lock(registryMutex);
+        buffer->tid = static_cast<int>(buffers.size()) + 1;
+        buffers.push_back(buffer);
+        localBuffer = buffer;
+    }
+    return localBuffer;
+}
+
+void stopAtExit() {
+    Trace::stop();
+}
+
+/**
+ * Write a name as a JSON string (names are identifiers, but be safe)
+ */
+void writeName(std::ostream& out, const char* name) {
+    out << '"';
+    for (const char* p = name; *p != '\0'; p++) {
+        if (*p == '"' || *p == '\\') {
+            out << '\\';
+        }
+        out << *p;
+    }
+    out << '"';
+}
+
+} // namespace
+
+/**
+ * Start recording
+ */
+bool Trace::start(const std::string& outputFile) {
+#ifndef PACMAN_TRACING
+    // No trace points were compiled in, so there is nothing to record
+    std::cerr << "Warning: tracing is compiled out; rebuild with make TRACE=1" << std::endl;
+    return false;
+#endif
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        traceFile = outputFile;
+        originNs = nowNs();
+        static bool atExitRegistered = false;
+        if (!atExitRegistered) {
+            std::atexit(stopAtExit);
+            atExitRegistered = true;
+        }
+    }
+    enabled.store(true, std::memory_order_relaxed);
+    return true;
+}
+
+/**
+ * Stop recording and write every thread's events
+ */
+bool Trace::stop() {
+    if (!enabled.exchange(false)) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    std::ofstream out(traceFile);
+    if (!out.is_open()) {
+        std::cerr << "Warning: could not write trace to " << traceFile << std::endl;
+        return false;
+    }
+
+    int pid = static_cast<int>(getpid());
+    uint64_t written = 0, dropped = 0;
+    out << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+    bool first = true;
+    for (ThreadBuffer* buffer : buffers) {
+        out << (first ? "\n" : ",\n")
+            << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": " << pid
+            << ", \"tid\": " << buffer->tid
+            << ", \"args\": {\"name\": \"thread " << buffer->tid << "\"}}";
+        first = false;
+
+        uint64_t count = buffer->count.load(std::memory_order_acquire);
+        uint64_t begin = count > RING_CAPACITY ? count - RING_CAPACITY : 0;
+        dropped += begin;
+        for (uint64_t i = begin; i < count; i++) {
+            const TraceEvent& event = buffer->events[i % RING_CAPACITY];
+            if (event.startNs < originNs) {
+                continue;   // Recorded before this session started
+            }
+            char times[96];
+            std::snprintf(times, sizeof(times), "\"ts\": %.3f, \"dur\": %.3f",
+                          (event.startNs - originNs) / 1000.0, (event.endNs - event.startNs) / 1000.0);
+            out << ",\n{\"name\": ";
+            writeName(out, event.name);
+            out << ", \"cat\": \"pacman\", \"ph\": \"X\", " << times
+                << ", \"pid\": " << pid << ", \"tid\": " << buffer->tid << "}";
+            written++;
+        }
+        buffer->count.store(0, std::memory_order_relaxed);
+    }
+    out << "\n]}" << std::endl;
+
+    std::cerr << "Trace: " << written << " events written to " << traceFile;
+    if (dropped > 0) {
+        std::cerr << " (" << dropped << " oldest events overwritten)";
+    }
+    std::cerr << std::endl;
+    return out.good();
+}
+
+/**
+ * Record a completed scope into the thread's ring
+ */
+void Trace::record(const char* name, uint64_t startNs, uint64_t endNs) {
+    ThreadBuffer* buffer = threadBuffer();
+    uint64_t index = buffer->count.load(std::memory_order_relaxed);
+    buffer->events[index % RING_CAPACITY] = TraceEvent{name, startNs, endNs};
+    buffer->count.store(index + 1, std::memory_order_release);
+}
+
+uint64_t Trace::nowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
@@ -0,0 +1,95 @@
+// trace.h
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+/**
+ * Trace class - scoped timing of hot paths, exported as Chrome trace JSON
+ * Each thread records into its own fixed-size ring buffer (the oldest
+ * events are overwritten when it is full), so recording takes no locks.
+ * Recording starts with Trace::start, and the buffers are written out by
+ * Trace::stop or automatically at exit. The file loads in chrome://tracing
+ * and ui.perfetto.dev.
+ *
+ * Trace points are placed with PAC_TRACE_SCOPE("name"). They are compiled
+ * out entirely unless PACMAN_TRACING is defined (make TRACE=1); when
+ * compiled in but not started, each costs one relaxed atomic load.
+ */
+class Trace {
+public:
+    // Events kept per thread before the oldest are overwritten
+    static const size_t RING_CAPACITY = 1 << 16;
+
+    /**
+     * Start recording
+     * @param outputFile File the trace is written to on stop/exit
+     * @return false if tracing was compiled out
+     */
+    static bool start(const std::string& outputFile);
+
+    /**
+     * Stop recording and write the trace file
+     * Call while traced threads are idle; safe to call more than once.
+     * @return true if a trace was written
+     */
+    static bool stop();
+
+    /**
+     * Check if events are being recorded
+     */
+    static bool isEnabled() {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Record a completed scope on the calling thread
+     * @param name Static string naming the scope
+     * @param startNs Start time from nowNs()
+     * @param endNs End time from nowNs()
+     */
+    static void record(const char* name, uint64_t startNs, uint64_t endNs);
+
+    /**
+     * Get a monotonic timestamp in nanoseconds
+     */
+    static uint64_t nowNs();
+
+private:
+    static std::atomic<bool> enabled;
+};
+
+/**
+ * TraceScope class - records the time between construction and destruction
+ */
+class TraceScope {
+public:
+    explicit TraceScope(const char* name)
+        : name(name), startNs(Trace::isEnabled() ? Trace::nowNs() : 0) {}
+
+    ~TraceScope() {
+        if (startNs != 0 && Trace::isEnabled()) {
+            Trace::record(name, startNs, Trace::nowNs());
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* name;
+    uint64_t startNs;
+};
+
+#ifdef PACMAN_TRACING
+#define PAC_TRACE_CONCAT_INNER(a, b) a##b
+#define PAC_TRACE_CONCAT(a, b) PAC_TRACE_CONCAT_INNER(a, b)
+#define PAC_TRACE_SCOPE(name) TraceScope PAC_TRACE_CONCAT(pacTraceScope, __LINE__)(name)
+#else
+#define PAC_TRACE_SCOPE(name) ((void)0)
+#endif
+
+#endif // TRACE_H
@@ -0,0 +1,231 @@
+// vec_env.cpp
+
+#include "vec_env.h"
+#include "Board.h"
+#include "trace.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+// Row and column steps indexed by Direction value; anything else stays
+const int32_t ACTION_ROWS[5] = {-1, 1, 0, 0, 0};
+const int32_t ACTION_COLS[5] = {0, 0, -1, 1, 0};
+
+const int32_t POINTS_PER_DOT = 10;
+
+int32_t sign(int32_t value) {
+    return (value > 0) - (value < 0);
+}
+
+} // namespace
+
+/**
+ * Constructor - the starting positions come from a real Board so both
+ * place characters the same way
+ */
+VecEnv::VecEnv(int envCount, int size, int ghostCount, int maxTicks)
+    : envCount(std::max(1, envCount)), size(std::max(3, size)), ghostCount(std::max(1, ghostCount)),
+      maxTicks(maxTicks) {
+    cells = static_cast<size_t>(this->size) * this->size;
+
+    Board start(this->size, this->ghostCount);
+    startPacmanRow = start.getPacman()->getRow();
+    startPacmanCol = start.getPacman()->getCol();
+    for (const Ghost* ghost : start.getGhosts()) {
+        startGhostRows.push_back(ghost->getRow());
+        startGhostCols.push_back(ghost->getCol());
+    }
+
+    size_t envs = static_cast<size_t>(this->envCount);
+    size_t ghosts = envs * this->ghostCount;
+    pacmanRows.resize(envs);
+    pacmanCols.resize(envs);
+    ghostRows.resize(ghosts);
+    ghostCols.resize(ghosts);
+    scores.resize(envs);
+    ticks.resize(envs);
+    dotsRemaining.resize(envs);
+    finalScores.assign(envs, 0);
+    caught.resize(envs);
+    rewards.assign(envs, 0.0f);
+    dones.assign(envs, static_cast<uint8_t>(EnvDone::RUNNING));
+    observations.resize(envs * CHANNELS * cells);
+    reset();
+}
+
+void VecEnv::reset() {
+    for (int env = 0; env < envCount; env++) {
+        resetEnv(env);
+        rewards[env] = 0.0f;
+        dones[env] = static_cast<uint8_t>(EnvDone::RUNNING);
+    }
+}
+
+void VecEnv::resetEnv(int env) {
+    pacmanRows[env] = startPacmanRow;
+    pacmanCols[env] = startPacmanCol;
+    std::copy(startGhostRows.begin(), startGhostRows.end(), ghostRows.begin() + static_cast<size_t>(env) * ghostCount);
+    std::copy(startGhostCols.begin(), startGhostCols.end(), ghostCols.begin() + static_cast<size_t>(env) * ghostCount);
+    scores[env] = 0;
+    ticks[env] = 0;
+    dotsRemaining[env] = static_cast<int32_t>(cells) - 1;
+
+    uint8_t* dots = plane(env, 0);
+    uint8_t* pacman = plane(env, 1);
+    uint8_t* ghosts = plane(env, 2);
+    std::memset(dots, 1, cells);
+    std::memset(pacman, 0, 2 * cells);
+    size_t pacmanCell = static_cast<size_t>(startPacmanRow) * size + startPacmanCol;
+    dots[pacmanCell] = 0;
+    pacman[pacmanCell] = 1;
+    for (int g = 0; g < ghostCount; g++) {
+        ghosts[static_cast<size_t>(startGhostRows[g]) * size + startGhostCols[g]]++;
+    }
+}
+
+/**
+ * Same order as Board::move: Pacman moves and eats, then each ghost in
+ * turn steps toward him unless he has already been caught
+ */
+void VecEnv::step(const uint8_t* actions) {
+    PAC_TRACE_SCOPE("VecEnv::step");
+
+    // Pacman
+    for (int env = 0; env < envCount; env++) {
+        int action = actions[env] < 5 ? actions[env] : 4;
+        int32_t row = pacmanRows[env] + ACTION_ROWS[action];
+        int32_t col = pacmanCols[env] + ACTION_COLS[action];
+        float reward = 0.0f;
+        if (row >= 0 && row < size && col >= 0 && col < size) {
+            uint8_t* pacman = plane(env, 1);
+            pacman[static_cast<size_t>(pacmanRows[env]) * size + pacmanCols[env]] = 0;
+            size_t cell = static_cast<size_t>(row) * size + col;
+            pacman[cell] = 1;
+            pacmanRows[env] = row;
+            pacmanCols[env] = col;
+
+            uint8_t& dot = plane(env, 0)[cell];
+            if (dot) {
+                dot = 0;
+                scores[env] += POINTS_PER_DOT;
+                dotsRemaining[env]--;
+                reward = static_cast<float>(POINTS_PER_DOT);
+            }
+        }
+        ticks[env]++;
+        rewards[env] = reward;
+        caught[env] = 0;
+    }
+
+    // A ghost already on Pacman's cell stops every ghost this tick
+    for (int env = 0; env < envCount; env++) {
+        const int32_t* rows = &ghostRows[static_cast<size_t>(env) * ghostCount];
+        const int32_t* cols = &ghostCols[static_cast<size_t>(env) * ghostCount];
+        uint8_t hit = 0;
+        for (int g = 0; g < ghostCount; g++) {
+            hit |= (rows[g] == pacmanRows[env]) & (cols[g] == pacmanCols[env]);
+        }
+        caught[env] = hit;
+    }
+
+    // Ghosts, in order (Ghost::decideMove without the virtual call)
+    for (int env = 0; env < envCount; env++) {
+        int32_t* rows = &ghostRows[static_cast<size_t>(env) * ghostCount];
+        int32_t* cols = &ghostCols[static_cast<size_t>(env) * ghostCount];
+        uint8_t* ghosts = plane(env, 2);
+        int32_t pacmanRow = pacmanRows[env];
+        int32_t pacmanCol = pacmanCols[env];
+        for (int g = 0; g < ghostCount && !caught[env]; g++) {
+            int32_t dy = pacmanRow - rows[g];
+            int32_t dx = pacmanCol - cols[g];
+            bool vertical = dy != 0 && (dx == 0 || std::abs(dy) > std::abs(dx));
+            ghosts[static_cast<size_t>(rows[g]) * size + cols[g]]--;
+            if (vertical) {
+                rows[g] += sign(dy);
+            } else {
+                cols[g] += sign(dx);
+            }
+            ghosts[static_cast<size_t>(rows[g]) * size + cols[g]]++;
+            caught[env] = (rows[g] == pacmanRow) & (cols[g] == pacmanCol);
+        }
+    }
+
+    // Episode ends, with automatic reset
+    for (int env = 0; env < envCount; env++) {
+        EnvDone done = EnvDone::RUNNING;
+        if (caught[env]) {
+            done = EnvDone::CAUGHT;
+        } else if (dotsRemaining[env] == 0) {
+            done = EnvDone::CLEARED;
+        } else if (maxTicks > 0 && ticks[env] >= maxTicks) {
+            done = EnvDone::TRUNCATED;
+        }
+        dones[env] = static_cast<uint8_t>(done);
+        if (done != EnvDone::RUNNING) {
+            finalScores[env] = scores[env];
+            resetEnv(env);
+        }
+    }
+}
+
+uint8_t* VecEnv::plane(int env, int channel) {
+    return &observations[(static_cast<size_t>(env) * CHANNELS + channel) * cells];
+}
+
+const float* VecEnv::getRewards() const {
+    return rewards.data();
+}
+
+const uint8_t* VecEnv::getDones() const {
+    return dones.data();
+}
+
+const uint8_t* VecEnv::getObservations() const {
+    return observations.data();
+}
+
+size_t VecEnv::observationSize() const {
+    return CHANNELS * cells;
+}
+
+const int32_t* VecEnv::getScores() const {
+    return scores.data();
+}
+
+const int32_t* VecEnv::getTicks() const {
+    return ticks.data();
+}
+
+const int32_t* VecEnv::getFinalScores() const {
+    return finalScores.data();
+}
+
+int VecEnv::getPacmanRow(int env) const {
+    return pacmanRows[env];
+}
+
+int VecEnv::getPacmanCol(int env) const {
+    return pacmanCols[env];
+}
+
+int VecEnv::getGhostRow(int env, int ghost) const {
+    return ghostRows[static_cast<size_t>(env) * ghostCount + ghost];
+}
+
+int VecEnv::getGhostCol(int env, int ghost) const {
+    return ghostCols[static_cast<size_t>(env) * ghostCount + ghost];
+}
+
+int VecEnv::getEnvCount() const {
+    return envCount;
+}
+
+int VecEnv::getSize() const {
+    return size;
+}
+
+int VecEnv::getGhostCount() const {
+    return ghostCount;
+}
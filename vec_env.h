@@ -0,0 +1,138 @@
+// vec_env.h
+
+#ifndef VEC_ENV_H
+#define VEC_ENV_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Episode end reasons reported in VecEnv::getDones()
+ */
+enum class EnvDone : uint8_t {
+    RUNNING = 0,
+    CAUGHT = 1,      // Pacman was caught by a ghost
+    CLEARED = 2,     // Every dot was eaten
+    TRUNCATED = 3    // Hit the tick limit
+};
+
+/**
+ * VecEnv class - N boards stepped in lockstep for agent training
+ * Plays by the same rules as Board::move (see bench/vec_env_bench.cpp for
+ * the parity check) but keeps every board in structure-of-arrays form:
+ * positions, scores and observation planes for all boards live in a few
+ * contiguous buffers, and one step() call advances all of them.
+ *
+ * Observations are uint8 planes, CHANNELS x size x size per board:
+ *   0 - dots (1 where Pacman has not been yet)
+ *   1 - Pacman (1 on his cell)
+ *   2 - ghosts (number of ghosts on the cell)
+ * A board that ends an episode is reset in the same step; its reward and
+ * done flag describe the finished episode and its observation the new one.
+ */
+class VecEnv {
+public:
+    static const int CHANNELS = 3;
+
+    /**
+     * Constructor - creates and resets every board
+     * @param envCount Number of boards
+     * @param size The size of every square board (at least 3)
+     * @param ghostCount Ghosts per board (at least 1), placed like Board(size, ghostCount)
+     * @param maxTicks Moves before an episode is truncated (0 for no limit)
+     */
+    VecEnv(int envCount, int size, int ghostCount, int maxTicks);
+
+    /**
+     * Reset every board to its starting position
+     */
+    void reset();
+
+    /**
+     * Move every board once
+     * @param actions One Direction value (0..4, see Direction.h) per board;
+     *                other values count as STAY
+     */
+    void step(const uint8_t* actions);
+
+    /**
+     * Per-board results of the last step (envCount entries each)
+     */
+    const float* getRewards() const;
+    const uint8_t* getDones() const;    // EnvDone values
+
+    /**
+     * Observation planes of every board, board after board
+     */
+    const uint8_t* getObservations() const;
+
+    /**
+     * Get the bytes of one board's observation (CHANNELS * size * size)
+     */
+    size_t observationSize() const;
+
+    /**
+     * Current episode state of every board (envCount entries each)
+     */
+    const int32_t* getScores() const;
+    const int32_t* getTicks() const;
+
+    /**
+     * Final score of the episode each board last finished (0 before the first)
+     */
+    const int32_t* getFinalScores() const;
+
+    /**
+     * Positions of the characters of one board
+     */
+    int getPacmanRow(int env) const;
+    int getPacmanCol(int env) const;
+    int getGhostRow(int env, int ghost) const;
+    int getGhostCol(int env, int ghost) const;
+
+    int getEnvCount() const;
+    int getSize() const;
+    int getGhostCount() const;
+
+private:
+    int envCount;
+    int size;
+    int ghostCount;
+    int maxTicks;
+    size_t cells;                    // size * size
+
+    // Starting positions, taken from a real Board
+    int32_t startPacmanRow;
+    int32_t startPacmanCol;
+    std::vector<int32_t> startGhostRows;
+    std::vector<int32_t> startGhostCols;
+
+    // Board state, one entry per board (ghosts: envCount x ghostCount)
+    std::vector<int32_t> pacmanRows;
+    std::vector<int32_t> pacmanCols;
+    std::vector<int32_t> ghostRows;
+    std::vector<int32_t> ghostCols;
+    std::vector<int32_t> scores;
+    std::vector<int32_t> ticks;
+    std::vector<int32_t> dotsRemaining;
+    std::vector<int32_t> finalScores;
+    std::vector<uint8_t> caught;     // Scratch for step()
+
+    // Step results and observations
+    std::vector<float> rewards;
+    std::vector<uint8_t> dones;
+    std::vector<uint8_t> observations;
+
+    /**
+     * Reset one board and redraw its observation
+     */
+    void resetEnv(int env);
+
+    /**
+     * Get the first byte of a board's observation plane
+     */
+    uint8_t* plane(int env, int channel);
+};
+
+#endif // VEC_ENV_H